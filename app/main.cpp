@@ -1,5 +1,6 @@
 #include "Testing.h"
 #include "TestingBoost.h"
+#include "TestingBenchmark.h"
 
 
 int main()
@@ -12,12 +13,35 @@ int main()
 	//test::vector_test();
 	//test::unordered_map_test();
 	//test::unordered_set_test();
+	//test::flat_hash_map_test();
+	//test::flat_hash_set_test();
+	//test::heterogeneous_lookup_test();
+	//test::hash_table_stats_test();
+	//test::hash_table_buckets_test();
+	//test::incremental_rehash_test();
+	//test::hash_bytes_test();
+	//test::node_handle_test();
+	//test::frozen_map_test();
+	//test::btree_map_test();
+	//test::map_bounds_test();
+	//test::map_set_operations_test();
+	//test::map_order_statistics_test();
+	//test::map_compact_node_test();
+	//test::flat_map_test();
+	//test::vector_range_test();
+	//test::vector_relocation_test();
+	//test::resize_for_overwrite_test();
+	//test::vector_large_growth_test();
+	//test::small_vector_test();
+	//test::stable_vector_test();
 	//test::list_test();
 	//test::forward_list_test();
 	//test::string_test();
 	//test::string_view_test();
 	//test::array_test();
 	//test::deque_test();
+	//test::deque_block_test();
+	//test::segmented_algorithm_test();
 	//test::function_test();
 	//test::invoke_test();
 	//test::tuple_test();
@@ -37,6 +61,31 @@ int main()
 	//test_boost::condition_variable_any_test();
 	//test_boost::shared_mutex_test();
 	//test_boost::shared_timed_mutex_test();
+	//test_boost::concurrent_unordered_map_test();
+	//test_boost::snapshot_map_test();
+
+	// ========= Benchmarks =========
+	//test_benchmark::flat_hash_map_benchmark();
+	//test_benchmark::hash_table_emplace_allocation_benchmark();
+	//test_benchmark::hash_table_insert_latency_benchmark();
+	//test_benchmark::hash_bytes_throughput_benchmark();
+	//test_benchmark::node_handle_repartition_benchmark();
+	//test_benchmark::frozen_map_lookup_benchmark();
+	//test_benchmark::btree_map_benchmark();
+	//test_benchmark::map_sorted_load_benchmark();
+	//test_benchmark::map_set_operations_benchmark();
+	//test_benchmark::map_order_statistics_benchmark();
+	//test_benchmark::map_compact_node_benchmark();
+	//test_benchmark::flat_map_benchmark();
+	//test_benchmark::vector_relocation_benchmark();
+	//test_benchmark::small_vector_benchmark();
+	//test_benchmark::buffer_fill_benchmark();
+	//test_benchmark::stable_vector_benchmark();
+	//test_benchmark::deque_block_benchmark();
+	//test_benchmark::segmented_algorithm_benchmark();
+	//test_benchmark::vector_large_growth_benchmark();
+	//test_benchmark::concurrent_unordered_map_benchmark();
+	//test_benchmark::snapshot_map_benchmark();
 
 	return 0;
 }
\ No newline at end of file
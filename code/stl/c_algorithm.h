@@ -42,8 +42,16 @@ template<class InputIt, class UnaryFunction>
 constexpr UnaryFunction for_each(InputIt first, InputIt last, UnaryFunction func) {
     _verify_iteration_range(first, last);
 
-    for (/*Empty*/; first != last; ++first)
-        func(*first);
+    if constexpr (_Is_Segmented_Iterator_v<InputIt>)       // one pointer loop per block
+        _for_each_segment(first, last, [&func](auto segFirst, auto segLast) {
+            for (/*Empty*/; segFirst != segLast; ++segFirst)
+                func(*segFirst);
+
+            return segLast;
+        });
+    else
+        for (/*Empty*/; first != last; ++first)
+            func(*first);
 
     return func; // implicit move
 }
@@ -65,9 +73,15 @@ constexpr typename iterator_traits<InputIt>::difference_type count(InputIt first
     
     typename iterator_traits<InputIt>::difference_type ret = 0;
 
-    for (/*Empty*/; first != last; ++first)
-        if (*first == value)
-            ++ret;
+    if constexpr (_Is_Segmented_Iterator_v<InputIt>)       // one pointer loop per block
+        _for_each_segment(first, last, [&ret, &value](auto segFirst, auto segLast) {
+            ret += custom::count(segFirst, segLast, value);
+            return segLast;
+        });
+    else
+        for (/*Empty*/; first != last; ++first)
+            if (*first == value)
+                ++ret;
 
     return ret;
 }
@@ -159,11 +173,18 @@ template<class InputIt, class Type>
 constexpr InputIt find(InputIt first, InputIt last, const Type& value) {
     _verify_iteration_range(first, last);
 
-    for (/*Empty*/; first != last; ++first)
-        if (*first == value)
-            return first;
- 
-    return last;
+    if constexpr (_Is_Segmented_Iterator_v<InputIt>)       // the walk stops at the block pointer where value was found
+        return _for_each_segment(first, last, [&value](auto segFirst, auto segLast) {
+            return custom::find(segFirst, segLast, value);
+        });
+    else
+    {
+        for (/*Empty*/; first != last; ++first)
+            if (*first == value)
+                return first;
+
+        return last;
+    }
 }
 
 template<class InputIt, class UnaryPredicate>
@@ -197,8 +218,26 @@ template<class InputIt, class OutputIt>
 constexpr OutputIt copy(InputIt first, InputIt last, OutputIt destFirst) {
     _verify_iteration_range(first, last);
 
-    for (/*Empty*/; first != last; ++first, ++destFirst)
-        *destFirst = *first;
+    if constexpr (_Is_Segmented_Iterator_v<InputIt>)       // copy block by block from raw pointers
+        _for_each_segment(first, last, [&destFirst](auto segFirst, auto segLast) {
+            destFirst = custom::copy(segFirst, segLast, destFirst);
+            return segLast;
+        });
+    else if constexpr (_Is_Segmented_Iterator_v<OutputIt> && is_random_access_iterator_v<InputIt>)
+    {
+        OutputIt destLast = destFirst + (last - first);    // fill destination blocks through raw pointers
+        _for_each_segment(destFirst, destLast, [&first](auto segFirst, auto segLast) {
+            for (/*Empty*/; segFirst != segLast; ++segFirst, ++first)
+                *segFirst = *first;
+
+            return segLast;
+        });
+
+        return destLast;
+    }
+    else
+        for (/*Empty*/; first != last; ++first, ++destFirst)
+            *destFirst = *first;
 
     return destFirst;
 }
@@ -317,8 +356,14 @@ template<class ForwardIt, class Type>
 constexpr void fill(ForwardIt first, ForwardIt last, const Type& value) {
     _verify_iteration_range(first, last);
 
-    for (/*Empty*/; first != last; ++first)
-        *first = value;
+    if constexpr (_Is_Segmented_Iterator_v<ForwardIt>)     // one pointer loop per block
+        _for_each_segment(first, last, [&value](auto segFirst, auto segLast) {
+            custom::fill(segFirst, segLast, value);
+            return segLast;
+        });
+    else
+        for (/*Empty*/; first != last; ++first)
+            *first = value;
 }
 
 template<class OutputIt, class Size, class Type>
@@ -347,6 +392,69 @@ constexpr ForwardIt2 swap_ranges(ForwardIt1 first1, ForwardIt1 last1, ForwardIt2
     return first2;
 }
 // END iter_swap, swap_ranges
+
+
+// unique
+template<class ForwardIt, class BinaryPredicate>
+constexpr ForwardIt unique(ForwardIt first, ForwardIt last, BinaryPredicate pred) {
+    _verify_iteration_range(first, last);
+
+    if (first == last)
+        return last;
+
+    ForwardIt result = first;
+    while (++first != last)
+        if (!pred(*result, *first) && ++result != first)
+            *result = custom::move(*first);
+
+    return ++result;
+}
+
+template<class ForwardIt>
+constexpr ForwardIt unique(ForwardIt first, ForwardIt last) {
+    return custom::unique(first, last, equal_to<>{});
+}
+// END unique
+
+
+// rotate
+template<class ForwardIt>
+constexpr ForwardIt rotate(ForwardIt first, ForwardIt middle, ForwardIt last) {    // middle becomes the new first, returns where first ended up
+    _verify_iteration_range(first, middle);
+    _verify_iteration_range(middle, last);
+
+    if (first == middle)
+        return last;
+
+    if (middle == last)
+        return first;
+
+    ForwardIt read = middle;
+    while (true)                                    // first pass, its end is where first lands
+    {
+        custom::iter_swap(first++, read++);
+
+        if (read == last)
+            break;
+
+        if (first == middle)
+            middle = read;
+    }
+
+    ForwardIt result = first;
+    for (read = middle; first != middle; /*Empty*/)   // rotate what is left of [first, last) in place
+    {
+        custom::iter_swap(first++, read++);
+
+        if (read == last)
+            read = middle;
+        else if (first == middle)
+            middle = read;
+    }
+
+    return result;
+}
+// END rotate
 #pragma endregion Modifying sequence operations
 
 
@@ -432,13 +540,322 @@ custom::pair<OutputIt1, OutputIt2> partition_copy(  InputIt first, InputIt last,
 #pragma endregion Partitioning operations
 
 
+#pragma region Heap operations
+CUSTOM_DETAIL_BEGIN
+
+template<class RandomIt, class Distance, class Compare>
+constexpr void _heap_sift_down(RandomIt first, Distance hole, const Distance length, Compare& comp) {
+    auto value = custom::move(first[hole]);
+
+    for (Distance child = 2 * hole + 1; child < length; child = 2 * hole + 1)
+    {
+        if (child + 1 < length && comp(first[child], first[child + 1]))
+            ++child;
+
+        if (!comp(value, first[child]))
+            break;
+
+        first[hole] = custom::move(first[child]);
+        hole        = child;
+    }
+
+    first[hole] = custom::move(value);
+}
+
+template<class RandomIt, class Distance, class Compare>
+constexpr void _heap_sift_up(RandomIt first, Distance hole, Compare& comp) {
+    auto value = custom::move(first[hole]);
+
+    for (Distance parent = (hole - 1) / 2; hole > 0 && comp(first[parent], value); parent = (hole - 1) / 2)
+    {
+        first[hole] = custom::move(first[parent]);
+        hole        = parent;
+    }
+
+    first[hole] = custom::move(value);
+}
+
+CUSTOM_DETAIL_END
+
+template<class RandomIt, class Compare>
+constexpr void make_heap(RandomIt first, RandomIt last, Compare comp) {
+    _verify_iteration_range(first, last);
+
+    const auto length = last - first;
+    for (auto hole = length / 2; hole > 0; /*Empty*/)
+        detail::_heap_sift_down(first, --hole, length, comp);
+}
+
+template<class RandomIt>
+constexpr void make_heap(RandomIt first, RandomIt last) {
+    custom::make_heap(first, last, less<>{});
+}
+
+template<class RandomIt, class Compare>
+constexpr void push_heap(RandomIt first, RandomIt last, Compare comp) {     // [first, last - 1) is a heap
+    _verify_iteration_range(first, last);
+
+    if (last - first > 1)
+        detail::_heap_sift_up(first, last - first - 1, comp);
+}
+
+template<class RandomIt>
+constexpr void push_heap(RandomIt first, RandomIt last) {
+    custom::push_heap(first, last, less<>{});
+}
+
+template<class RandomIt, class Compare>
+constexpr void pop_heap(RandomIt first, RandomIt last, Compare comp) {      // move the top to last - 1
+    _verify_iteration_range(first, last);
+
+    if (last - first > 1)
+    {
+        custom::iter_swap(first, last - 1);
+        detail::_heap_sift_down(first, decltype(last - first)(0), last - first - 1, comp);
+    }
+}
+
+template<class RandomIt>
+constexpr void pop_heap(RandomIt first, RandomIt last) {
+    custom::pop_heap(first, last, less<>{});
+}
+
+template<class RandomIt, class Compare>
+constexpr void sort_heap(RandomIt first, RandomIt last, Compare comp) {
+    for (/*Empty*/; last - first > 1; --last)
+        custom::pop_heap(first, last, comp);
+}
+
+template<class RandomIt>
+constexpr void sort_heap(RandomIt first, RandomIt last) {
+    custom::sort_heap(first, last, less<>{});
+}
+
+template<class RandomIt, class Compare>
+constexpr RandomIt is_heap_until(RandomIt first, RandomIt last, Compare comp) {
+    _verify_iteration_range(first, last);
+
+    const auto length = last - first;
+    for (auto child = decltype(length)(1); child < length; ++child)
+        if (comp(first[(child - 1) / 2], first[child]))
+            return first + child;
+
+    return last;
+}
+
+template<class RandomIt>
+constexpr RandomIt is_heap_until(RandomIt first, RandomIt last) {
+    return custom::is_heap_until(first, last, less<>{});
+}
+
+template<class RandomIt, class Compare>
+constexpr bool is_heap(RandomIt first, RandomIt last, Compare comp) {
+    return custom::is_heap_until(first, last, comp) == last;
+}
+
+template<class RandomIt>
+constexpr bool is_heap(RandomIt first, RandomIt last) {
+    return custom::is_heap(first, last, less<>{});
+}
+#pragma endregion Heap operations
+
+
 #pragma region Sorting operations
-// TODO: implement
+CUSTOM_DETAIL_BEGIN
+
+inline constexpr ptrdiff_t _INSERTION_SORT_THRESHOLD = 16;
+
+template<class RandomIt, class Compare>
+constexpr void _insertion_sort(RandomIt first, RandomIt last, Compare& comp) {
+    if (first == last)
+        return;
+
+    for (RandomIt it = first + 1; it != last; ++it)
+    {
+        auto value = custom::move(*it);
+
+        if (comp(value, *first))                        // new minimum, shift the whole prefix
+        {
+            custom::move_backward(first, it, it + 1);
+            *first = custom::move(value);
+        }
+        else                                            // *first stops the scan
+        {
+            RandomIt hole = it;
+            for (RandomIt prev = it - 1; comp(value, *prev); --prev)
+            {
+                *hole = custom::move(*prev);
+                hole = prev;
+            }
+
+            *hole = custom::move(value);
+        }
+    }
+}
+
+template<class RandomIt, class Compare>
+constexpr void _move_median_to_first(RandomIt result, RandomIt a, RandomIt b, RandomIt c, Compare& comp) {
+    if (comp(*a, *b))
+    {
+        if (comp(*b, *c))
+            custom::iter_swap(result, b);
+        else if (comp(*a, *c))
+            custom::iter_swap(result, c);
+        else
+            custom::iter_swap(result, a);
+    }
+    else if (comp(*a, *c))
+        custom::iter_swap(result, a);
+    else if (comp(*b, *c))
+        custom::iter_swap(result, c);
+    else
+        custom::iter_swap(result, b);
+}
+
+template<class RandomIt, class Compare>
+constexpr RandomIt _unguarded_partition(RandomIt first, RandomIt last, RandomIt pivot, Compare& comp) {
+    // the median of three guarantees an element on each side that stops the scans
+    for (;;)
+    {
+        while (comp(*first, *pivot))
+            ++first;
+
+        --last;
+        while (comp(*pivot, *last))
+            --last;
+
+        if (!(first < last))
+            return first;
+
+        custom::iter_swap(first, last);
+        ++first;
+    }
+}
+
+template<class RandomIt, class Compare>
+constexpr void _intro_sort_loop(RandomIt first, RandomIt last, size_t depthLimit, Compare& comp) {
+    while (last - first > _INSERTION_SORT_THRESHOLD)
+    {
+        if (depthLimit == 0)                            // too many bad pivots, heapsort the rest
+        {
+            custom::make_heap(first, last, comp);
+            custom::sort_heap(first, last, comp);
+            return;
+        }
+
+        --depthLimit;
+        _move_median_to_first(first, first + 1, first + (last - first) / 2, last - 1, comp);
+        RandomIt cut = _unguarded_partition(first + 1, last, first, comp);
+
+        _intro_sort_loop(cut, last, depthLimit, comp);
+        last = cut;
+    }
+}
+
+CUSTOM_DETAIL_END
+
+// sort
+template<class RandomIt, class Compare>
+constexpr void sort(RandomIt first, RandomIt last, Compare comp) {     // introsort, O(n log n) worst case
+    _verify_iteration_range(first, last);
+
+    size_t depthLimit = 0;
+    for (auto length = last - first; length > 1; length /= 2)
+        depthLimit += 2;
+
+    detail::_intro_sort_loop(first, last, depthLimit, comp);
+    detail::_insertion_sort(first, last, comp);         // elements are at most _INSERTION_SORT_THRESHOLD away from their place
+}
+
+template<class RandomIt>
+constexpr void sort(RandomIt first, RandomIt last) {
+    custom::sort(first, last, less<>{});
+}
+// END sort
 #pragma endregion Sorting operations
 
 
 #pragma region Binary search operations // (on sorted ranges)
-// TODO: implement
+// lower_bound, upper_bound, equal_range, binary_search
+template<class ForwardIt, class Type, class Compare>
+constexpr ForwardIt lower_bound(ForwardIt first, ForwardIt last, const Type& value, Compare comp) {    // first element not less than value
+    _verify_iteration_range(first, last);
+
+    if constexpr (is_random_access_iterator_v<ForwardIt>)
+    {
+        // branchless: the loop count depends only on the length, the step compiles to a conditional move
+        auto length = last - first;
+        if (length == 0)
+            return first;
+
+        while (length > 1)
+        {
+            const auto half = length / 2;
+            first   = comp(first[half - 1], value) ? first + half : first;
+            length  -= half;
+        }
+
+        return comp(*first, value) ? first + 1 : first;
+    }
+    else
+        return custom::partition_point(first, last, [&value, &comp](const auto& elem) { return comp(elem, value); });
+}
+
+template<class ForwardIt, class Type>
+constexpr ForwardIt lower_bound(ForwardIt first, ForwardIt last, const Type& value) {
+    return custom::lower_bound(first, last, value, less<>{});
+}
+
+template<class ForwardIt, class Type, class Compare>
+constexpr ForwardIt upper_bound(ForwardIt first, ForwardIt last, const Type& value, Compare comp) {    // first element greater than value
+    _verify_iteration_range(first, last);
+
+    if constexpr (is_random_access_iterator_v<ForwardIt>)
+    {
+        auto length = last - first;
+        if (length == 0)
+            return first;
+
+        while (length > 1)
+        {
+            const auto half = length / 2;
+            first   = comp(value, first[half - 1]) ? first : first + half;
+            length  -= half;
+        }
+
+        return comp(value, *first) ? first : first + 1;
+    }
+    else
+        return custom::partition_point(first, last, [&value, &comp](const auto& elem) { return !comp(value, elem); });
+}
+
+template<class ForwardIt, class Type>
+constexpr ForwardIt upper_bound(ForwardIt first, ForwardIt last, const Type& value) {
+    return custom::upper_bound(first, last, value, less<>{});
+}
+
+template<class ForwardIt, class Type, class Compare>
+constexpr custom::pair<ForwardIt, ForwardIt> equal_range(ForwardIt first, ForwardIt last, const Type& value, Compare comp) {
+    first = custom::lower_bound(first, last, value, comp);
+    return {first, custom::upper_bound(first, last, value, comp)};
+}
+
+template<class ForwardIt, class Type>
+constexpr custom::pair<ForwardIt, ForwardIt> equal_range(ForwardIt first, ForwardIt last, const Type& value) {
+    return custom::equal_range(first, last, value, less<>{});
+}
+
+template<class ForwardIt, class Type, class Compare>
+constexpr bool binary_search(ForwardIt first, ForwardIt last, const Type& value, Compare comp) {
+    first = custom::lower_bound(first, last, value, comp);
+    return first != last && !comp(value, *first);
+}
+
+template<class ForwardIt, class Type>
+constexpr bool binary_search(ForwardIt first, ForwardIt last, const Type& value) {
+    return custom::binary_search(first, last, value, less<>{});
+}
+// END lower_bound, upper_bound, equal_range, binary_search
 #pragma endregion Binary search operations
 
 
@@ -518,73 +935,6 @@ constexpr OutputIt set_intersection(InputIt1 first1, InputIt1 last1,
 #pragma endregion Set operations
 
 
-#pragma region Heap operations
-template<class RandomIt>
-constexpr void make_heap(RandomIt first, RandomIt last) {
-    // TODO: implement
-}
-
-template<class RandomIt, class Compare>
-constexpr void make_heap(RandomIt first, RandomIt last, Compare comp) {
-    // TODO: implement
-}
-
-template<class RandomIt>
-constexpr void push_heap(RandomIt first, RandomIt last) {
-    // TODO: implement
-}
-
-template<class RandomIt, class Compare>
-constexpr void push_heap(RandomIt first, RandomIt last, Compare comp) {
-    // TODO: implement
-}
-
-template<class RandomIt>
-constexpr void pop_heap(RandomIt first, RandomIt last) {
-    // TODO: implement
-}
-
-template<class RandomIt, class Compare>
-constexpr void pop_heap(RandomIt first, RandomIt last, Compare comp) {
-    // TODO: implement
-}
-
-template<class RandomIt>
-constexpr void sort_heap(RandomIt first, RandomIt last) {
-    // TODO: implement
-}
-
-template<class RandomIt, class Compare>
-constexpr void sort_heap(RandomIt first, RandomIt last, Compare comp) {
-    // TODO: implement
-}
-
-template<class RandomIt>
-constexpr bool is_heap(RandomIt first, RandomIt last) {
-    // TODO: implement
-    return false;
-}
-
-template<class RandomIt, class Compare>
-constexpr bool is_heap(RandomIt first, RandomIt last, Compare comp) {
-    // TODO: implement
-    return false;
-}
-
-template<class RandomIt>
-constexpr RandomIt is_heap_until(RandomIt first, RandomIt last) {
-    // TODO: implement
-    return RandomIt();
-}
-
-template<class RandomIt, class Compare>
-constexpr RandomIt is_heap_until(RandomIt first, RandomIt last, Compare comp) {
-    // TODO: implement
-    return RandomIt();
-}
-#pragma endregion Heap operations
-
-
 #pragma region Minimum/maximum operations
 // max
 template<class Type>
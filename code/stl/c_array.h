@@ -96,6 +96,26 @@ public:
 		return !(*this == other);
 	}
 
+	constexpr difference_type operator-(const _Array_Const_Iterator& other) const noexcept {
+		return static_cast<difference_type>(_Index - other._Index);
+	}
+
+	constexpr bool operator<(const _Array_Const_Iterator& other) const noexcept {
+		return _Index < other._Index;
+	}
+
+	constexpr bool operator>(const _Array_Const_Iterator& other) const noexcept {
+		return other < *this;
+	}
+
+	constexpr bool operator<=(const _Array_Const_Iterator& other) const noexcept {
+		return !(other < *this);
+	}
+
+	constexpr bool operator>=(const _Array_Const_Iterator& other) const noexcept {
+		return !(*this < other);
+	}
+
 public:
 
 	constexpr size_t get_index() const noexcept {				// Get the position for the element in array from iterator
@@ -180,6 +200,8 @@ public:
 		return temp;
 	}
 
+	using _Base::operator-;								// iterator difference
+
 	constexpr pointer operator->() const noexcept {
 		return const_cast<pointer>(_Base::operator->());
 	}
@@ -306,7 +328,7 @@ public:
 	}
 
 	constexpr const_iterator begin() const noexcept {
-		return const_iterator(_array, 0);
+		return const_iterator(const_cast<value_type*>(_array), 0);
 	}
 
 	constexpr reverse_iterator rbegin() noexcept {
@@ -322,7 +344,7 @@ public:
 	}
 
 	constexpr const_iterator end() const noexcept {
-		return const_iterator(_array, Size);
+		return const_iterator(const_cast<value_type*>(_array), Size);
 	}
 
 	constexpr reverse_iterator rend() noexcept {
@@ -38,7 +38,7 @@ constexpr bool has_single_bit(Ty val) noexcept {
 // Used at compile time and when said instructions are not supported.
 // see "Hacker's Delight" section 5-3
 template<class Ty, enable_if_t<is_unsigned_integer_v<Ty>, bool> = true>
-constexpr int countl_zero(Ty val) noexcept {
+constexpr int _countl_zero_fallback(Ty val) noexcept {
     Ty yy = 0;
 
     unsigned int nn = numeric_limits<Ty>::digits;
@@ -64,10 +64,50 @@ constexpr int countl_zero(Ty val) noexcept {
 // Implementation of countr_zero without using specialized CPU instructions.
 // Used at compile time and when said instructions are not supported.
 // see "Hacker's Delight" section 5-4
+template<class Ty, enable_if_t<is_unsigned_integer_v<Ty>, bool> = true>
+constexpr int _countr_zero_fallback(Ty val) noexcept {
+    constexpr int digits = numeric_limits<Ty>::digits;
+    return digits - _countl_zero_fallback(static_cast<Ty>(static_cast<Ty>(~val) & static_cast<Ty>(val - 1)));
+}
+
+
+template<class Ty, enable_if_t<is_unsigned_integer_v<Ty>, bool> = true>
+constexpr int countl_zero(Ty val) noexcept {
+#ifdef __GNUG__
+    constexpr int digits = numeric_limits<Ty>::digits;
+
+    if (val == 0)   // builtins are undefined for 0
+        return digits;
+
+    if constexpr (digits <= numeric_limits<unsigned>::digits)
+        return __builtin_clz(val) - (numeric_limits<unsigned>::digits - digits);
+    else if constexpr (digits <= numeric_limits<unsigned long>::digits)
+        return __builtin_clzl(val) - (numeric_limits<unsigned long>::digits - digits);
+    else // (digits <= numeric_limits<unsigned long long>::digits)
+        return __builtin_clzll(val) - (numeric_limits<unsigned long long>::digits - digits);
+#else // __GNUG__
+    return _countl_zero_fallback(val);
+#endif // __GNUG__
+}
+
+
 template<class Ty, enable_if_t<is_unsigned_integer_v<Ty>, bool> = true>
 constexpr int countr_zero(Ty val) noexcept {
+#ifdef __GNUG__
     constexpr int digits = numeric_limits<Ty>::digits;
-    return digits - countl_zero(static_cast<Ty>(static_cast<Ty>(~val) & static_cast<Ty>(val - 1)));
+
+    if (val == 0)   // builtins are undefined for 0
+        return digits;
+
+    if constexpr (digits <= numeric_limits<unsigned>::digits)
+        return __builtin_ctz(val);
+    else if constexpr (digits <= numeric_limits<unsigned long>::digits)
+        return __builtin_ctzl(val);
+    else // (digits <= numeric_limits<unsigned long long>::digits)
+        return __builtin_ctzll(val);
+#else // __GNUG__
+    return _countr_zero_fallback(val);
+#endif // __GNUG__
 }
 
 
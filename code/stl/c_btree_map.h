@@ -0,0 +1,92 @@
+#pragma once
+#include "x_btree.h"
+#include "c_map.h"		// _Map_Traits
+
+CUSTOM_BEGIN
+
+template<class Key, class Type,
+class Compare 	= custom::less<Key>,
+class Alloc		= custom::allocator<custom::pair<Key, Type>>,
+size_t NodeBytes	= 256>
+class btree_map : public detail::_BTree<_Map_Traits<Key, Type, Compare, Alloc>, NodeBytes>		// btree_map Template
+{
+private:
+	using _Base = detail::_BTree<_Map_Traits<Key, Type, Compare, Alloc>, NodeBytes>;
+
+public:
+	using key_type					= typename _Base::key_type;
+	using mapped_type				= typename _Base::mapped_type;
+	using key_compare				= typename _Base::key_compare;
+	using value_type				= typename _Base::value_type;
+	using reference					= typename _Base::reference;
+	using const_reference			= typename _Base::const_reference;
+	using pointer					= typename _Base::pointer;
+	using const_pointer				= typename _Base::const_pointer;
+	using allocator_type			= typename _Base::allocator_type;
+
+	using iterator					= typename _Base::iterator;
+	using const_iterator			= typename _Base::const_iterator;
+	using reverse_iterator			= typename _Base::reverse_iterator;
+	using const_reverse_iterator	= typename _Base::const_reverse_iterator;
+
+public:
+	// Constructors
+
+	btree_map()
+		:_Base() { /*Empty*/ }
+
+	btree_map(std::initializer_list<value_type> list)
+		:_Base(list) { /*Empty*/ }
+
+	btree_map(const btree_map& other)
+		:_Base(other) { /*Empty*/ }
+
+	btree_map(btree_map&& other) noexcept
+		:_Base(custom::move(other)) { /*Empty*/ }
+
+	~btree_map() { /*Empty*/ }
+
+public:
+	// Operators
+
+	mapped_type& operator[](const key_type& key) {				// Access value or create new one with key and assignment (no const)
+		return this->_try_emplace(key).first->second;
+	}
+
+	mapped_type& operator[](key_type&& key) {
+		return this->_try_emplace(custom::move(key)).first->second;
+	}
+
+	btree_map& operator=(const btree_map& other) {
+		_Base::operator=(other);
+		return *this;
+	}
+
+	btree_map& operator=(btree_map&& other) noexcept {
+		_Base::operator=(custom::move(other));
+		return *this;
+	}
+
+public:
+	// Main functions
+
+	template<class... Args>
+	pair<iterator, bool> try_emplace(const key_type& key, Args&&... args) {	// Force construction with known key and given arguments for object
+		return this->_try_emplace(key, custom::forward<Args>(args)...);
+	}
+
+	template<class... Args>
+	pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+		return this->_try_emplace(custom::move(key), custom::forward<Args>(args)...);
+	}
+
+	const mapped_type& at(const key_type& key) const {			// Access _Value at key with check
+		return this->_at(key);
+	}
+
+	mapped_type& at(const key_type& key) {
+		return this->_at(key);
+	}
+};  // END btree_map Template
+
+CUSTOM_END
\ No newline at end of file
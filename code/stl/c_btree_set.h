@@ -0,0 +1,63 @@
+#pragma once
+#include "x_btree.h"
+#include "c_set.h"		// _Set_Traits
+
+CUSTOM_BEGIN
+
+template<class Key,
+class Compare 	= custom::less<Key>,
+class Alloc		= custom::allocator<Key>,
+size_t NodeBytes	= 256>
+class btree_set : public detail::_BTree<_Set_Traits<Key, Compare, Alloc>, NodeBytes>		// btree_set Template
+{
+private:
+	using _Base = detail::_BTree<_Set_Traits<Key, Compare, Alloc>, NodeBytes>;
+
+public:
+	using key_type					= typename _Base::key_type;
+	using mapped_type				= typename _Base::mapped_type;
+	using key_compare				= typename _Base::key_compare;
+	using value_type				= typename _Base::value_type;
+	using reference					= typename _Base::reference;
+	using const_reference			= typename _Base::const_reference;
+	using pointer					= typename _Base::pointer;
+	using const_pointer				= typename _Base::const_pointer;
+	using allocator_type			= typename _Base::allocator_type;
+
+	using iterator					= typename _Base::iterator;
+	using const_iterator			= typename _Base::const_iterator;
+	using reverse_iterator			= typename _Base::reverse_iterator;
+	using const_reverse_iterator	= typename _Base::const_reverse_iterator;
+
+public:
+    // Constructors
+
+	btree_set()
+		:_Base() { /*Empty*/ }
+
+	btree_set(std::initializer_list<value_type> list)
+		:_Base(list) { /*Empty*/ }
+
+	btree_set(const btree_set& other)
+		: _Base(other) { /*Empty*/ }
+
+	btree_set(btree_set&& other) noexcept
+		: _Base(custom::move(other)) { /*Empty*/ }
+
+	~btree_set() { /*Empty*/ }
+
+public:
+    // Operators
+
+	btree_set& operator=(const btree_set& other) {
+		_Base::operator=(other);
+		return *this;
+	}
+
+	btree_set& operator=(btree_set&& other) noexcept {
+		_Base::operator=(custom::move(other));
+		return *this;
+	}
+}; // END btree_set Template
+
+CUSTOM_END
\ No newline at end of file
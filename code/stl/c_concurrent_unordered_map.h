@@ -0,0 +1,291 @@
+#pragma once
+
+#if defined __GNUG__
+#include "c_algorithm.h"
+#include "c_unordered_map.h"
+#include "c_shared_mutex.h"
+#include "c_array.h"
+#include "c_bit.h"			// has_single_bit, countr_zero
+
+
+CUSTOM_BEGIN
+
+// concurrent_unordered_map Template implemented as an array of independently locked unordered_map shards
+// The key is hashed once: the shard is chosen with the high bits of the mixed hash, the shard table uses the low bits
+// No iterators: elements are reached through visitor callbacks that run under the shard lock
+template<class Key, class Type,
+class Hash 				= custom::hash<Key>,
+class Compare 			= custom::equal_to<Key>,
+class Alloc 			= custom::allocator<custom::pair<Key, Type>>,
+size_t ShardCount		= 64>
+class concurrent_unordered_map
+{
+private:
+	using _Map = unordered_map<Key, Type, Hash, Compare, Alloc>;
+
+	class _Shard_Map : public _Map				// unordered_map that takes the hash computed for the shard pick
+	{
+	public:
+		using _Map::_try_emplace_hashed;
+		using _Map::_find_hashed;
+		using _Map::_erase_hashed;
+	};
+
+	static_assert(custom::has_single_bit(ShardCount), "Shard count must be a power of 2!");
+
+	struct alignas(64) _Shard					// padded to a cache line, so locks of neighbour shards don't false share
+	{
+		mutable shared_mutex _Mutex;
+		_Shard_Map _Elems;
+	};
+
+	static constexpr size_t _SHARD_SHIFT = sizeof(size_t) * CHAR_BIT - custom::countr_zero(ShardCount);
+
+public:
+	using key_type 			= typename _Map::key_type;
+	using mapped_type 		= typename _Map::mapped_type;
+	using hasher 			= typename _Map::hasher;
+	using key_compare		= typename _Map::key_compare;
+	using value_type 		= typename _Map::value_type;
+	using reference 		= typename _Map::reference;
+	using const_reference 	= typename _Map::const_reference;
+	using allocator_type 	= typename _Map::allocator_type;
+
+private:
+	hasher _hash;
+	array<_Shard, ShardCount> _shards;
+
+public:
+	// Constructors
+
+	concurrent_unordered_map() = default;
+
+	concurrent_unordered_map(const size_t buckets) {
+		reserve(buckets);
+	}
+
+	~concurrent_unordered_map() = default;
+
+	concurrent_unordered_map(const concurrent_unordered_map&)				= delete;
+	concurrent_unordered_map& operator=(const concurrent_unordered_map&)	= delete;
+
+public:
+	// Main functions
+
+	template<class... Args>
+	bool emplace(const key_type& key, Args&&... args) {				// Insert if key is missing, returns true if inserted
+		const size_t hashVal	= _hash_of(key);
+		_Shard& shard			= _shard_at(hashVal);
+		lock_guard<shared_mutex> lock(shard._Mutex);
+
+		return shard._Elems._try_emplace_hashed(hashVal, key, custom::forward<Args>(args)...).second;
+	}
+
+	template<class Obj>
+	bool insert_or_assign(const key_type& key, Obj&& obj) {			// Insert or overwrite mapped value, returns true if inserted
+		const size_t hashVal	= _hash_of(key);
+		_Shard& shard			= _shard_at(hashVal);
+		lock_guard<shared_mutex> lock(shard._Mutex);
+
+		pair<typename _Map::iterator, bool> result = shard._Elems._try_emplace_hashed(hashVal, key, custom::forward<Obj>(obj));
+		if (!result.second)		// obj was not consumed by construction
+			result.first->second = custom::forward<Obj>(obj);
+
+		return result.second;
+	}
+
+	template<class Obj, class Visitor>
+	bool insert_or_visit(const key_type& key, Obj&& obj, Visitor visitor) {	// Insert, or call visitor(value_type&) on the existing element
+		const size_t hashVal	= _hash_of(key);
+		_Shard& shard			= _shard_at(hashVal);
+		lock_guard<shared_mutex> lock(shard._Mutex);
+
+		pair<typename _Map::iterator, bool> result = shard._Elems._try_emplace_hashed(hashVal, key, custom::forward<Obj>(obj));
+		if (!result.second)
+			visitor(*result.first);
+
+		return result.second;
+	}
+
+	template<class Visitor>
+	bool visit(const key_type& key, Visitor visitor) {				// Call visitor(value_type&) under exclusive lock, returns true if found
+		const size_t hashVal	= _hash_of(key);
+		_Shard& shard			= _shard_at(hashVal);
+		lock_guard<shared_mutex> lock(shard._Mutex);
+
+		auto it = shard._Elems._find_hashed(key, hashVal);
+		if (it == shard._Elems.end())
+			return false;
+
+		visitor(*it);
+		return true;
+	}
+
+	template<class Visitor>
+	bool visit(const key_type& key, Visitor visitor) const {		// Call visitor(const value_type&) under shared lock
+		const size_t hashVal	= _hash_of(key);
+		const _Shard& shard		= _shard_at(hashVal);
+		shared_lock<shared_mutex> lock(shard._Mutex);
+
+		auto it = shard._Elems._find_hashed(key, hashVal);
+		if (it == shard._Elems.end())
+			return false;
+
+		visitor(*it);
+		return true;
+	}
+
+	template<class Visitor>
+	size_t visit_all(Visitor visitor) {								// Visit every element, one shard locked at a time
+		size_t count = 0;
+
+		for (_Shard& shard : _shards)
+		{
+			lock_guard<shared_mutex> lock(shard._Mutex);
+
+			for (auto& val : shard._Elems)
+				visitor(val);
+
+			count += shard._Elems.size();
+		}
+
+		return count;
+	}
+
+	template<class Visitor>
+	size_t visit_all(Visitor visitor) const {
+		size_t count = 0;
+
+		for (const _Shard& shard : _shards)
+		{
+			shared_lock<shared_mutex> lock(shard._Mutex);
+
+			for (const auto& val : shard._Elems)
+				visitor(val);
+
+			count += shard._Elems.size();
+		}
+
+		return count;
+	}
+
+	bool erase(const key_type& key) {
+		const size_t hashVal	= _hash_of(key);
+		_Shard& shard			= _shard_at(hashVal);
+		lock_guard<shared_mutex> lock(shard._Mutex);
+
+		const size_t oldSize = shard._Elems.size();
+		shard._Elems._erase_hashed(key, hashVal);
+
+		return shard._Elems.size() != oldSize;
+	}
+
+	template<class Predicate>
+	bool erase_if(const key_type& key, Predicate pred) {			// Erase the element if pred(value_type&) holds, atomically
+		const size_t hashVal	= _hash_of(key);
+		_Shard& shard			= _shard_at(hashVal);
+		lock_guard<shared_mutex> lock(shard._Mutex);
+
+		auto it = shard._Elems._find_hashed(key, hashVal);
+		if (it == shard._Elems.end() || !pred(*it))
+			return false;
+
+		shard._Elems._erase_hashed(key, hashVal);
+		return true;
+	}
+
+	template<class Predicate>
+	size_t erase_if(Predicate pred) {								// Erase every element for which pred(value_type&) holds
+		size_t count = 0;
+
+		for (_Shard& shard : _shards)
+		{
+			lock_guard<shared_mutex> lock(shard._Mutex);
+
+			for (auto it = shard._Elems.begin(); it != shard._Elems.end(); /*Empty*/)
+				if (pred(*it))
+				{
+					it = shard._Elems.erase(it);
+					++count;
+				}
+				else
+					++it;
+		}
+
+		return count;
+	}
+
+	bool contains(const key_type& key) const {
+		const size_t hashVal	= _hash_of(key);
+		const _Shard& shard		= _shard_at(hashVal);
+		shared_lock<shared_mutex> lock(shard._Mutex);
+
+		return shard._Elems._find_hashed(key, hashVal) != shard._Elems.end();
+	}
+
+	void reserve(const size_t size) {								// Spread the reservation over all shards
+		const size_t shardSize = (size + ShardCount - 1) / ShardCount;
+
+		for (_Shard& shard : _shards)
+		{
+			lock_guard<shared_mutex> lock(shard._Mutex);
+			shard._Elems.reserve(shardSize);
+		}
+	}
+
+	void clear() {
+		for (_Shard& shard : _shards)
+		{
+			lock_guard<shared_mutex> lock(shard._Mutex);
+			shard._Elems.clear();
+		}
+	}
+
+	size_t size() const {											// Not a snapshot: shards are counted one at a time
+		size_t count = 0;
+
+		for (const _Shard& shard : _shards)
+		{
+			shared_lock<shared_mutex> lock(shard._Mutex);
+			count += shard._Elems.size();
+		}
+
+		return count;
+	}
+
+	bool empty() const {
+		return size() == 0;
+	}
+
+	static constexpr size_t shard_count() noexcept {
+		return ShardCount;
+	}
+
+private:
+	// Helpers
+
+	size_t _hash_of(const key_type& key) const {					// same mixed hash the shard tables use for their buckets
+		return detail::_mix_hash(_hash(key));
+	}
+
+	static size_t _shard_index(const size_t hashVal) noexcept {
+		if constexpr (ShardCount == 1)
+			return (void)hashVal, 0;
+		else
+			return hashVal >> _SHARD_SHIFT;							// high bits, independent of the shard bucket mask
+	}
+
+	_Shard& _shard_at(const size_t hashVal) {
+		return _shards[_shard_index(hashVal)];
+	}
+
+	const _Shard& _shard_at(const size_t hashVal) const {
+		return _shards[_shard_index(hashVal)];
+	}
+}; // END concurrent_unordered_map Template
+
+CUSTOM_END
+
+#elif defined _MSC_VER
+#error NO ConcurrentUnorderedMap implementation
+#endif      // __GNUG__ and _MSC_VER
\ No newline at end of file
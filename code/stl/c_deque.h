@@ -3,10 +3,15 @@
 #include "c_utility.h"
 #include "c_iterator.h"
 #include "c_algorithm.h"
+#include "c_bit.h"
 
 
 CUSTOM_BEGIN
 
+template<class Type>
+struct deque_block_size				// elements per deque block, specialize to override (must be a power of two)
+	: integral_constant<size_t, custom::bit_floor((custom::max)(size_t{CUSTOM_DEQUE_BLOCK_BYTES} / sizeof(Type), size_t{16}))> {};
+
 template<class Type, class Alloc>
 struct _Deque_Data
 {
@@ -27,11 +32,19 @@ struct _Deque_Data
 	size_t _First 			= 0;
 	size_t _Size 			= 0;
 
-	static constexpr size_t _BLOCK_SIZE = 4;
+	static constexpr size_t _BLOCK_SIZE		= deque_block_size<value_type>::value;
+	static constexpr size_t _BLOCK_SHIFT	= static_cast<size_t>(custom::bit_width(_BLOCK_SIZE)) - 1;
+	static constexpr size_t _BLOCK_MASK		= _BLOCK_SIZE - 1;
+
+	static_assert(custom::has_single_bit(_BLOCK_SIZE), "deque block size must be a power of two!");
 
-	size_t get_block(const size_t offset) const noexcept {
-		return (offset / _BLOCK_SIZE) % _MapCapacity;
+	size_t get_block(const size_t offset) const noexcept {				// _MapCapacity is a power of two as well
+		return (offset >> _BLOCK_SHIFT) & (_MapCapacity - 1);
     }
+
+	pointer element(const size_t offset) const noexcept {
+		return _Map[get_block(offset)] + (offset & _BLOCK_MASK);
+	}
 };
 
 template<class DequeData>
@@ -46,6 +59,7 @@ public:
 	using difference_type 	= typename _Data::difference_type;
 	using reference			= typename _Data::const_reference;
 	using pointer			= typename _Data::const_pointer;
+	using _Segmented		= true_type;						// blocks are contiguous, see _for_each_segment
 
 	size_t _Offset			= 0;
 	const _Data* _RefData	= nullptr;
@@ -118,9 +132,7 @@ public:
 						_Offset < _RefData->_First + _RefData->_Size,
 						"Cannot dereference end iterator.");
 
-		size_t block	= _RefData->get_block(_Offset);
-		size_t offset	= _Offset % _RefData->_BLOCK_SIZE;
-		return _RefData->_Map[block][offset];
+		return *_RefData->element(_Offset);
 	}
 
 	reference operator[](const difference_type diff) const noexcept {
@@ -149,6 +161,15 @@ public:
 		CUSTOM_ASSERT(first._RefData == last._RefData, "deque iterators in range are from different containers");
 		CUSTOM_ASSERT(first._Offset <= last._Offset, "deque iterator range transposed");
 	}
+
+	pointer _segment_first() const noexcept {
+		return _RefData->element(_Offset);
+	}
+
+	pointer _segment_last(const _Deque_Const_Iterator& last) const noexcept {
+		const size_t blockLeft = _Data::_BLOCK_SIZE - (_Offset & _Data::_BLOCK_MASK);
+		return _segment_first() + (custom::min)(blockLeft, last._Offset - _Offset);
+	}
 }; // END _Deque_Const_Iterator
 
 template<class DequeData>
@@ -227,6 +248,14 @@ public:
 	reference operator[](const difference_type diff) const noexcept {
         return const_cast<reference>(_Base::operator[](diff));
     }
+
+	pointer _segment_first() const noexcept {
+		return const_cast<pointer>(_Base::_segment_first());
+	}
+
+	pointer _segment_last(const _Deque_Iterator& last) const noexcept {
+		return const_cast<pointer>(_Base::_segment_last(last));
+	}
 }; // END deque iterator
 
 
@@ -261,7 +290,7 @@ private:
 	_Data _data;
 	allocator_type _alloc;
 
-	static constexpr size_t _DEFAULT_CAPACITY = 8;
+	static constexpr size_t _DEFAULT_CAPACITY = 8;						// map capacity stays a power of two, it only doubles
 
 public:
 	// Constructors
@@ -357,7 +386,7 @@ public:
 		if (_data._Map[block] == nullptr)
 			_data._Map[block] = _alloc.allocate(_data._BLOCK_SIZE);
 
-		_Alloc_Traits::construct(_alloc, _data._Map[block] + backOffset % _data._BLOCK_SIZE, custom::forward<Args>(args)...);
+		_Alloc_Traits::construct(_alloc, _data._Map[block] + (backOffset & _data._BLOCK_MASK), custom::forward<Args>(args)...);
 		++_data._Size;
 	}
 
@@ -372,10 +401,7 @@ public:
 	void pop_back() {
 		if (!empty())
 		{
-			size_t backOffset	= _data._First + _data._Size - 1;
-			size_t block		= _data.get_block(backOffset);
-
-			_Alloc_Traits::destroy(_alloc, _data._Map[block] + backOffset % _data._BLOCK_SIZE);
+			_Alloc_Traits::destroy(_alloc, _data.element(_data._First + _data._Size - 1));
 			if (--_data._Size == 0)
 				_data._First = 0;
 		}
@@ -392,7 +418,7 @@ public:
 		if (_data._Map[block] == nullptr)
 			_data._Map[block] = _alloc.allocate(_data._BLOCK_SIZE);
 
-		_Alloc_Traits::construct(_alloc, _data._Map[block] + _data._First % _data._BLOCK_SIZE, custom::forward<Args>(args)...);
+		_Alloc_Traits::construct(_alloc, _data._Map[block] + (_data._First & _data._BLOCK_MASK), custom::forward<Args>(args)...);
 		++_data._Size;
 	}
 
@@ -407,9 +433,7 @@ public:
 	void pop_front() {
 		if (!empty())
 		{
-			size_t block = _data.get_block(_data._First);
-
-			_Alloc_Traits::destroy(_alloc, _data._Map[block] + _data._First % _data._BLOCK_SIZE);
+			_Alloc_Traits::destroy(_alloc, _data.element(_data._First));
 			if (--_data._Size == 0)
 				_data._First = 0;
 			else
@@ -605,7 +629,7 @@ private:
 
 	void _reserve(const size_t newMapCapacity) {
 		size_t newSize			= _data._Size;
-		size_t newFirst			= _data._First % _data._BLOCK_SIZE;
+		size_t newFirst			= _data._First & _data._BLOCK_MASK;
 		_MapPtr newMap 			= _create_empty_map(newMapCapacity);
 		size_t firstBlock		= _data.get_block(_data._First);					// block to find first elem
 		size_t lastBlock		= _data.get_block(_data._First + _data._Size - 1);	// block to find last elem (always != firstBlock)
@@ -0,0 +1,120 @@
+#pragma once
+#include "x_flat_hash_table.h"
+#include "c_unordered_map.h"	// _Umap_Traits
+
+CUSTOM_BEGIN
+
+template<class Key, class Type,
+class Hash 		= custom::hash<Key>,
+class Compare 	= custom::equal_to<Key>,
+class Alloc 	= custom::allocator<custom::pair<Key, Type>>>
+class flat_hash_map : public detail::_Flat_Hash_Table<_Umap_Traits<Key, Type, Hash, Compare, Alloc>>	// flat_hash_map Template
+{
+private:
+	using _Base = detail::_Flat_Hash_Table<_Umap_Traits<Key, Type, Hash, Compare, Alloc>>;
+
+public:
+	static_assert(is_same_v<pair<Key, Type>, typename Alloc::value_type>, "Object type and allocator type must be the same!");
+	static_assert(is_object_v<Key>, "Containers require object type!");
+
+	using key_type 			= typename _Base::key_type;
+	using mapped_type 		= typename _Base::mapped_type;
+	using hasher 			= typename _Base::hasher;
+	using key_compare		= typename _Base::key_compare;
+	using value_type 		= typename _Base::value_type;
+	using reference 		= typename _Base::reference;
+	using const_reference 	= typename _Base::const_reference;
+	using pointer 			= typename _Base::pointer;
+	using const_pointer		= typename _Base::const_pointer;
+	using allocator_type 	= typename _Base::allocator_type;
+
+	using iterator			= typename _Base::iterator;
+	using const_iterator 	= typename _Base::const_iterator;
+
+public:
+	// Constructors
+
+	flat_hash_map()
+		:_Base() { /*Empty*/ }
+
+	flat_hash_map(const size_t slots)
+		:_Base(slots) { /*Empty*/ }
+
+	flat_hash_map(std::initializer_list<value_type> list)
+		:_Base(list) { /*Empty*/ }
+
+	flat_hash_map(const flat_hash_map& other)
+		:_Base(other) { /*Empty*/ }
+
+	flat_hash_map(flat_hash_map&& other) noexcept
+		:_Base(custom::move(other)) { /*Empty*/ }
+
+	~flat_hash_map() = default;
+
+public:
+	// Operators
+
+	mapped_type& operator[](const key_type& key) {				// Access value or create new one with key and assignment
+		return this->_try_emplace(key).first->second;
+	}
+
+	mapped_type& operator[](key_type&& key) {
+		return this->_try_emplace(custom::move(key)).first->second;
+	}
+
+	flat_hash_map& operator=(const flat_hash_map& other) {
+		_Base::operator=(other);
+		return *this;
+	}
+
+	flat_hash_map& operator=(flat_hash_map&& other) noexcept {
+		_Base::operator=(custom::move(other));
+		return *this;
+	}
+
+public:
+	// Main functions
+
+	template<class... Args>
+	pair<iterator, bool> try_emplace(const key_type& key, Args&&... args) {	// Force construction with known key and given arguments for object
+		return this->_try_emplace(key, custom::forward<Args>(args)...);
+	}
+
+	template<class... Args>
+	pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+		return this->_try_emplace(custom::move(key), custom::forward<Args>(args)...);
+	}
+
+	template<class Obj>
+	pair<iterator, bool> insert_or_assign(const key_type& key, Obj&& obj) {	// Insert if key is missing, assign mapped value otherwise
+		return _insert_or_assign(key, custom::forward<Obj>(obj));
+	}
+
+	template<class Obj>
+	pair<iterator, bool> insert_or_assign(key_type&& key, Obj&& obj) {
+		return _insert_or_assign(custom::move(key), custom::forward<Obj>(obj));
+	}
+
+	const mapped_type& at(const key_type& key) const {			// Access value at key with check
+		return this->_at(key);
+	}
+
+	mapped_type& at(const key_type& key) {
+		return this->_at(key);
+	}
+
+private:
+	// Helpers
+
+	template<class _KeyType, class Obj>
+	pair<iterator, bool> _insert_or_assign(_KeyType&& key, Obj&& obj) {
+		pair<iterator, bool> result = this->_try_emplace(custom::forward<_KeyType>(key), custom::forward<Obj>(obj));
+
+		if (!result.second)		// obj was not consumed by construction
+			result.first->second = custom::forward<Obj>(obj);
+
+		return result;
+	}
+}; // END flat_hash_map Template
+
+CUSTOM_END
\ No newline at end of file
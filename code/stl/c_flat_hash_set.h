@@ -0,0 +1,68 @@
+#pragma once
+#include "x_flat_hash_table.h"
+#include "c_unordered_set.h"	// _Uset_Traits
+
+CUSTOM_BEGIN
+
+template<class Key,
+class Hash 		= custom::hash<Key>,
+class Compare 	= custom::equal_to<Key>,
+class Alloc 	= custom::allocator<Key>>
+class flat_hash_set : public detail::_Flat_Hash_Table<_Uset_Traits<Key, Hash, Compare, Alloc>>		// flat_hash_set Template
+{
+private:
+	using _Base = detail::_Flat_Hash_Table<_Uset_Traits<Key, Hash, Compare, Alloc>>;
+
+public:
+	static_assert(is_same_v<Key, typename Alloc::value_type>, "Object type and Allocator type must be the same!");
+	static_assert(is_object_v<Key>, "Containers require object type!");
+
+	using key_type			= typename _Base::key_type;
+	using mapped_type		= typename _Base::mapped_type;
+	using hasher			= typename _Base::hasher;
+	using key_compare		= typename _Base::key_compare;
+	using value_type		= typename _Base::value_type;
+	using reference			= typename _Base::reference;
+	using const_reference	= typename _Base::const_reference;
+	using pointer			= typename _Base::pointer;
+	using const_pointer		= typename _Base::const_pointer;
+	using allocator_type	= typename _Base::allocator_type;
+
+	using iterator			= typename _Base::iterator;
+	using const_iterator	= typename _Base::const_iterator;
+
+public:
+	// Constructors
+
+	flat_hash_set()
+		:_Base() { /*Empty*/ }
+
+	flat_hash_set(const size_t slots)
+		:_Base(slots) { /*Empty*/ }
+
+	flat_hash_set(std::initializer_list<value_type> list)
+		:_Base(list) { /*Empty*/ }
+
+	flat_hash_set(const flat_hash_set& other)
+		:_Base(other) { /*Empty*/ }
+
+	flat_hash_set(flat_hash_set&& other) noexcept
+		:_Base(custom::move(other)) { /*Empty*/ }
+
+	~flat_hash_set() = default;
+
+public:
+	// Operators
+
+	flat_hash_set& operator=(const flat_hash_set& other) {
+		_Base::operator=(other);
+		return *this;
+	}
+
+	flat_hash_set& operator=(flat_hash_set&& other) noexcept {
+		_Base::operator=(custom::move(other));
+		return *this;
+	}
+}; // END flat_hash_set Template
+
+CUSTOM_END
\ No newline at end of file
@@ -0,0 +1,694 @@
+#pragma once
+#include "x_flat_tree.h"
+
+
+CUSTOM_BEGIN
+
+template<class KeyContainer, class MappedContainer>
+class _Flat_Map_Const_Iterator
+{
+public:
+	using iterator_category	= random_access_iterator_tag;
+	using value_type		= pair<typename KeyContainer::value_type, typename MappedContainer::value_type>;
+	using difference_type	= ptrdiff_t;
+	using reference			= pair<const typename KeyContainer::value_type&, const typename MappedContainer::value_type&>;
+	using pointer			= detail::_Flat_Arrow_Proxy<reference>;
+
+	const KeyContainer* _Keys			= nullptr;
+	const MappedContainer* _Values		= nullptr;
+	size_t _Index						= 0;			// same position in both containers
+
+public:
+
+	_Flat_Map_Const_Iterator() noexcept = default;
+
+	explicit _Flat_Map_Const_Iterator(const size_t index, const KeyContainer* keys, const MappedContainer* values) noexcept
+		:_Keys(keys), _Values(values), _Index(index) { /*Empty*/ }
+
+	_Flat_Map_Const_Iterator& operator++() noexcept {
+		CUSTOM_ASSERT(_Index < _Keys->size(), "Cannot increment end iterator.");
+		++_Index;
+		return *this;
+	}
+
+	_Flat_Map_Const_Iterator operator++(int) noexcept {
+		_Flat_Map_Const_Iterator temp = *this;
+		++(*this);
+		return temp;
+	}
+
+	_Flat_Map_Const_Iterator& operator+=(const difference_type diff) noexcept {
+		CUSTOM_ASSERT(_Index + diff <= _Keys->size(), "Cannot increment end iterator.");
+		_Index += diff;
+		return *this;
+	}
+
+	_Flat_Map_Const_Iterator operator+(const difference_type diff) const noexcept {
+		_Flat_Map_Const_Iterator temp = *this;
+		temp += diff;
+		return temp;
+	}
+
+	_Flat_Map_Const_Iterator& operator--() noexcept {
+		CUSTOM_ASSERT(_Index > 0, "Cannot decrement begin iterator.");
+		--_Index;
+		return *this;
+	}
+
+	_Flat_Map_Const_Iterator operator--(int) noexcept {
+		_Flat_Map_Const_Iterator temp = *this;
+		--(*this);
+		return temp;
+	}
+
+	_Flat_Map_Const_Iterator& operator-=(const difference_type diff) noexcept {
+		CUSTOM_ASSERT(static_cast<difference_type>(_Index) - diff >= 0, "Cannot decrement begin iterator.");
+		_Index -= diff;
+		return *this;
+	}
+
+	_Flat_Map_Const_Iterator operator-(const difference_type diff) const noexcept {
+		_Flat_Map_Const_Iterator temp = *this;
+		temp -= diff;
+		return temp;
+	}
+
+	difference_type operator-(const _Flat_Map_Const_Iterator& other) const noexcept {
+		return static_cast<difference_type>(_Index - other._Index);
+	}
+
+	pointer operator->() const noexcept {
+		return pointer{**this};
+	}
+
+	reference operator*() const noexcept {
+		CUSTOM_ASSERT(_Index < _Keys->size(), "Cannot dereference end iterator.");
+		return reference((*_Keys)[_Index], (*_Values)[_Index]);
+	}
+
+	reference operator[](const difference_type diff) const noexcept {
+		return *(*this + diff);
+	}
+
+	bool operator==(const _Flat_Map_Const_Iterator& other) const noexcept {
+		return _Index == other._Index;
+	}
+
+	bool operator!=(const _Flat_Map_Const_Iterator& other) const noexcept {
+		return !(*this == other);
+	}
+
+	bool operator<(const _Flat_Map_Const_Iterator& other) const noexcept {
+		return _Index < other._Index;
+	}
+
+	bool operator>(const _Flat_Map_Const_Iterator& other) const noexcept {
+		return other < *this;
+	}
+
+	bool operator<=(const _Flat_Map_Const_Iterator& other) const noexcept {
+		return !(other < *this);
+	}
+
+	bool operator>=(const _Flat_Map_Const_Iterator& other) const noexcept {
+		return !(*this < other);
+	}
+
+public:
+
+	size_t get_index() const noexcept {								// Get the position for the element in containers from iterator
+		return _Index;
+	}
+
+	friend void _verify_range(const _Flat_Map_Const_Iterator& first, const _Flat_Map_Const_Iterator& last) noexcept {
+		CUSTOM_ASSERT(first._Keys == last._Keys, "flat_map iterators in range are from different containers");
+		CUSTOM_ASSERT(first._Index <= last._Index, "flat_map iterator range transposed");
+	}
+}; // END _Flat_Map_Const_Iterator
+
+template<class KeyContainer, class MappedContainer>
+class _Flat_Map_Iterator : public _Flat_Map_Const_Iterator<KeyContainer, MappedContainer>		// flat_map iterator
+{
+private:
+	using _Base				= _Flat_Map_Const_Iterator<KeyContainer, MappedContainer>;
+
+public:
+	using iterator_category	= random_access_iterator_tag;
+	using value_type		= typename _Base::value_type;
+	using difference_type	= typename _Base::difference_type;
+	using reference			= pair<const typename KeyContainer::value_type&, typename MappedContainer::value_type&>;		// only values can be changed
+	using pointer			= detail::_Flat_Arrow_Proxy<reference>;
+
+public:
+
+	_Flat_Map_Iterator() noexcept = default;
+
+	explicit _Flat_Map_Iterator(const size_t index, const KeyContainer* keys, const MappedContainer* values) noexcept
+		:_Base(index, keys, values) { /*Empty*/ }
+
+	_Flat_Map_Iterator& operator++() noexcept {
+		_Base::operator++();
+		return *this;
+	}
+
+	_Flat_Map_Iterator operator++(int) noexcept {
+		_Flat_Map_Iterator temp = *this;
+		_Base::operator++();
+		return temp;
+	}
+
+	_Flat_Map_Iterator& operator+=(const difference_type diff) noexcept {
+		_Base::operator+=(diff);
+		return *this;
+	}
+
+	_Flat_Map_Iterator operator+(const difference_type diff) const noexcept {
+		_Flat_Map_Iterator temp = *this;
+		temp += diff;
+		return temp;
+	}
+
+	_Flat_Map_Iterator& operator--() noexcept {
+		_Base::operator--();
+		return *this;
+	}
+
+	_Flat_Map_Iterator operator--(int) noexcept {
+		_Flat_Map_Iterator temp = *this;
+		_Base::operator--();
+		return temp;
+	}
+
+	_Flat_Map_Iterator& operator-=(const difference_type diff) noexcept {
+		_Base::operator-=(diff);
+		return *this;
+	}
+
+	_Flat_Map_Iterator operator-(const difference_type diff) const noexcept {
+		_Flat_Map_Iterator temp = *this;
+		temp -= diff;
+		return temp;
+	}
+
+	using _Base::operator-;								// iterator difference
+
+	pointer operator->() const noexcept {
+		return pointer{**this};
+	}
+
+	reference operator*() const noexcept {
+		CUSTOM_ASSERT(this->_Index < this->_Keys->size(), "Cannot dereference end iterator.");
+		return reference((*this->_Keys)[this->_Index], const_cast<MappedContainer&>(*this->_Values)[this->_Index]);
+	}
+
+	reference operator[](const difference_type diff) const noexcept {
+		return *(*this + diff);
+	}
+}; // END _Flat_Map_Iterator
+
+
+template<class Key, class Type,
+class Compare 			= custom::less<Key>,
+class KeyContainer		= custom::vector<Key>,
+class MappedContainer	= custom::vector<Type>>
+class flat_map			// flat_map Template implemented as two parallel sorted vectors
+{
+	// Keys and mapped values live in separate containers at the same index, so a key search
+	// walks only dense keys and the values are touched once the position is known.
+	// Single inserts and erases shift both tails, bulk inserts sort once and merge.
+
+public:
+	static_assert(is_same_v<Key, typename KeyContainer::value_type>, "Key type and key container type must be the same!");
+	static_assert(is_same_v<Type, typename MappedContainer::value_type>, "Mapped type and mapped container type must be the same!");
+	static_assert(is_object_v<Key>, "Containers require object type!");
+
+	using key_type					= Key;
+	using mapped_type				= Type;
+	using key_compare				= Compare;
+	using value_type				= pair<Key, Type>;
+	using key_container_type		= KeyContainer;
+	using mapped_container_type		= MappedContainer;
+	using difference_type			= ptrdiff_t;
+
+	using iterator					= _Flat_Map_Iterator<KeyContainer, MappedContainer>;
+	using const_iterator			= _Flat_Map_Const_Iterator<KeyContainer, MappedContainer>;
+	using reverse_iterator			= custom::reverse_iterator<iterator>;
+	using const_reverse_iterator	= custom::reverse_iterator<const_iterator>;
+
+	using reference					= typename iterator::reference;
+	using const_reference			= typename const_iterator::reference;
+
+	template<class KeyType>
+	using _Enable_Transparent		= enable_if_t<conjunction_v<			// heterogeneous lookup when key_compare allows it
+													_Is_Transparent<key_compare>,
+													negation<is_convertible<KeyType, const_iterator>>>,
+										bool>;
+
+private:
+	key_container_type _keys;
+	mapped_container_type _values;
+	key_compare _less;			// Used for comparison
+
+public:
+	// Constructors
+
+	flat_map() = default;
+
+	flat_map(std::initializer_list<value_type> list) {
+		insert(list.begin(), list.end());
+	}
+
+	template<class Iter, enable_if_t<is_iterator_v<Iter>, bool> = true>
+	flat_map(Iter first, Iter last) {
+		insert(first, last);
+	}
+
+	template<class Iter, enable_if_t<is_iterator_v<Iter>, bool> = true>
+	flat_map(sorted_unique_t, Iter first, Iter last) {
+		insert(sorted_unique, first, last);
+	}
+
+	flat_map(sorted_unique_t, key_container_type keys, mapped_container_type values)		// keys must be sorted and unique
+		: _keys(custom::move(keys)), _values(custom::move(values)) {
+		CUSTOM_ASSERT(_keys.size() == _values.size(), "flat_map key and value containers differ in size.");
+	}
+
+	flat_map(const flat_map& other) = default;
+
+	flat_map(flat_map&& other) noexcept = default;
+
+	~flat_map() = default;
+
+public:
+	// Operators
+
+	mapped_type& operator[](const key_type& key) {				// Access value or create new one with key and assignment (no const)
+		return try_emplace(key).first->second;
+	}
+
+	mapped_type& operator[](key_type&& key) {
+		return try_emplace(custom::move(key)).first->second;
+	}
+
+	flat_map& operator=(const flat_map& other) = default;
+
+	flat_map& operator=(flat_map&& other) noexcept = default;
+
+public:
+	// Main functions
+
+	template<class... Args>
+	pair<iterator, bool> emplace(Args&&... args) {						// Constructs the value first, then moves it into place
+		value_type value(custom::forward<Args>(args)...);
+		return try_emplace(custom::move(value.first), custom::move(value.second));
+	}
+
+	pair<iterator, bool> insert(const value_type& copyValue) {
+		return try_emplace(copyValue.first, copyValue.second);
+	}
+
+	pair<iterator, bool> insert(value_type&& moveValue) {
+		return try_emplace(custom::move(moveValue.first), custom::move(moveValue.second));
+	}
+
+	template<class Iter, enable_if_t<is_iterator_v<Iter>, bool> = true>
+	void insert(Iter first, Iter last) {								// Sort and dedup the new elements once, then merge them in one pass
+		vector<value_type> staged;
+		for (/*Empty*/; first != last; ++first)
+			staged.emplace_back((*first).first, (*first).second);
+
+		detail::_flat_sort_unique(staged, [this](const value_type& left, const value_type& right) { return _less(left.first, right.first); });
+		_merge_sorted_unique<true>(staged.begin(), staged.end());
+	}
+
+	template<class Iter, enable_if_t<is_iterator_v<Iter>, bool> = true>
+	void insert(sorted_unique_t, Iter first, Iter last) {				// Range is sorted and unique, merge it directly
+		_merge_sorted_unique<false>(first, last);
+	}
+
+	void insert(std::initializer_list<value_type> list) {
+		insert(list.begin(), list.end());
+	}
+
+	template<class... Args>
+	pair<iterator, bool> try_emplace(const key_type& key, Args&&... args) {	// Force construction with known key and given arguments for object
+		return _try_emplace(key, custom::forward<Args>(args)...);
+	}
+
+	template<class... Args>
+	pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+		return _try_emplace(custom::move(key), custom::forward<Args>(args)...);
+	}
+
+	template<class ValueType>
+	pair<iterator, bool> insert_or_assign(const key_type& key, ValueType&& value) {
+		pair<iterator, bool> result = _try_emplace(key, custom::forward<ValueType>(value));
+		if (!result.second)
+			result.first->second = custom::forward<ValueType>(value);
+
+		return result;
+	}
+
+	size_t erase(const key_type& key) {
+		return _erase(key);
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	size_t erase(const KeyType& key) {
+		return _erase(key);
+	}
+
+	iterator erase(const_iterator where) {
+		if (where == end())
+			throw std::out_of_range("flat_map erase iterator outside range.");
+
+		_erase_at(where.get_index());
+		return _make_iter(where.get_index());
+	}
+
+	const mapped_type& at(const key_type& key) const {			// Access _Value at key with check
+		return _values[_at_index(key)];
+	}
+
+	mapped_type& at(const key_type& key) {
+		return _values[_at_index(key)];
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	const mapped_type& at(const KeyType& key) const {
+		return _values[_at_index(key)];
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	mapped_type& at(const KeyType& key) {
+		return _values[_at_index(key)];
+	}
+
+	const_iterator find(const key_type& key) const {
+		return _make_const_iter(_find_index(key));
+	}
+
+	iterator find(const key_type& key) {
+		return _make_iter(_find_index(key));
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	const_iterator find(const KeyType& key) const {
+		return _make_const_iter(_find_index(key));
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	iterator find(const KeyType& key) {
+		return _make_iter(_find_index(key));
+	}
+
+	bool contains(const key_type& key) const {
+		return _find_index(key) != size();
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	bool contains(const KeyType& key) const {
+		return _find_index(key) != size();
+	}
+
+	size_t count(const key_type& key) const {
+		return contains(key) ? 1 : 0;
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	size_t count(const KeyType& key) const {
+		return contains(key) ? 1 : 0;
+	}
+
+	const_iterator lower_bound(const key_type& key) const {				// First value not less than key
+		return _make_const_iter(_lower_index(key));
+	}
+
+	iterator lower_bound(const key_type& key) {
+		return _make_iter(_lower_index(key));
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	const_iterator lower_bound(const KeyType& key) const {
+		return _make_const_iter(_lower_index(key));
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	iterator lower_bound(const KeyType& key) {
+		return _make_iter(_lower_index(key));
+	}
+
+	const_iterator upper_bound(const key_type& key) const {				// First value greater than key
+		return _make_const_iter(_upper_index(key));
+	}
+
+	iterator upper_bound(const key_type& key) {
+		return _make_iter(_upper_index(key));
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	const_iterator upper_bound(const KeyType& key) const {
+		return _make_const_iter(_upper_index(key));
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	iterator upper_bound(const KeyType& key) {
+		return _make_iter(_upper_index(key));
+	}
+
+	pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+		const size_t index = _lower_index(key);
+		return {_make_const_iter(index), _make_const_iter((index != size() && !_less(key, _keys[index])) ? index + 1 : index)};
+	}
+
+	pair<iterator, iterator> equal_range(const key_type& key) {
+		const size_t index = _lower_index(key);
+		return {_make_iter(index), _make_iter((index != size() && !_less(key, _keys[index])) ? index + 1 : index)};
+	}
+
+	void reserve(const size_t newCapacity) {
+		_keys.reserve(newCapacity);
+		_values.reserve(newCapacity);
+	}
+
+	void clear() {
+		_keys.clear();
+		_values.clear();
+	}
+
+	size_t size() const noexcept {
+		return _keys.size();
+	}
+
+	size_t max_size() const noexcept {
+		return _keys.max_size() < _values.max_size() ? _keys.max_size() : _values.max_size();
+	}
+
+	bool empty() const noexcept {
+		return _keys.empty();
+	}
+
+	const key_container_type& keys() const noexcept {
+		return _keys;
+	}
+
+	const mapped_container_type& values() const noexcept {
+		return _values;
+	}
+
+	key_compare key_comp() const {
+		return _less;
+	}
+
+public:
+	// iterator functions
+
+	iterator begin() noexcept {
+		return _make_iter(0);
+	}
+
+	const_iterator begin() const noexcept {
+		return _make_const_iter(0);
+	}
+
+	reverse_iterator rbegin() noexcept {
+		return reverse_iterator(end());
+	}
+
+	const_reverse_iterator rbegin() const noexcept {
+		return const_reverse_iterator(end());
+	}
+
+	iterator end() noexcept {
+		return _make_iter(size());
+	}
+
+	const_iterator end() const noexcept {
+		return _make_const_iter(size());
+	}
+
+	reverse_iterator rend() noexcept {
+		return reverse_iterator(begin());
+	}
+
+	const_reverse_iterator rend() const noexcept {
+		return const_reverse_iterator(begin());
+	}
+
+private:
+	// Helpers
+
+	iterator _make_iter(const size_t index) noexcept {
+		return iterator(index, &_keys, &_values);
+	}
+
+	const_iterator _make_const_iter(const size_t index) const noexcept {
+		return const_iterator(index, &_keys, &_values);
+	}
+
+	template<class KeyType>
+	size_t _lower_index(const KeyType& key) const {						// branchless search over the keys only
+		return static_cast<size_t>(custom::lower_bound(_keys.begin(), _keys.end(), key, _less) - _keys.begin());
+	}
+
+	template<class KeyType>
+	size_t _upper_index(const KeyType& key) const {
+		return static_cast<size_t>(custom::upper_bound(_keys.begin(), _keys.end(), key, _less) - _keys.begin());
+	}
+
+	template<class KeyType>
+	size_t _find_index(const KeyType& key) const {						// index of key, or size() if missing
+		const size_t index = _lower_index(key);
+		return (index != size() && !_less(key, _keys[index])) ? index : size();
+	}
+
+	template<class KeyType>
+	size_t _at_index(const KeyType& key) const {
+		const size_t index = _find_index(key);
+		if (index == size())
+			throw std::out_of_range("Invalid key.");
+
+		return index;
+	}
+
+	template<class _KeyType, class... Args>
+	pair<iterator, bool> _try_emplace(_KeyType&& key, Args&&... args) {
+		const size_t index = _lower_index(key);
+		if (index != size() && !_less(key, _keys[index]))
+			return {_make_iter(index), false};
+
+		_keys.emplace(_keys.begin() + static_cast<difference_type>(index), custom::forward<_KeyType>(key));
+
+		try
+		{
+			_values.emplace(_values.begin() + static_cast<difference_type>(index), custom::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			_keys.erase(_keys.begin() + static_cast<difference_type>(index));		// keep both containers the same size
+			CUSTOM_RERAISE;
+		}
+
+		return {_make_iter(index), true};
+	}
+
+	template<class KeyType>
+	size_t _erase(const KeyType& key) {
+		const size_t index = _find_index(key);
+		if (index == size())
+			return 0;
+
+		_erase_at(index);
+		return 1;
+	}
+
+	void _erase_at(const size_t index) {
+		_keys.erase(_keys.begin() + static_cast<difference_type>(index));
+		_values.erase(_values.begin() + static_cast<difference_type>(index));
+	}
+
+	template<bool Move, class Iter>
+	void _merge_sorted_unique(Iter first, Iter last) {					// Existing elements win over equivalent new ones
+		if (first == last)
+			return;
+
+		if (empty() || _less(_keys.back(), (*first).first))				// everything goes after the back, no rebuild
+		{
+			reserve(size() + _count_hint(first, last));
+			for (/*Empty*/; first != last; ++first)
+				_append(_keys, _values, *first, bool_constant<Move>{});
+
+			return;
+		}
+
+		key_container_type mergedKeys;
+		mapped_container_type mergedValues;
+		const size_t newCapacity = size() + _count_hint(first, last);
+		mergedKeys.reserve(newCapacity);
+		mergedValues.reserve(newCapacity);
+
+		size_t index = 0;
+		while (index < size() && first != last)
+		{
+			if (_less(_keys[index], (*first).first))
+				_take_existing(mergedKeys, mergedValues, index++);
+			else if (_less((*first).first, _keys[index]))
+				_append(mergedKeys, mergedValues, *first++, bool_constant<Move>{});
+			else																// equivalent, keep the existing element
+			{
+				_take_existing(mergedKeys, mergedValues, index++);
+				++first;
+			}
+		}
+
+		for (/*Empty*/; index < size(); ++index)
+			_take_existing(mergedKeys, mergedValues, index);
+
+		for (/*Empty*/; first != last; ++first)
+			_append(mergedKeys, mergedValues, *first, bool_constant<Move>{});
+
+		_keys	= custom::move(mergedKeys);
+		_values	= custom::move(mergedValues);
+	}
+
+	void _take_existing(key_container_type& keys, mapped_container_type& values, const size_t index) {
+		keys.emplace_back(custom::move(_keys[index]));
+		values.emplace_back(custom::move(_values[index]));
+	}
+
+	template<class ValueType>
+	static void _append(key_container_type& keys, mapped_container_type& values, ValueType&& value, true_type) {
+		keys.emplace_back(custom::move(value.first));
+		values.emplace_back(custom::move(value.second));
+	}
+
+	template<class ValueType>
+	static void _append(key_container_type& keys, mapped_container_type& values, ValueType&& value, false_type) {
+		keys.emplace_back(value.first);
+		values.emplace_back(value.second);
+	}
+
+	template<class Iter>
+	static size_t _count_hint(Iter first, Iter last) {					// size of forward ranges, 0 for single pass ones
+		if constexpr (is_forward_iterator_v<Iter>)
+			return static_cast<size_t>(custom::distance(first, last));
+		else
+			return 0;
+	}
+}; // END flat_map Template
+
+
+// flat_map binary operators
+template<class Key, class Type, class Compare, class KeyContainer, class MappedContainer>
+bool operator==(const flat_map<Key, Type, Compare, KeyContainer, MappedContainer>& left,
+				const flat_map<Key, Type, Compare, KeyContainer, MappedContainer>& right) {
+	return left.keys() == right.keys() && left.values() == right.values();
+}
+
+template<class Key, class Type, class Compare, class KeyContainer, class MappedContainer>
+bool operator!=(const flat_map<Key, Type, Compare, KeyContainer, MappedContainer>& left,
+				const flat_map<Key, Type, Compare, KeyContainer, MappedContainer>& right) {
+	return !(left == right);
+}
+
+CUSTOM_END
\ No newline at end of file
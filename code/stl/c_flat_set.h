@@ -0,0 +1,345 @@
+#pragma once
+#include "x_flat_tree.h"
+
+
+CUSTOM_BEGIN
+
+template<class Key,
+class Compare 		= custom::less<Key>,
+class KeyContainer	= custom::vector<Key>>
+class flat_set			// flat_set Template implemented as sorted vector
+{
+	// Keys are kept sorted in one contiguous container, so lookups are a binary search over dense memory
+	// and iteration is a linear scan. Single inserts and erases shift the tail, bulk inserts sort once and merge.
+
+public:
+	static_assert(is_same_v<Key, typename KeyContainer::value_type>, "Object type and container type must be the same!");
+	static_assert(is_object_v<Key>, "Containers require object type!");
+
+	using key_type					= Key;
+	using value_type				= Key;
+	using key_compare				= Compare;
+	using value_compare				= Compare;
+	using container_type			= KeyContainer;
+	using difference_type			= ptrdiff_t;
+	using reference					= value_type&;
+	using const_reference			= const value_type&;
+
+	using iterator					= typename KeyContainer::const_iterator;		// elements can't be changed
+	using const_iterator			= iterator;
+	using reverse_iterator			= custom::reverse_iterator<iterator>;
+	using const_reverse_iterator	= reverse_iterator;
+
+	template<class KeyType>
+	using _Enable_Transparent		= enable_if_t<conjunction_v<			// heterogeneous lookup when key_compare allows it
+													_Is_Transparent<key_compare>,
+													negation<is_convertible<KeyType, const_iterator>>>,
+										bool>;
+
+private:
+	container_type _keys;
+	key_compare _less;			// Used for comparison
+
+public:
+	// Constructors
+
+	flat_set() = default;
+
+	flat_set(std::initializer_list<value_type> list) {
+		insert(list.begin(), list.end());
+	}
+
+	template<class Iter, enable_if_t<is_iterator_v<Iter>, bool> = true>
+	flat_set(Iter first, Iter last) {
+		insert(first, last);
+	}
+
+	template<class Iter, enable_if_t<is_iterator_v<Iter>, bool> = true>
+	flat_set(sorted_unique_t, Iter first, Iter last) {
+		insert(sorted_unique, first, last);
+	}
+
+	explicit flat_set(container_type keys)
+		: _keys(custom::move(keys)) {
+		detail::_flat_sort_unique(_keys, _less);
+	}
+
+	flat_set(sorted_unique_t, container_type keys)
+		: _keys(custom::move(keys)) { /*Empty*/ }
+
+	flat_set(const flat_set& other) = default;
+
+	flat_set(flat_set&& other) noexcept = default;
+
+	~flat_set() = default;
+
+public:
+	// Operators
+
+	flat_set& operator=(const flat_set& other) = default;
+
+	flat_set& operator=(flat_set&& other) noexcept = default;
+
+public:
+	// Main functions
+
+	template<class... Args>
+	pair<iterator, bool> emplace(Args&&... args) {						// Constructs the value first, then moves it into place
+		value_type value(custom::forward<Args>(args)...);
+		return _insert(custom::move(value));
+	}
+
+	pair<iterator, bool> insert(const value_type& copyValue) {
+		return _insert(copyValue);
+	}
+
+	pair<iterator, bool> insert(value_type&& moveValue) {
+		return _insert(custom::move(moveValue));
+	}
+
+	template<class Iter, enable_if_t<is_iterator_v<Iter>, bool> = true>
+	void insert(Iter first, Iter last) {								// Sort and dedup the new keys once, then merge them in one pass
+		container_type staged;
+		for (/*Empty*/; first != last; ++first)
+			staged.emplace_back(*first);
+
+		detail::_flat_sort_unique(staged, _less);
+		_merge_sorted_unique<true>(staged.begin(), staged.end());
+	}
+
+	template<class Iter, enable_if_t<is_iterator_v<Iter>, bool> = true>
+	void insert(sorted_unique_t, Iter first, Iter last) {				// Range is sorted and unique, merge it directly
+		_merge_sorted_unique<false>(first, last);
+	}
+
+	void insert(std::initializer_list<value_type> list) {
+		insert(list.begin(), list.end());
+	}
+
+	size_t erase(const key_type& key) {
+		return _erase(key);
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	size_t erase(const KeyType& key) {
+		return _erase(key);
+	}
+
+	iterator erase(const_iterator where) {
+		if (where == end())
+			throw std::out_of_range("flat_set erase iterator outside range.");
+
+		return _keys.erase(where);
+	}
+
+	const_iterator find(const key_type& key) const {
+		return _keys.begin() + static_cast<difference_type>(_find_index(key));
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	const_iterator find(const KeyType& key) const {
+		return _keys.begin() + static_cast<difference_type>(_find_index(key));
+	}
+
+	bool contains(const key_type& key) const {
+		return _find_index(key) != size();
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	bool contains(const KeyType& key) const {
+		return _find_index(key) != size();
+	}
+
+	size_t count(const key_type& key) const {
+		return contains(key) ? 1 : 0;
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	size_t count(const KeyType& key) const {
+		return contains(key) ? 1 : 0;
+	}
+
+	const_iterator lower_bound(const key_type& key) const {				// First value not less than key
+		return custom::lower_bound(_keys.begin(), _keys.end(), key, _less);
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	const_iterator lower_bound(const KeyType& key) const {
+		return custom::lower_bound(_keys.begin(), _keys.end(), key, _less);
+	}
+
+	const_iterator upper_bound(const key_type& key) const {				// First value greater than key
+		return custom::upper_bound(_keys.begin(), _keys.end(), key, _less);
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	const_iterator upper_bound(const KeyType& key) const {
+		return custom::upper_bound(_keys.begin(), _keys.end(), key, _less);
+	}
+
+	pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+		const_iterator first = lower_bound(key);
+		return {first, (first != end() && !_less(key, *first)) ? first + 1 : first};
+	}
+
+	void reserve(const size_t newCapacity) {
+		_keys.reserve(newCapacity);
+	}
+
+	void clear() {
+		_keys.clear();
+	}
+
+	size_t size() const noexcept {
+		return _keys.size();
+	}
+
+	size_t max_size() const noexcept {
+		return _keys.max_size();
+	}
+
+	bool empty() const noexcept {
+		return _keys.empty();
+	}
+
+	const container_type& keys() const noexcept {
+		return _keys;
+	}
+
+	container_type extract() && {										// Take the sorted keys and leave the set empty
+		container_type keys = custom::move(_keys);
+		_keys.clear();
+		return keys;
+	}
+
+	void replace(container_type&& keys) {								// keys must be sorted and unique
+		_keys = custom::move(keys);
+	}
+
+	key_compare key_comp() const {
+		return _less;
+	}
+
+	value_compare value_comp() const {
+		return _less;
+	}
+
+public:
+	// iterator functions
+
+	const_iterator begin() const noexcept {
+		return _keys.begin();
+	}
+
+	const_iterator end() const noexcept {
+		return _keys.end();
+	}
+
+	const_reverse_iterator rbegin() const noexcept {
+		return const_reverse_iterator(end());
+	}
+
+	const_reverse_iterator rend() const noexcept {
+		return const_reverse_iterator(begin());
+	}
+
+private:
+	// Helpers
+
+	template<class KeyType>
+	size_t _find_index(const KeyType& key) const {						// index of key, or size() if missing
+		const size_t index = static_cast<size_t>(custom::lower_bound(_keys.begin(), _keys.end(), key, _less) - _keys.begin());
+		return (index != size() && !_less(key, _keys[index])) ? index : size();
+	}
+
+	template<class ValueType>
+	pair<iterator, bool> _insert(ValueType&& value) {
+		const_iterator where = lower_bound(value);
+		if (where != end() && !_less(value, *where))
+			return {where, false};
+
+		return {_keys.emplace(where, custom::forward<ValueType>(value)), true};
+	}
+
+	template<class KeyType>
+	size_t _erase(const KeyType& key) {
+		const size_t index = _find_index(key);
+		if (index == size())
+			return 0;
+
+		_keys.erase(_keys.begin() + static_cast<difference_type>(index));
+		return 1;
+	}
+
+	template<bool Move, class Iter>
+	void _merge_sorted_unique(Iter first, Iter last) {					// Existing keys win over equivalent new ones
+		if (first == last)
+			return;
+
+		if (empty() || _less(_keys.back(), *first))						// everything goes after the back, no rebuild
+		{
+			_keys.reserve(size() + _count_hint(first, last));
+			for (/*Empty*/; first != last; ++first)
+				_append(_keys, *first, bool_constant<Move>{});
+
+			return;
+		}
+
+		container_type merged;
+		merged.reserve(size() + _count_hint(first, last));
+
+		size_t index = 0;
+		while (index < size() && first != last)
+		{
+			if (_less(_keys[index], *first))
+				merged.emplace_back(custom::move(_keys[index++]));
+			else if (_less(*first, _keys[index]))
+				_append(merged, *first++, bool_constant<Move>{});
+			else																// equivalent, keep the existing key
+			{
+				merged.emplace_back(custom::move(_keys[index++]));
+				++first;
+			}
+		}
+
+		for (/*Empty*/; index < size(); ++index)
+			merged.emplace_back(custom::move(_keys[index]));
+
+		for (/*Empty*/; first != last; ++first)
+			_append(merged, *first, bool_constant<Move>{});
+
+		_keys = custom::move(merged);
+	}
+
+	template<class ValueType>
+	static void _append(container_type& dest, ValueType&& value, true_type) {
+		dest.emplace_back(custom::move(value));
+	}
+
+	template<class ValueType>
+	static void _append(container_type& dest, ValueType&& value, false_type) {
+		dest.emplace_back(custom::forward<ValueType>(value));
+	}
+
+	template<class Iter>
+	static size_t _count_hint(Iter first, Iter last) {					// size of forward ranges, 0 for single pass ones
+		if constexpr (is_forward_iterator_v<Iter>)
+			return static_cast<size_t>(custom::distance(first, last));
+		else
+			return 0;
+	}
+}; // END flat_set Template
+
+
+// flat_set binary operators
+template<class Key, class Compare, class KeyContainer>
+bool operator==(const flat_set<Key, Compare, KeyContainer>& left, const flat_set<Key, Compare, KeyContainer>& right) {
+	return left.keys() == right.keys();
+}
+
+template<class Key, class Compare, class KeyContainer>
+bool operator!=(const flat_set<Key, Compare, KeyContainer>& left, const flat_set<Key, Compare, KeyContainer>& right) {
+	return !(left == right);
+}
+
+CUSTOM_END
\ No newline at end of file
@@ -0,0 +1,95 @@
+#pragma once
+#include "x_frozen_hash_table.h"
+
+
+CUSTOM_BEGIN
+
+template<class Key, class Type, class Hash, class Compare>
+class _Frozen_Map_Traits		// frozen_map Traits
+{
+public:
+	using key_type			= Key;
+	using mapped_type		= Type;
+	using hasher			= Hash;
+	using key_compare		= Compare;
+	using value_type		= pair<Key, Type>;
+
+public:
+
+	constexpr _Frozen_Map_Traits() = default;
+
+	static constexpr const key_type& extract_key(const value_type& value) noexcept {		// extract key from element value
+		return value.first;
+	}
+
+	static constexpr const mapped_type& extract_mapval(const value_type& value) noexcept {	// extract mapped val from element value
+		return value.second;
+	}
+}; // END frozen_map Traits
+
+
+template<class Key, class Type, size_t Size,
+class Hash 		= custom::frozen_hash<Key>,
+class Compare 	= custom::equal_to<Key>>
+class frozen_map : public detail::_Frozen_Hash_Table<_Frozen_Map_Traits<Key, Type, Hash, Compare>, Size>	// frozen_map Template
+{
+private:
+	using _Base = detail::_Frozen_Hash_Table<_Frozen_Map_Traits<Key, Type, Hash, Compare>, Size>;
+
+public:
+	static_assert(is_object_v<Key>, "Containers require object type!");
+
+	using key_type 			= typename _Base::key_type;
+	using mapped_type 		= typename _Base::mapped_type;
+	using hasher 			= typename _Base::hasher;
+	using key_compare		= typename _Base::key_compare;
+	using value_type 		= typename _Base::value_type;
+	using reference 		= typename _Base::reference;
+	using const_reference 	= typename _Base::const_reference;
+	using pointer 			= typename _Base::pointer;
+	using const_pointer 	= typename _Base::const_pointer;
+
+	using iterator 			= typename _Base::iterator;
+	using const_iterator 	= typename _Base::const_iterator;
+
+public:
+	// Constructors
+
+	constexpr frozen_map(const array<value_type, Size>& values)
+		: _Base(values) { /*Empty*/ }
+
+public:
+	// Operators
+
+	constexpr const mapped_type& operator[](const key_type& key) const {		// Access value at key, key must be present
+		const size_t slot = _Base::_slot_of(key);
+		CUSTOM_ASSERT(slot != Size, "Invalid key.");
+
+		return _Base::begin()[static_cast<ptrdiff_t>(slot)].second;
+	}
+
+public:
+	// Main functions
+
+	constexpr const mapped_type& at(const key_type& key) const {				// Access value at key with check
+		const size_t slot = _Base::_slot_of(key);
+		if (slot == Size)
+			throw std::out_of_range("Invalid key.");
+
+		return _Base::begin()[static_cast<ptrdiff_t>(slot)].second;
+	}
+}; // END frozen_map Template
+
+
+// make frozen_map (ex: constexpr auto fields = custom::make_frozen_map<custom::string_view, int>({{"GET", 1}, {"PUT", 2}});)
+template<class Key, class Type, size_t Size>
+constexpr frozen_map<Key, Type, Size> make_frozen_map(const array<pair<Key, Type>, Size>& values) {
+	return frozen_map<Key, Type, Size>(values);
+}
+
+template<class Key, class Type, size_t Size>
+constexpr frozen_map<Key, Type, Size> make_frozen_map(const pair<Key, Type> (&values)[Size]) {
+	return frozen_map<Key, Type, Size>(custom::to_array(values));
+}
+
+CUSTOM_END
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+#include "x_frozen_hash_table.h"
+
+
+CUSTOM_BEGIN
+
+template<class Key, class Hash, class Compare>
+class _Frozen_Set_Traits		// frozen_set Traits
+{
+public:
+	using key_type			= Key;
+	using mapped_type		= Key;
+	using hasher			= Hash;
+	using key_compare		= Compare;
+	using value_type		= mapped_type;
+
+public:
+
+	constexpr _Frozen_Set_Traits() = default;
+
+	static constexpr const key_type& extract_key(const value_type& value) noexcept {		// extract key from element value
+		return value;
+	}
+
+	static constexpr const mapped_type& extract_mapval(const value_type& value) noexcept {	// extract key from element value
+		return value;
+	}
+}; // END frozen_set Traits
+
+
+template<class Key, size_t Size,
+class Hash 		= custom::frozen_hash<Key>,
+class Compare 	= custom::equal_to<Key>>
+class frozen_set : public detail::_Frozen_Hash_Table<_Frozen_Set_Traits<Key, Hash, Compare>, Size>	// frozen_set Template
+{
+private:
+	using _Base = detail::_Frozen_Hash_Table<_Frozen_Set_Traits<Key, Hash, Compare>, Size>;
+
+public:
+	static_assert(is_object_v<Key>, "Containers require object type!");
+
+	using key_type			= typename _Base::key_type;
+	using mapped_type		= typename _Base::mapped_type;
+	using hasher			= typename _Base::hasher;
+	using key_compare		= typename _Base::key_compare;
+	using value_type		= typename _Base::value_type;
+	using reference			= typename _Base::reference;
+	using const_reference	= typename _Base::const_reference;
+	using pointer			= typename _Base::pointer;
+	using const_pointer		= typename _Base::const_pointer;
+
+	using iterator			= typename _Base::iterator;
+	using const_iterator	= typename _Base::const_iterator;
+
+public:
+	// Constructors
+
+	constexpr frozen_set(const array<value_type, Size>& values)
+		: _Base(values) { /*Empty*/ }
+}; // END frozen_set Template
+
+
+// make frozen_set (ex: constexpr auto keywords = custom::make_frozen_set<custom::string_view>({"if", "else", "while"});)
+template<class Key, size_t Size>
+constexpr frozen_set<Key, Size> make_frozen_set(const array<Key, Size>& values) {
+	return frozen_set<Key, Size>(values);
+}
+
+template<class Key, size_t Size>
+constexpr frozen_set<Key, Size> make_frozen_set(const Key (&values)[Size]) {
+	return frozen_set<Key, Size>(custom::to_array(values));
+}
+
+CUSTOM_END
\ No newline at end of file
@@ -290,6 +290,16 @@ struct negate<void>
     using is_transparent = int;
 };
 
+// transparent function object detection (enables heterogeneous lookup in containers)
+template<class Ty, class = void>
+struct _Is_Transparent : false_type {};
+
+template<class Ty>
+struct _Is_Transparent<Ty, void_t<typename Ty::is_transparent>> : true_type {};
+
+template<class Ty>
+constexpr bool _Is_Transparent_v = _Is_Transparent<Ty>::value;
+
 #pragma endregion Unary/Binary Operations
 
 
@@ -16,12 +16,12 @@ class _Hash_Table;
 CUSTOM_DETAIL_END
 
 
-template<class Type, class Alloc>
+template<class Type, class Alloc, class Node = detail::_Double_Node<Type>>
 struct _List_Data
 {
 	// deduce data types and forward them
 	using _Alloc_Traits			= allocator_traits<Alloc>;
-	using _Node					= detail::_Double_Node<Type>;
+	using _Node					= Node;
 	using _Alloc_Node			= typename _Alloc_Traits::template rebind_alloc<_Node>;
 	using _Alloc_Node_Traits	= allocator_traits<_Alloc_Node>;
 	using _NodePtr				= typename _Alloc_Node_Traits::pointer;
@@ -172,14 +172,14 @@ public:
 }; // END _List_Iterator
 
 
-template<class Type, class Alloc = custom::allocator<Type>>
-class list				// Doubly Linked list
+template<class Type, class Alloc = custom::allocator<Type>, class Node = detail::_Double_Node<Type>>
+class list				// Doubly Linked list (Node can carry extra data, see _Hash_Table)
 {
 private:
 	template<class>
 	friend class detail::_Hash_Table;												// Needed in _Hash_Table class
 
-	using _Data 				= _List_Data<Type, Alloc>;					// Members that are modified
+	using _Data 				= _List_Data<Type, Alloc, Node>;					// Members that are modified
 	using _Alloc_Traits			= typename _Data::_Alloc_Traits;
 	using _Node					= typename _Data::_Node;
 	using _Alloc_Node			= typename _Data::_Alloc_Node;
@@ -332,10 +332,10 @@ public:
 			throw std::out_of_range("Cannot erase end iterator.");
 
 		_NodePtr temp 			= where._Ptr;
-		iterator prevIterator 	= iterator(temp->_Previous, &_data);
+		iterator nextIterator 	= iterator(temp->_Next, &_data);
 		_remove_node(temp);
 
-		return prevIterator;
+		return nextIterator;
 	}
 
 	reference front() noexcept {								// Get the value of the first component
@@ -29,11 +29,12 @@ public:
 
 template<class Key, class Type,
 class Compare 	= custom::less<Key>,
-class Alloc		= custom::allocator<custom::pair<Key, Type>>>
-class map : public detail::_Search_Tree<_Map_Traits<Key, Type, Compare, Alloc>>		// map Template
+class Alloc		= custom::allocator<custom::pair<Key, Type>>,
+class Policy	= custom::default_tree_policy>
+class map : public detail::_Search_Tree<_Map_Traits<Key, Type, Compare, Alloc>, Policy>		// map Template
 {
 private:
-	using _Base = detail::_Search_Tree<_Map_Traits<Key, Type, Compare, Alloc>>;
+	using _Base = detail::_Search_Tree<_Map_Traits<Key, Type, Compare, Alloc>, Policy>;
 
 public:
 	using key_type					= typename _Base::key_type;
@@ -51,6 +52,9 @@ public:
 	using reverse_iterator			= typename _Base::reverse_iterator;
 	using const_reverse_iterator	= typename _Base::const_reverse_iterator;
 
+	using node_type					= typename _Base::node_type;
+	using insert_return_type		= typename _Base::insert_return_type;
+
 public:
 	// Constructors
 
@@ -60,6 +64,10 @@ public:
 	map(std::initializer_list<value_type> list)
 		:_Base(list) { /*Empty*/ }
 
+	template<class Iter, enable_if_t<is_iterator_v<Iter>, bool> = true>
+	map(Iter first, Iter last)
+		:_Base(first, last) { /*Empty*/ }
+
 	map(const map& other)
 		:_Base(other) { /*Empty*/ }
 
@@ -390,6 +390,10 @@ public:
 
 }; // END unique_ptr[]
 
+template<class Type, class Deleter>
+struct is_trivially_relocatable<unique_ptr<Type, Deleter>>     // the pointer can be moved as raw bytes
+    : is_trivially_relocatable<Deleter> {};
+
 
 // build unique_ptr
 template<class Ty, class... Args, enable_if_t<!is_array_v<Ty>, bool> = true>
@@ -22,8 +22,14 @@ template<class InputIt, class Type, class BinaryOperation>
 constexpr Type accumulate(InputIt first, InputIt last, Type init, BinaryOperation op) {
     _verify_iteration_range(first, last);
 
-    for (/*Empty*/; first != last; ++first)
-        init = op(custom::move(init), *first);
+    if constexpr (_Is_Segmented_Iterator_v<InputIt>)       // one pointer loop per block
+        _for_each_segment(first, last, [&init, &op](auto segFirst, auto segLast) {
+            init = custom::accumulate(segFirst, segLast, custom::move(init), op);
+            return segLast;
+        });
+    else
+        for (/*Empty*/; first != last; ++first)
+            init = op(custom::move(init), *first);
  
     return init;
 }
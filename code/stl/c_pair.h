@@ -33,10 +33,11 @@ public:
     // Constructors
 
     // (0) Default constructor
-    template<enable_if_t<conjunction_v< is_default_constructible<Type1>,
-                                        is_default_constructible<Type2>>, bool> = true>
-    constexpr explicit(!conjunction_v<  is_implicitly_default_constructible<Type1>,
-                                        is_implicitly_default_constructible<Type2>>)
+    template<class Other1 = Type1, class Other2 = Type2,    // dependent, so pairs of references can still be instantiated
+    enable_if_t<conjunction_v<  is_default_constructible<Other1>,
+                                is_default_constructible<Other2>>, bool> = true>
+    constexpr explicit(!conjunction_v<  is_implicitly_default_constructible<Other1>,
+                                        is_implicitly_default_constructible<Other2>>)
     pair()
     noexcept(is_nothrow_default_constructible_v<Type1> && is_nothrow_default_constructible_v<Type2>)
         : first(), second() { /*Empty*/ }
@@ -29,11 +29,12 @@ public:
 
 template<class Key,
 class Compare 	= custom::less<Key>,
-class Alloc		= custom::allocator<Key>>
-class set : public detail::_Search_Tree<_Set_Traits<Key, Compare, Alloc>>		// set Template
+class Alloc		= custom::allocator<Key>,
+class Policy	= custom::default_tree_policy>
+class set : public detail::_Search_Tree<_Set_Traits<Key, Compare, Alloc>, Policy>		// set Template
 {
 private:
-	using _Base = detail::_Search_Tree<_Set_Traits<Key, Compare, Alloc>>;
+	using _Base = detail::_Search_Tree<_Set_Traits<Key, Compare, Alloc>, Policy>;
 
 public:
 	using key_type					= typename _Base::key_type;
@@ -51,6 +52,9 @@ public:
 	using reverse_iterator			= typename _Base::reverse_iterator;
 	using const_reverse_iterator	= typename _Base::const_reverse_iterator;
 
+	using node_type					= typename _Base::node_type;
+	using insert_return_type		= typename _Base::insert_return_type;
+
 public:
     // Constructors
 
@@ -60,6 +64,10 @@ public:
 	set(std::initializer_list<value_type> list)
 		:_Base(list) { /*Empty*/ }
 
+	template<class Iter, enable_if_t<is_iterator_v<Iter>, bool> = true>
+	set(Iter first, Iter last)
+		:_Base(first, last) { /*Empty*/ }
+
 	set(const set& other)
 		: _Base(other) { /*Empty*/ }
 
@@ -0,0 +1,548 @@
+#pragma once
+#include "c_vector.h"
+
+
+CUSTOM_BEGIN
+
+template<class Type, size_t InlineCapacity, class Alloc = custom::allocator<Type>>
+class small_vector			// small_vector Template implemented as vector with inline storage
+{
+	// The first InlineCapacity elements live inside the object, so small instances never touch the allocator.
+	// Growing past InlineCapacity moves everything to the heap. Moving a heap instance steals the array,
+	// moving an inline instance relocates at most InlineCapacity elements.
+
+private:
+	using _Data						= _Vector_Data<Type, Alloc>;					// Same members as vector, _First points at _Inline when small
+	using _Alloc_Traits				= typename _Data::_Alloc_Traits;
+
+public:
+	static_assert(is_same_v<Type, typename Alloc::value_type>, "Object type and allocator type must be the same!");
+	static_assert(is_object_v<Type>, "Containers require object type!");
+	static_assert(InlineCapacity > 0, "small_vector requires inline capacity!");
+
+	using value_type				= typename _Data::value_type;
+	using difference_type			= typename _Data::difference_type;
+	using reference					= typename _Data::reference;
+	using const_reference			= typename _Data::const_reference;
+	using pointer					= typename _Data::pointer;
+	using const_pointer				= typename _Data::const_pointer;
+	using allocator_type			= Alloc;
+
+	using iterator					= _Vector_Iterator<_Data>;
+	using const_iterator			= _Vector_Const_Iterator<_Data>;
+	using reverse_iterator			= custom::reverse_iterator<iterator>;
+	using const_reverse_iterator	= custom::reverse_iterator<const_iterator>;
+
+	static constexpr size_t inline_capacity = InlineCapacity;
+
+private:
+	_Data _data;															// Actual container data
+	allocator_type _alloc;													// allocator, used only past inline_capacity
+	alignas(value_type) unsigned char _Inline[InlineCapacity * sizeof(value_type)];	// raw inline storage
+
+	using _Storage								= detail::_Vector_Storage_Traits<allocator_type>;
+
+	static constexpr bool _Copy_Bytes			= _Storage::_Copy_Bytes;
+
+public:
+	// Constructors
+
+	small_vector() noexcept {												// Default Constructor, no allocation
+		_reset_to_inline();
+	}
+
+	small_vector(const size_t newCapacity) : small_vector() {				// Add multiple default copies Constructor
+		realloc(newCapacity);
+	}
+
+	small_vector(	const size_t newCapacity,
+					const value_type& copyValue) : small_vector() {			// Add multiple copies Constructor
+		realloc(newCapacity, copyValue);
+	}
+
+	small_vector(std::initializer_list<value_type> list) : small_vector() {
+		assign(list.begin(), list.end());
+	}
+
+	template<class Iter, enable_if_t<is_iterator_v<Iter>, bool> = true>
+	small_vector(Iter first, Iter last) : small_vector() {
+		assign(first, last);
+	}
+
+	small_vector(const small_vector& other) : small_vector() {				// Copy Constructor
+		_copy(other);
+	}
+
+	small_vector(small_vector&& other) noexcept(is_nothrow_move_constructible_v<value_type>)
+		: small_vector() {													// Move Constructor
+		_move(custom::move(other));
+	}
+
+	~small_vector() noexcept {												// Destructor
+		_clean_up_array();
+	}
+
+public:
+	// Operators
+
+	const_reference operator[](const size_t index) const noexcept {			// Acces object at index (read only)
+		CUSTOM_ASSERT(index < size(), "Index out of bounds.");
+		return _data._First[index];
+	}
+
+	reference operator[](const size_t index) noexcept {						// Acces object at index
+		CUSTOM_ASSERT(index < size(), "Index out of bounds.");
+		return _data._First[index];
+	}
+
+	small_vector& operator=(const small_vector& other) {					// Assign operator using reference, keeps the current buffer when it fits
+		if (this != &other)
+		{
+			clear();
+			_copy(other);
+		}
+
+		return *this;
+	}
+
+	small_vector& operator=(small_vector&& other) noexcept(is_nothrow_move_constructible_v<value_type>) {	// Assign operator using temporary
+		if (this != &other)
+		{
+			_clean_up_array();
+			_move(custom::move(other));
+		}
+
+		return *this;
+	}
+
+public:
+	// Main functions
+
+	void reserve(const size_t newCapacity) {								// Move values to a bigger heap array if needed, never shrinks
+		if (newCapacity > capacity())
+			_reallocate(newCapacity);
+	}
+
+	void shrink_to_fit() {													// Move values back inline if they fit, or to a heap array of exactly size()
+		if (!_is_inline() && size() != capacity())
+			_reallocate(size());
+	}
+
+	void realloc(const size_t newCapacity) {								// Populate with newCapacity default values (delete old)
+		clear();
+		reserve(newCapacity);
+		detail::_construct_range(_alloc, _data._First, newCapacity);
+		_data._Last = _data._First + newCapacity;
+	}
+
+	void realloc(	const size_t newCapacity,
+					const value_type& copyValue) {							// Populate with newCapacity copies of given reference (delete old)
+		assign(newCapacity, copyValue);
+	}
+
+	void resize(const size_t newSize) {										// Change size and Construct/Destruct objects with default value if needed
+		if (newSize < size())
+			detail::_destroy_range(_alloc, _data._First + newSize, size() - newSize);
+		else
+		{
+			reserve(newSize);
+			detail::_construct_range(_alloc, _data._Last, newSize - size());
+		}
+
+		_data._Last = _data._First + newSize;
+	}
+
+	void resize(const size_t newSize, const value_type& copyValue) {		// Change size and Construct/Destruct objects with given reference if needed
+		if (newSize < size())
+			detail::_destroy_range(_alloc, _data._First + newSize, size() - newSize);
+		else
+		{
+			value_type value(copyValue);										// copyValue may be an element of this small_vector
+			reserve(newSize);
+			detail::_construct_range(_alloc, _data._Last, newSize - size(), value);
+		}
+
+		_data._Last = _data._First + newSize;
+	}
+
+	void resize_for_overwrite(const size_t newSize) {						// Change size, new elements are left uninitialized
+		static_assert(is_trivial_v<value_type>, "resize_for_overwrite requires a trivial type.");
+
+		if (newSize > capacity())
+			_reallocate(_grown_capacity(newSize - size()));
+
+		_data._Last = _data._First + newSize;
+	}
+
+	template<class Operation>
+	void resize_and_overwrite(const size_t count, Operation op) {			// op(data(), count) writes up to count elements and returns the new size
+		static_assert(is_trivial_v<value_type>, "resize_and_overwrite requires a trivial type.");
+
+		if (count > capacity())
+			_reallocate(_grown_capacity(count - size()));
+
+		const size_t newSize = static_cast<size_t>(custom::move(op)(_data._First, count));
+		CUSTOM_ASSERT(newSize <= count, "resize_and_overwrite operation returned a size past count.");
+
+		_data._Last = _data._First + newSize;
+	}
+
+	template<class... Args>
+	void emplace_back(Args&&... args) {										// Construct object using arguments (Args) and add it to the tail
+		if (_data._Last == _data._Final)
+		{
+			value_type value(custom::forward<Args>(args)...);					// args may refer to elements that are about to move
+			_reallocate(_grown_capacity(1));
+			_Alloc_Traits::construct(_alloc, _data._Last++, custom::move(value));
+		}
+		else
+			_Alloc_Traits::construct(_alloc, _data._Last++, custom::forward<Args>(args)...);
+	}
+
+	void push_back(const value_type& copyValue) {							// Construct object using reference and add it to the tail
+		emplace_back(copyValue);
+	}
+
+	void push_back(value_type&& moveValue) {								// Construct object using temporary and add it to the tail
+		emplace_back(custom::move(moveValue));
+	}
+
+	void pop_back() {														// Remove last component
+		if (!empty())
+			_Alloc_Traits::destroy(_alloc, --_data._Last);
+	}
+
+	template<class... Args>
+	iterator emplace(const_iterator where, Args&&... args) {				// Emplace object at where position with given arguments
+		size_t index = where.get_index();
+
+		if (index == size())
+		{
+			emplace_back(custom::forward<Args>(args)...);
+			return iterator(_data._First + index, &_data);
+		}
+
+		value_type value(custom::forward<Args>(args)...);						// args may refer to elements that are about to move
+		_open_gap(index, 1);
+		detail::_fill_gap(_alloc, _data, index, 1, &value, true_type{});
+
+		return iterator(_data._First + index, &_data);
+	}
+
+	iterator insert(const_iterator where, const value_type& copyValue) {	// Push copy object at iterator position
+		return emplace(where, copyValue);
+	}
+
+	iterator insert(const_iterator where, value_type&& moveValue) {			// Push temporary object at iterator position
+		return emplace(where, custom::move(moveValue));
+	}
+
+	iterator insert(const_iterator where, const size_t count, const value_type& copyValue) {	// Push count copies at iterator position
+		size_t index = where.get_index();
+		if (count == 0)
+			return iterator(_data._First + index, &_data);
+
+		value_type value(copyValue);												// copyValue may be an element of this small_vector
+		_open_gap(index, count);
+		detail::_fill_gap_n(_alloc, _data, index, count, value);
+
+		return iterator(_data._First + index, &_data);
+	}
+
+	template<class Iter, enable_if_t<is_iterator_v<Iter>, bool> = true>
+	iterator insert(const_iterator where, Iter first, Iter last) {			// Push range at iterator position, the range must not come from this small_vector
+		size_t index = where.get_index();
+
+		if constexpr (is_forward_iterator_v<Iter>)
+		{
+			const size_t count = static_cast<size_t>(custom::distance(first, last));
+			if (count != 0)
+			{
+				_open_gap(index, count);
+				detail::_fill_gap(_alloc, _data, index, count, first, false_type{});
+			}
+		}
+		else																		// single pass, append then rotate into place once
+		{
+			const size_t oldSize = size();
+			for (/*Empty*/; first != last; ++first)
+				emplace_back(*first);
+
+			custom::rotate(_data._First + index, _data._First + oldSize, _data._Last);
+		}
+
+		return iterator(_data._First + index, &_data);
+	}
+
+	iterator insert(const_iterator where, std::initializer_list<value_type> list) {
+		return insert(where, list.begin(), list.end());
+	}
+
+	iterator erase(const_iterator where) {									// Remove component at iterator position
+		if (where.is_end())
+			throw std::out_of_range("small_vector erase iterator outside range.");
+
+		return erase(where, where + 1);
+	}
+
+	iterator erase(const_iterator first, const_iterator last) {				// Remove components in [first, last)
+		_verify_range(first, last);
+
+		size_t index = first.get_index();
+		size_t count = last.get_index() - index;
+
+		detail::_erase_gap(_alloc, _data, index, count);
+		return iterator(_data._First + index, &_data);
+	}
+
+	void assign(const size_t count, const value_type& copyValue) {			// Replace content with count copies
+		value_type value(copyValue);													// copyValue may be an element of this small_vector
+		clear();
+		reserve(count);
+
+		detail::_construct_range(_alloc, _data._First, count, value);
+		_data._Last = _data._First + count;
+	}
+
+	template<class Iter, enable_if_t<is_iterator_v<Iter>, bool> = true>
+	void assign(Iter first, Iter last) {									// Replace content with range, reusing existing elements
+		if constexpr (is_forward_iterator_v<Iter>)
+		{
+			const size_t count = static_cast<size_t>(custom::distance(first, last));
+			if (count > capacity())
+			{
+				clear();
+				reserve(count);													// grow once, nothing to move
+			}
+		}
+
+		for (first = detail::_assign_live(_alloc, _data, first, last); first != last; ++first)
+			emplace_back(*first);
+	}
+
+	void assign(std::initializer_list<value_type> list) {
+		assign(list.begin(), list.end());
+	}
+
+	size_t capacity() const noexcept {										// Get capacity
+		return static_cast<size_t>(_data._Final - _data._First);
+	}
+
+	size_t size() const noexcept {											// Get size
+		return static_cast<size_t>(_data._Last - _data._First);
+	}
+
+	size_t max_size() const noexcept {
+		return (custom::min)(	static_cast<size_t>((numeric_limits<difference_type>::max)()),
+								_Alloc_Traits::max_size(_alloc));
+	}
+
+	bool empty() const noexcept {											// Check if array is empty
+		return (_data._First == _data._Last);
+	}
+
+	bool is_inline() const noexcept {										// Check if elements are stored inside the object
+		return _is_inline();
+	}
+
+	void clear() {															// Remove ALL components but keep memory
+		detail::_destroy_range(_alloc, _data._First, size());
+		_data._Last = _data._First;
+	}
+
+	const_reference at(const size_t index) const {							// Acces object at index with check (read only)
+		if (index >= size())
+			throw std::out_of_range("Index out of bounds.");
+
+		return _data._First[index];
+	}
+
+	reference at(const size_t index) {										// Acces object at index with check
+		if (index >= size())
+			throw std::out_of_range("Index out of bounds.");
+
+		return _data._First[index];
+	}
+
+	const_reference front() const noexcept {
+		CUSTOM_ASSERT(!empty(), "Container is empty.");
+		return _data._First[0];
+	}
+
+	reference front() noexcept {											// Get the value of the first component
+		CUSTOM_ASSERT(!empty(), "Container is empty.");
+		return _data._First[0];
+	}
+
+	const_reference back() const noexcept {
+		CUSTOM_ASSERT(!empty(), "Container is empty.");
+		return _data._Last[-1];
+	}
+
+	reference back() noexcept {												// Get the value of the last component
+		CUSTOM_ASSERT(!empty(), "Container is empty.");
+		return _data._Last[-1];
+	}
+
+	const_pointer data() const noexcept  {
+		return _data._First;
+	}
+
+	pointer data() noexcept {
+		return _data._First;
+	}
+
+public:
+	// iterator specific functions
+
+	iterator begin() noexcept {
+		return iterator(_data._First, &_data);
+	}
+
+	const_iterator begin() const noexcept {
+		return const_iterator(_data._First, &_data);
+	}
+
+	reverse_iterator rbegin() noexcept {
+		return reverse_iterator(end());
+	}
+
+	const_reverse_iterator rbegin() const noexcept {
+		return const_reverse_iterator(end());
+	}
+
+	iterator end() noexcept {
+		return iterator(_data._Last, &_data);
+	}
+
+	const_iterator end() const noexcept {
+		return const_iterator(_data._Last, &_data);
+	}
+
+	reverse_iterator rend() noexcept {
+		return reverse_iterator(begin());
+	}
+
+	const_reverse_iterator rend() const noexcept {
+		return const_reverse_iterator(begin());
+	}
+
+private:
+	// Helpers
+
+	value_type* _inline_first() noexcept {
+		return reinterpret_cast<value_type*>(_Inline);
+	}
+
+	bool _is_inline() const noexcept {
+		return _data._First == reinterpret_cast<const value_type*>(_Inline);
+	}
+
+	void _reset_to_inline() noexcept {										// Empty, pointing at the inline storage
+		_data._First	= _inline_first();
+		_data._Last		= _data._First;
+		_data._Final	= _data._First + InlineCapacity;
+	}
+
+	void _copy(const small_vector& other) {									// Copy into the current buffer, which must be empty
+		const size_t newSize = other.size();
+		reserve(newSize);
+
+		if constexpr (_Copy_Bytes)
+			detail::_copy_bytes(_data._First, other._data._First, newSize);
+		else
+			for (size_t i = 0; i < newSize; ++i)
+				_Alloc_Traits::construct(_alloc, _data._First + i, other._data._First[i]);
+
+		_data._Last = _data._First + newSize;
+	}
+
+	void _move(small_vector&& other) {										// Steal the heap array, or relocate the inline elements. This must be inline and empty
+		if (other._is_inline())
+		{
+			const size_t newSize = other.size();
+			detail::_relocate_range(_alloc, _data._First, other._data._First, newSize);
+			_data._Last			= _data._First + newSize;
+			other._data._Last	= other._data._First;
+		}
+		else
+		{
+			_data._First	= other._data._First;
+			_data._Last		= other._data._Last;
+			_data._Final	= other._data._Final;
+			other._reset_to_inline();
+		}
+	}
+
+
+	void _reallocate(const size_t newCapacity) {							// Move values to inline storage if newCapacity fits, else to a new heap array
+		const size_t oldSize	= size();
+		value_type* newArray	= (newCapacity <= InlineCapacity) ? _inline_first() : _alloc.allocate(newCapacity);
+
+		if (newArray == _data._First)
+			return;
+
+		detail::_relocate_range(_alloc, newArray, _data._First, oldSize);
+		_free_heap();
+
+		_data._First	= newArray;
+		_data._Last		= newArray + oldSize;
+		_data._Final	= newArray + (custom::max)(newCapacity, InlineCapacity);
+	}
+
+	size_t _grown_capacity(const size_t extra) const noexcept {				// 50% more capacity, or exactly enough for extra more values
+		return (custom::max)(size() + extra, capacity() + capacity() / 2 + 1);
+	}
+
+	void _open_gap(const size_t index, const size_t count) {				// Relocate [index, size) count slots up, leaving the gap raw
+		const size_t oldSize = size();
+
+		if (count > static_cast<size_t>(_data._Final - _data._Last))			// grow at most once, always onto the heap
+		{
+			const size_t newCapacity	= _grown_capacity(count);
+			value_type* newArray		= _alloc.allocate(newCapacity);
+
+			detail::_relocate_range(_alloc, newArray, _data._First, index);
+			detail::_relocate_range(_alloc, newArray + index + count, _data._First + index, oldSize - index);
+			_free_heap();
+
+			_data._First	= newArray;
+			_data._Last		= newArray + oldSize + count;
+			_data._Final	= newArray + newCapacity;
+			return;
+		}
+
+		detail::_open_gap_in_place(_alloc, _data, index, count);
+	}
+
+
+	void _free_heap() noexcept {											// Deallocate the heap array, elements must be gone already
+		if (!_is_inline())
+			_alloc.deallocate(_data._First, capacity());
+	}
+
+	void _clean_up_array() noexcept {										// Clear, Deallocate and go back inline
+		detail::_destroy_range(_alloc, _data._First, size());
+		_free_heap();
+		_reset_to_inline();
+	}
+}; // END small_vector Template
+
+
+// small_vector binary operators
+template<class _Type, size_t _InlineCapacity, class _Alloc>
+bool operator==(const small_vector<_Type, _InlineCapacity, _Alloc>& left,
+				const small_vector<_Type, _InlineCapacity, _Alloc>& right) {
+	if (left.size() != right.size())
+		return false;
+
+	return custom::equal(left.begin(), left.end(), right.begin());
+}
+
+template<class _Type, size_t _InlineCapacity, class _Alloc>
+bool operator!=(const small_vector<_Type, _InlineCapacity, _Alloc>& left,
+				const small_vector<_Type, _InlineCapacity, _Alloc>& right) {
+	return !(left == right);
+}
+
+CUSTOM_END
\ No newline at end of file
@@ -0,0 +1,754 @@
+#pragma once
+
+#if defined __GNUG__
+#include <atomic>
+#include <cstdint>
+#include "x_memory.h"
+#include "c_pair.h"
+#include "c_tuple.h"
+#include "c_array.h"
+#include "c_vector.h"
+#include "c_mutex.h"
+#include "c_functional.h"	// for custom::Less
+
+
+CUSTOM_BEGIN
+
+CUSTOM_DETAIL_BEGIN
+
+template<class Value>
+struct _Persistent_Tree_Node		// AVL node, immutable once published, shared between versions
+{
+	_Persistent_Tree_Node* _Left	= nullptr;
+	_Persistent_Tree_Node* _Right	= nullptr;
+	std::atomic<uint32_t> _Refs		= 1;				// parents and versions holding this node, shares a word with _Height
+	unsigned char _Height			= 1;
+	Value _Value;
+};
+
+template<class Node>
+struct _Persistent_Tree_Version		// root of one published state
+{
+	Node* _Root						= nullptr;
+	size_t _Size					= 0;
+	std::atomic<size_t> _Refs		= 1;				// the map until retired, plus every snapshot
+};
+
+template<class Value, class Alloc>
+struct _Persistent_Tree_Storage		// node lifetime, shared by the map and its snapshots
+{
+	using _Node					= _Persistent_Tree_Node<Value>;
+	using _Version				= _Persistent_Tree_Version<_Node>;
+	using _Alloc_Node			= typename allocator_traits<Alloc>::template rebind_alloc<_Node>;
+	using _Alloc_Node_Traits	= allocator_traits<_Alloc_Node>;
+	using _Alloc_Version		= typename allocator_traits<Alloc>::template rebind_alloc<_Version>;
+	using _Alloc_Version_Traits	= allocator_traits<_Alloc_Version>;
+
+	static _Node* retain(_Node* node) noexcept {
+		if (node != nullptr)
+			node->_Refs.fetch_add(1, std::memory_order_relaxed);
+
+		return node;
+	}
+
+	static void release(_Alloc_Node& alloc, _Node* node) noexcept {		// free every node whose last holder was node's parent
+		while (node != nullptr && node->_Refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			_Node* right = node->_Right;
+			release(alloc, node->_Left);
+
+			_Alloc_Node_Traits::destroy(alloc, &node->_Value);
+			_Alloc_Node_Traits::deallocate(alloc, node, 1);
+			node = right;											// loop on the right child instead of recursing
+		}
+	}
+
+	static _Version* retain_version(_Version* version) noexcept {
+		version->_Refs.fetch_add(1, std::memory_order_relaxed);
+		return version;
+	}
+
+	static void release_version(_Alloc_Node& alloc, _Version* version) noexcept {
+		if (version->_Refs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+			return;
+
+		release(alloc, version->_Root);
+
+		_Alloc_Version allocVersion(alloc);
+		_Alloc_Version_Traits::destroy(allocVersion, version);
+		_Alloc_Version_Traits::deallocate(allocVersion, version, 1);
+	}
+};
+
+CUSTOM_DETAIL_END
+
+
+template<class Traits, class Alloc>
+class _Snapshot_Map_Const_Iterator		// in-order walk with an explicit stack, nodes have no parent links
+{
+private:
+	using _Node					= detail::_Persistent_Tree_Node<typename Traits::value_type>;
+
+	static constexpr size_t _MAX_HEIGHT = 96;				// an AVL tree of height 92 needs more than 2^64 nodes
+
+public:
+	using iterator_category		= forward_iterator_tag;
+	using value_type			= typename Traits::value_type;
+	using difference_type		= ptrdiff_t;
+	using reference				= const value_type&;
+	using pointer				= const value_type*;
+
+	const _Node* _Stack[_MAX_HEIGHT];						// the current node on top, then its pending ancestors
+	size_t _Depth				= 0;						// 0 for end
+
+public:
+
+	_Snapshot_Map_Const_Iterator() noexcept = default;
+
+	_Snapshot_Map_Const_Iterator& operator++() noexcept {
+		CUSTOM_ASSERT(_Depth > 0, "Cannot increment end iterator.");
+
+		const _Node* node = _Stack[--_Depth];
+		_push_left_spine(node->_Right);
+		return *this;
+	}
+
+	_Snapshot_Map_Const_Iterator operator++(int) noexcept {
+		_Snapshot_Map_Const_Iterator temp = *this;
+		++(*this);
+		return temp;
+	}
+
+	pointer operator->() const noexcept {
+		CUSTOM_ASSERT(_Depth > 0, "Cannot access end iterator.");
+		return &_Stack[_Depth - 1]->_Value;
+	}
+
+	reference operator*() const noexcept {
+		CUSTOM_ASSERT(_Depth > 0, "Cannot dereference end iterator.");
+		return _Stack[_Depth - 1]->_Value;
+	}
+
+	bool operator==(const _Snapshot_Map_Const_Iterator& other) const noexcept {
+		return _Depth == other._Depth && (_Depth == 0 || _Stack[_Depth - 1] == other._Stack[other._Depth - 1]);
+	}
+
+	bool operator!=(const _Snapshot_Map_Const_Iterator& other) const noexcept {
+		return !(*this == other);
+	}
+
+	void _push(const _Node* node) noexcept {
+		CUSTOM_ASSERT(_Depth < _MAX_HEIGHT, "Snapshot tree too tall.");
+		_Stack[_Depth++] = node;
+	}
+
+	void _push_left_spine(const _Node* node) noexcept {
+		for (/*Empty*/; node != nullptr; node = node->_Left)
+			_push(node);
+	}
+
+	friend void _verify_range(const _Snapshot_Map_Const_Iterator&, const _Snapshot_Map_Const_Iterator&) noexcept {
+		// No possible way to determine order.
+	}
+}; // END _Snapshot_Map_Const_Iterator
+
+
+template<class Traits, class Alloc>
+class _Snapshot_Map_View		// Immutable state of a snapshot_map, valid for as long as the view exists
+{
+private:
+	using _Storage				= detail::_Persistent_Tree_Storage<typename Traits::value_type, Alloc>;
+	using _Node					= typename _Storage::_Node;
+	using _Version				= typename _Storage::_Version;
+	using _Alloc_Node			= typename _Storage::_Alloc_Node;
+
+public:
+	using key_type				= typename Traits::key_type;
+	using mapped_type			= typename Traits::mapped_type;
+	using key_compare			= typename Traits::key_compare;
+	using value_type			= typename Traits::value_type;
+	using const_reference		= const value_type&;
+	using const_iterator		= _Snapshot_Map_Const_Iterator<Traits, Alloc>;
+	using iterator				= const_iterator;
+
+private:
+	_Version* _version			= nullptr;					// holds one reference
+	_Alloc_Node _alloc;										// frees the nodes if this view outlives the map's newer versions
+	key_compare _less;
+
+public:
+	// Constructors
+
+	_Snapshot_Map_View(_Version* version, const _Alloc_Node& alloc, const key_compare& compare) noexcept
+		: _version(version), _alloc(alloc), _less(compare) { /*Empty*/ }
+
+	_Snapshot_Map_View(const _Snapshot_Map_View& other) noexcept
+		: _version(other._version != nullptr ? _Storage::retain_version(other._version) : nullptr),
+		_alloc(other._alloc), _less(other._less) { /*Empty*/ }
+
+	_Snapshot_Map_View(_Snapshot_Map_View&& other) noexcept
+		: _version(custom::exchange(other._version, nullptr)), _alloc(other._alloc), _less(other._less) { /*Empty*/ }
+
+	~_Snapshot_Map_View() {
+		if (_version != nullptr)
+			_Storage::release_version(_alloc, _version);
+	}
+
+	_Snapshot_Map_View& operator=(_Snapshot_Map_View other) noexcept {
+		custom::swap(_version, other._version);		// other releases the old version
+		_alloc	= other._alloc;
+		_less	= other._less;
+		return *this;
+	}
+
+public:
+	// Main functions
+
+	const_iterator find(const key_type& key) const {
+		const_iterator it = lower_bound(key);
+		return (it == end() || _less(key, Traits::extract_key(*it))) ? end() : it;
+	}
+
+	bool contains(const key_type& key) const {
+		return _find_node(key) != nullptr;
+	}
+
+	size_t count(const key_type& key) const {
+		return contains(key) ? 1 : 0;
+	}
+
+	const mapped_type& at(const key_type& key) const {			// Access _Value at key with check
+		const _Node* node = _find_node(key);
+		if (node == nullptr)
+			throw std::out_of_range("Invalid key.");
+
+		return Traits::extract_mapval(node->_Value);
+	}
+
+	const_iterator lower_bound(const key_type& key) const {		// First value not less than key
+		const_iterator it;
+		for (const _Node* node = _version->_Root; node != nullptr; /*Empty*/)
+			if (_less(Traits::extract_key(node->_Value), key))
+				node = node->_Right;
+			else												// candidate, smaller ones may still be on the left
+			{
+				it._push(node);
+				node = node->_Left;
+			}
+
+		return it;
+	}
+
+	const_iterator upper_bound(const key_type& key) const {		// First value greater than key
+		const_iterator it;
+		for (const _Node* node = _version->_Root; node != nullptr; /*Empty*/)
+			if (_less(key, Traits::extract_key(node->_Value)))
+			{
+				it._push(node);
+				node = node->_Left;
+			}
+			else
+				node = node->_Right;
+
+		return it;
+	}
+
+	size_t size() const noexcept {
+		return _version->_Size;
+	}
+
+	bool empty() const noexcept {
+		return _version->_Size == 0;
+	}
+
+public:
+	// iterator functions
+
+	const_iterator begin() const noexcept {
+		const_iterator it;
+		it._push_left_spine(_version->_Root);
+		return it;
+	}
+
+	const_iterator end() const noexcept {
+		return const_iterator();
+	}
+
+private:
+	// Helpers
+
+	const _Node* _find_node(const key_type& key) const {
+		const _Node* node = _version->_Root;
+
+		while (node != nullptr)
+			if (_less(key, Traits::extract_key(node->_Value)))
+				node = node->_Left;
+			else if (_less(Traits::extract_key(node->_Value), key))
+				node = node->_Right;
+			else
+				break;
+
+		return node;
+	}
+}; // END _Snapshot_Map_View
+
+
+template<class Key, class Type, class Compare>
+class _Snapshot_Map_Traits								// snapshot_map Traits
+{
+public:
+	using key_type 			= Key;
+	using mapped_type 		= Type;
+	using key_compare 		= Compare;
+	using value_type 		= pair<Key, Type>;
+
+public:
+
+	_Snapshot_Map_Traits() = default;
+
+	static const key_type& extract_key(const value_type& value) noexcept {		// extract key from element value
+		return value.first;
+	}
+
+	static const mapped_type& extract_mapval(const value_type& value) noexcept {	// extract mapped val from element value
+		return value.second;
+	}
+}; // END snapshot_map Traits
+
+
+// snapshot_map Template implemented as a persistent (path copying) AVL tree
+// Readers never lock: they announce themselves in a reader slot, load the current version and search it.
+// Writers are serialized by a mutex, copy only the path to the changed node and publish a new version
+// with one atomic store, sharing every unchanged subtree with the old one.
+// A replaced version is freed once no reader slot shows an epoch from before the replacement.
+template<class Key, class Type,
+class Compare 			= custom::less<Key>,
+class Alloc 			= custom::allocator<custom::pair<Key, Type>>,
+size_t ReaderSlots		= 64>
+class snapshot_map
+{
+private:
+	using _Traits				= _Snapshot_Map_Traits<Key, Type, Compare>;
+	using _Storage				= detail::_Persistent_Tree_Storage<pair<Key, Type>, Alloc>;
+	using _Node					= typename _Storage::_Node;
+	using _Version				= typename _Storage::_Version;
+	using _Alloc_Node			= typename _Storage::_Alloc_Node;
+	using _Alloc_Node_Traits	= typename _Storage::_Alloc_Node_Traits;
+	using _Alloc_Version		= typename _Storage::_Alloc_Version;
+	using _Alloc_Version_Traits	= typename _Storage::_Alloc_Version_Traits;
+
+	static_assert(ReaderSlots > 0, "snapshot_map requires at least one reader slot!");
+
+	struct alignas(64) _Reader_Slot				// padded to a cache line, so readers on different slots don't false share
+	{
+		std::atomic<uint64_t> _Epoch = 0;		// epoch seen on entry, 0 while free
+	};
+
+	struct _Retired
+	{
+		_Version* _Old;
+		uint64_t _Epoch;						// last epoch in which readers could load it
+	};
+
+	class _Slot_Guard							// holds a reader slot for a scope, released on every exit path
+	{
+	public:
+		explicit _Slot_Guard(const snapshot_map& map) noexcept
+			: _slot(map._enter()) { /*Empty*/ }
+
+		~_Slot_Guard() noexcept {
+			_leave(_slot);
+		}
+
+		_Slot_Guard(const _Slot_Guard&)				= delete;
+		_Slot_Guard& operator=(const _Slot_Guard&)	= delete;
+
+	private:
+		_Reader_Slot& _slot;
+	};
+
+public:
+	static_assert(is_object_v<Key>, "Containers require object type!");
+
+	using key_type 			= Key;
+	using mapped_type 		= Type;
+	using key_compare		= Compare;
+	using value_type 		= pair<Key, Type>;
+	using const_reference 	= const value_type&;
+	using allocator_type 	= Alloc;
+	using snapshot_type		= _Snapshot_Map_View<_Traits, Alloc>;
+
+private:
+	std::atomic<_Version*> _current;
+	std::atomic<uint64_t> _epoch	= 1;
+	mutable array<_Reader_Slot, ReaderSlots> _slots;
+	mutable mutex _writeMutex;
+	vector<_Retired> _retired;					// guarded by _writeMutex
+	_Alloc_Node _alloc;
+	key_compare _less;
+
+public:
+	// Constructors
+
+	snapshot_map()
+		: _current(_create_version(nullptr, 0)) { /*Empty*/ }
+
+	~snapshot_map() {							// no reader may be inside the map anymore, snapshots keep their own version
+		for (const _Retired& retired : _retired)
+			_Storage::release_version(_alloc, retired._Old);
+
+		_Storage::release_version(_alloc, _current.load(std::memory_order_relaxed));
+	}
+
+	snapshot_map(const snapshot_map&)				= delete;
+	snapshot_map& operator=(const snapshot_map&)	= delete;
+
+public:
+	// Main functions (writers)
+
+	template<class... Args>
+	bool emplace(const key_type& key, Args&&... args) {				// Insert if key is missing, returns true if inserted
+		lock_guard<mutex> lock(_writeMutex);
+
+		bool inserted	= false;
+		_Node* newRoot	= _insert(_root(), false, inserted, key, custom::forward<Args>(args)...);
+
+		if (newRoot != nullptr)
+			_publish(newRoot, _size() + 1);
+
+		return inserted;
+	}
+
+	template<class Obj>
+	bool insert_or_assign(const key_type& key, Obj&& obj) {			// Insert or overwrite mapped value, returns true if inserted
+		lock_guard<mutex> lock(_writeMutex);
+
+		bool inserted	= false;
+		_Node* newRoot	= _insert(_root(), true, inserted, key, custom::forward<Obj>(obj));
+
+		_publish(newRoot, inserted ? _size() + 1 : _size());
+		return inserted;
+	}
+
+	bool erase(const key_type& key) {
+		lock_guard<mutex> lock(_writeMutex);
+
+		bool erased		= false;
+		_Node* newRoot	= _erase(_root(), key, erased);
+
+		if (erased)
+			_publish(newRoot, _size() - 1);
+
+		return erased;
+	}
+
+	void clear() {
+		lock_guard<mutex> lock(_writeMutex);
+		_publish(nullptr, 0);
+	}
+
+public:
+	// Main functions (readers, lock free)
+
+	template<class Visitor>
+	bool visit(const key_type& key, Visitor visitor) const {		// Call visitor(const value_type&) on the current version, returns true if found
+		_Slot_Guard guard(*this);
+		const _Node* node		= _find_node(_current.load(std::memory_order_seq_cst)->_Root, key);
+
+		if (node != nullptr)
+			visitor(node->_Value);
+
+		return node != nullptr;
+	}
+
+	bool contains(const key_type& key) const {
+		_Slot_Guard guard(*this);
+		return _find_node(_current.load(std::memory_order_seq_cst)->_Root, key) != nullptr;
+	}
+
+	size_t size() const {
+		_Slot_Guard guard(*this);
+		return _current.load(std::memory_order_seq_cst)->_Size;
+	}
+
+	bool empty() const {
+		return size() == 0;
+	}
+
+	snapshot_type snapshot() const {								// Consistent view of every element, unaffected by later writes
+		_Version* version = nullptr;
+		{
+			_Slot_Guard guard(*this);
+			version = _Storage::retain_version(_current.load(std::memory_order_seq_cst));
+		}
+
+		return snapshot_type(version, _alloc, _less);
+	}
+
+	static constexpr size_t reader_slots() noexcept {
+		return ReaderSlots;
+	}
+
+private:
+	// Helpers (readers)
+
+	static size_t _thread_slot() noexcept {							// threads take consecutive slots, so up to ReaderSlots readers never collide
+		static std::atomic<size_t> nextIndex = 0;
+		static thread_local const size_t index = nextIndex.fetch_add(1, std::memory_order_relaxed);
+
+		return index % ReaderSlots;
+	}
+
+	_Reader_Slot& _enter() const noexcept {
+		for (size_t index = _thread_slot(); ; index = (index + 1) % ReaderSlots)
+		{
+			uint64_t expected = 0;
+			if (_slots[index]._Epoch.compare_exchange_strong(expected, _epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst))
+				return _slots[index];
+		}
+	}
+
+	static void _leave(_Reader_Slot& slot) noexcept {
+		slot._Epoch.store(0, std::memory_order_release);
+	}
+
+	const _Node* _find_node(const _Node* node, const key_type& key) const {
+		while (node != nullptr)
+			if (_less(key, node->_Value.first))
+				node = node->_Left;
+			else if (_less(node->_Value.first, key))
+				node = node->_Right;
+			else
+				break;
+
+		return node;
+	}
+
+private:
+	// Helpers (writers, called with _writeMutex held)
+
+	_Node* _root() const noexcept {
+		return _current.load(std::memory_order_relaxed)->_Root;
+	}
+
+	size_t _size() const noexcept {
+		return _current.load(std::memory_order_relaxed)->_Size;
+	}
+
+	void _publish(_Node* newRoot, const size_t newSize) {			// newRoot reference moves into the new version
+		_Version* oldVersion = _current.load(std::memory_order_relaxed);
+
+		_current.store(_create_version(newRoot, newSize), std::memory_order_seq_cst);
+		_retired.push_back({oldVersion, _epoch.fetch_add(1, std::memory_order_seq_cst)});
+		_reclaim();
+	}
+
+	void _reclaim() noexcept {										// release retired versions older than every active reader
+		uint64_t oldestReader = static_cast<uint64_t>(-1);
+		for (const _Reader_Slot& slot : _slots)
+		{
+			const uint64_t epoch = slot._Epoch.load(std::memory_order_seq_cst);
+			if (epoch != 0 && epoch < oldestReader)
+				oldestReader = epoch;
+		}
+
+		size_t kept = 0;
+		for (size_t i = 0; i < _retired.size(); ++i)
+			if (_retired[i]._Epoch < oldestReader)
+				_Storage::release_version(_alloc, _retired[i]._Old);
+			else
+				_retired[kept++] = _retired[i];
+
+		while (_retired.size() > kept)
+			_retired.pop_back();
+	}
+
+	_Version* _create_version(_Node* root, const size_t size) {
+		_Alloc_Version allocVersion(_alloc);
+		_Version* version = _Alloc_Version_Traits::allocate(allocVersion, 1);
+
+		_Alloc_Version_Traits::construct(allocVersion, version);
+		version->_Root = root;
+		version->_Size = size;
+		return version;
+	}
+
+	template<class... Args>
+	_Node* _create_node(_Node* left, _Node* right, Args&&... args) {	// takes over the references to left and right
+		_Node* node = _Alloc_Node_Traits::allocate(_alloc, 1);
+
+		try
+		{
+			_Alloc_Node_Traits::construct(_alloc, &node->_Value, custom::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			_Alloc_Node_Traits::deallocate(_alloc, node, 1);
+			_Storage::release(_alloc, left);
+			_Storage::release(_alloc, right);
+			CUSTOM_RERAISE;
+		}
+
+		new (&node->_Refs) std::atomic<uint32_t>(1);
+		node->_Left		= left;
+		node->_Right	= right;
+		_update_height(node);
+		return node;
+	}
+
+	_Node* _own(_Node* shared) {									// private copy of shared, whose reference is given up
+		_Node* copy = _create_node(_Storage::retain(shared->_Left), _Storage::retain(shared->_Right), shared->_Value);
+		_Storage::release(_alloc, shared);
+		return copy;
+	}
+
+	template<class... Args>
+	_Node* _insert(_Node* node, const bool assign, bool& inserted, const key_type& key, Args&&... args) {	// new subtree, or nullptr if unchanged
+		if (node == nullptr)
+		{
+			inserted = true;
+			return _create_node(nullptr, nullptr,
+								custom::piecewise_construct,
+								custom::forward_as_tuple(key),
+								custom::forward_as_tuple(custom::forward<Args>(args)...));
+		}
+
+		if (_less(key, node->_Value.first))
+		{
+			_Node* newLeft = _insert(node->_Left, assign, inserted, key, custom::forward<Args>(args)...);
+			if (newLeft == nullptr)
+				return nullptr;
+
+			return _balance(_create_node(newLeft, _Storage::retain(node->_Right), node->_Value));
+		}
+
+		if (_less(node->_Value.first, key))
+		{
+			_Node* newRight = _insert(node->_Right, assign, inserted, key, custom::forward<Args>(args)...);
+			if (newRight == nullptr)
+				return nullptr;
+
+			return _balance(_create_node(_Storage::retain(node->_Left), newRight, node->_Value));
+		}
+
+		if (!assign)
+			return nullptr;
+
+		return _create_node(_Storage::retain(node->_Left), _Storage::retain(node->_Right),
+							custom::piecewise_construct,
+							custom::forward_as_tuple(node->_Value.first),
+							custom::forward_as_tuple(custom::forward<Args>(args)...));
+	}
+
+	_Node* _erase(_Node* node, const key_type& key, bool& erased) {		// new subtree, meaningful only if erased
+		if (node == nullptr)
+			return nullptr;
+
+		if (_less(key, node->_Value.first))
+		{
+			_Node* newLeft = _erase(node->_Left, key, erased);
+			if (!erased)
+				return nullptr;
+
+			return _balance(_create_node(newLeft, _Storage::retain(node->_Right), node->_Value));
+		}
+
+		if (_less(node->_Value.first, key))
+		{
+			_Node* newRight = _erase(node->_Right, key, erased);
+			if (!erased)
+				return nullptr;
+
+			return _balance(_create_node(_Storage::retain(node->_Left), newRight, node->_Value));
+		}
+
+		erased = true;
+		if (node->_Left == nullptr)
+			return _Storage::retain(node->_Right);
+
+		if (node->_Right == nullptr)
+			return _Storage::retain(node->_Left);
+
+		const _Node* successor	= nullptr;
+		_Node* newRight			= _erase_min(node->_Right, successor);	// successor stays alive through the old version
+		return _balance(_create_node(_Storage::retain(node->_Left), newRight, successor->_Value));
+	}
+
+	_Node* _erase_min(_Node* node, const _Node*& minNode) {
+		if (node->_Left == nullptr)
+		{
+			minNode = node;
+			return _Storage::retain(node->_Right);
+		}
+
+		_Node* newLeft = _erase_min(node->_Left, minNode);
+		return _balance(_create_node(newLeft, _Storage::retain(node->_Right), node->_Value));
+	}
+
+	_Node* _balance(_Node* node) {									// node is a private copy, its children may be shared
+		const int factor = _height(node->_Left) - _height(node->_Right);
+
+		if (factor > 1)
+		{
+			node->_Left = _own(node->_Left);
+			if (_height(node->_Left->_Left) < _height(node->_Left->_Right))
+			{
+				node->_Left->_Right	= _own(node->_Left->_Right);
+				node->_Left			= _rotate_left(node->_Left);
+			}
+
+			return _rotate_right(node);
+		}
+
+		if (factor < -1)
+		{
+			node->_Right = _own(node->_Right);
+			if (_height(node->_Right->_Right) < _height(node->_Right->_Left))
+			{
+				node->_Right->_Left	= _own(node->_Right->_Left);
+				node->_Right		= _rotate_right(node->_Right);
+			}
+
+			return _rotate_left(node);
+		}
+
+		return node;
+	}
+
+	static _Node* _rotate_left(_Node* node) noexcept {				// node and its right child are private copies
+		_Node* pivot	= node->_Right;
+		node->_Right	= pivot->_Left;
+		pivot->_Left	= node;
+
+		_update_height(node);
+		_update_height(pivot);
+		return pivot;
+	}
+
+	static _Node* _rotate_right(_Node* node) noexcept {				// node and its left child are private copies
+		_Node* pivot	= node->_Left;
+		node->_Left		= pivot->_Right;
+		pivot->_Right	= node;
+
+		_update_height(node);
+		_update_height(pivot);
+		return pivot;
+	}
+
+	static int _height(const _Node* node) noexcept {
+		return (node == nullptr) ? 0 : node->_Height;
+	}
+
+	static void _update_height(_Node* node) noexcept {
+		const int left	= _height(node->_Left);
+		const int right	= _height(node->_Right);
+
+		node->_Height = static_cast<unsigned char>((left > right ? left : right) + 1);
+	}
+}; // END snapshot_map Template
+
+CUSTOM_END
+
+#elif defined _MSC_VER
+#error NO SnapshotMap implementation
+#endif      // __GNUG__ and _MSC_VER
\ No newline at end of file
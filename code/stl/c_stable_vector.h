@@ -0,0 +1,618 @@
+#pragma once
+#include "x_memory.h"
+#include "c_utility.h"
+#include "c_algorithm.h"
+#include "c_iterator.h"
+#include "c_bit.h"
+
+
+CUSTOM_BEGIN
+
+template<class Type, class Alloc>
+struct _Stable_Vector_Data
+{
+	using _Alloc_Traits		= allocator_traits<Alloc>;
+
+	using value_type		= typename _Alloc_Traits::value_type;
+	using difference_type	= typename _Alloc_Traits::difference_type;
+	using reference			= typename _Alloc_Traits::reference;
+	using const_reference	= typename _Alloc_Traits::const_reference;
+	using pointer			= typename _Alloc_Traits::pointer;
+	using const_pointer		= typename _Alloc_Traits::const_pointer;
+
+	// Segment k holds _FIRST_SEGMENT << k elements and starts at index _FIRST_SEGMENT * (2^k - 1),
+	// so index + _FIRST_SEGMENT has its highest bit at position k + _FIRST_SHIFT.
+	static constexpr size_t _FIRST_SEGMENT	= custom::bit_floor((custom::max)(size_t{256} / sizeof(value_type), size_t{4}));
+	static constexpr size_t _FIRST_SHIFT	= static_cast<size_t>(custom::bit_width(_FIRST_SEGMENT)) - 1;
+	static constexpr size_t _MAX_SEGMENTS	= static_cast<size_t>(numeric_limits<size_t>::digits) - _FIRST_SHIFT;
+
+	pointer _Segments[_MAX_SEGMENTS]	= {};		// segment arrays, never moved once allocated
+	size_t _SegmentCount				= 0;		// allocated segments
+	size_t _Size						= 0;
+
+	static size_t segment_of(const size_t index) noexcept {
+		return static_cast<size_t>(custom::bit_width(index + _FIRST_SEGMENT)) - 1 - _FIRST_SHIFT;
+	}
+
+	static size_t segment_begin(const size_t segment) noexcept {		// index of the first element in segment
+		return (_FIRST_SEGMENT << segment) - _FIRST_SEGMENT;
+	}
+
+	static size_t segment_size(const size_t segment) noexcept {
+		return _FIRST_SEGMENT << segment;
+	}
+
+	size_t capacity() const noexcept {
+		return segment_begin(_SegmentCount);
+	}
+
+	pointer element(const size_t index) const noexcept {
+		const size_t segment = segment_of(index);
+		return _Segments[segment] + (index - segment_begin(segment));
+	}
+};
+
+template<class StableVecData>
+class _Stable_Vector_Const_Iterator
+{
+private:
+	using _Data				= StableVecData;
+
+public:
+    using iterator_category	= random_access_iterator_tag;
+	using value_type		= typename _Data::value_type;
+	using difference_type 	= typename _Data::difference_type;
+	using reference			= typename _Data::const_reference;
+	using pointer			= typename _Data::const_pointer;
+	using _Segmented		= true_type;						// segments are contiguous, see _for_each_segment
+
+	value_type* _Ptr		= nullptr;			// current element
+	value_type* _SegFirst	= nullptr;			// bounds of the current segment, so ++ and -- are pointer bumps
+	value_type* _SegLast	= nullptr;
+	size_t _Index			= 0;
+	const _Data* _RefData	= nullptr;
+
+public:
+
+	_Stable_Vector_Const_Iterator() noexcept = default;
+
+	explicit _Stable_Vector_Const_Iterator(size_t index, const _Data* data) noexcept
+		:_RefData(data) {
+		_seek(index);
+	}
+
+	_Stable_Vector_Const_Iterator& operator++() noexcept {
+		CUSTOM_ASSERT(_Index < _RefData->_Size, "Cannot increment end iterator.");
+		++_Index;
+		if (++_Ptr == _SegLast)
+			_seek(_Index);
+
+		return *this;
+	}
+
+	_Stable_Vector_Const_Iterator operator++(int) noexcept {
+		_Stable_Vector_Const_Iterator temp = *this;
+		++(*this);
+		return temp;
+	}
+
+	_Stable_Vector_Const_Iterator& operator+=(const difference_type diff) noexcept {
+		CUSTOM_ASSERT(_Index + static_cast<size_t>(diff) <= _RefData->_Size, "Cannot increment end iterator.");
+		_seek(_Index + static_cast<size_t>(diff));
+		return *this;
+	}
+
+	_Stable_Vector_Const_Iterator operator+(const difference_type diff) const noexcept {
+		_Stable_Vector_Const_Iterator temp = *this;
+		temp += diff;
+		return temp;
+	}
+
+	_Stable_Vector_Const_Iterator& operator--() noexcept {
+		CUSTOM_ASSERT(_Index > 0, "Cannot decrement begin iterator.");
+		--_Index;
+		if (_Ptr == _SegFirst)												// also covers an end iterator past the last segment
+			_seek(_Index);
+		else
+			--_Ptr;
+
+		return *this;
+	}
+
+	_Stable_Vector_Const_Iterator operator--(int) noexcept {
+		_Stable_Vector_Const_Iterator temp = *this;
+		--(*this);
+		return temp;
+	}
+
+	_Stable_Vector_Const_Iterator& operator-=(const difference_type diff) noexcept {
+		return *this += -diff;
+	}
+
+	_Stable_Vector_Const_Iterator operator-(const difference_type diff) const noexcept {
+		_Stable_Vector_Const_Iterator temp = *this;
+		temp -= diff;
+		return temp;
+	}
+
+	pointer operator->() const noexcept {
+		CUSTOM_ASSERT(_Index < _RefData->_Size, "Cannot access end iterator.");
+		return _Ptr;
+	}
+
+	reference operator*() const noexcept {
+		CUSTOM_ASSERT(_Index < _RefData->_Size, "Cannot dereference end iterator.");
+		return *_Ptr;
+	}
+
+	reference operator[](const difference_type diff) const noexcept {
+        return *(*this + diff);
+    }
+
+	bool operator==(const _Stable_Vector_Const_Iterator& other) const noexcept {
+		return _Index == other._Index;
+	}
+
+	bool operator!=(const _Stable_Vector_Const_Iterator& other) const noexcept {
+		return !(*this == other);
+	}
+
+	difference_type operator-(const _Stable_Vector_Const_Iterator& other) const noexcept {
+		return static_cast<difference_type>(_Index - other._Index);
+	}
+
+	bool operator<(const _Stable_Vector_Const_Iterator& other) const noexcept {
+		return _Index < other._Index;
+	}
+
+	bool operator>(const _Stable_Vector_Const_Iterator& other) const noexcept {
+		return other < *this;
+	}
+
+	bool operator<=(const _Stable_Vector_Const_Iterator& other) const noexcept {
+		return !(other < *this);
+	}
+
+	bool operator>=(const _Stable_Vector_Const_Iterator& other) const noexcept {
+		return !(*this < other);
+	}
+
+public:
+
+	size_t get_index() const noexcept {
+		return _Index;
+	}
+
+	bool is_begin() const noexcept {
+		return _Index == 0;
+	}
+
+	bool is_end() const noexcept {
+		return _Index == _RefData->_Size;
+	}
+
+	friend void _verify_range(const _Stable_Vector_Const_Iterator& first, const _Stable_Vector_Const_Iterator& last) noexcept {
+		CUSTOM_ASSERT(first._RefData == last._RefData, "stable_vector iterators in range are from different containers");
+		CUSTOM_ASSERT(first._Index <= last._Index, "stable_vector iterator range transposed");
+	}
+
+	pointer _segment_first() const noexcept {
+		return _Ptr;
+	}
+
+	pointer _segment_last(const _Stable_Vector_Const_Iterator& last) const noexcept {
+		return _Ptr + (custom::min)(static_cast<size_t>(_SegLast - _Ptr), last._Index - _Index);
+	}
+
+private:
+
+	void _seek(const size_t index) noexcept {								// Point at index, null segment when index is past the allocated segments
+		_Index = index;
+
+		const size_t segment = _Data::segment_of(index);
+		if (segment < _RefData->_SegmentCount)
+		{
+			_SegFirst	= _RefData->_Segments[segment];
+			_SegLast	= _SegFirst + _Data::segment_size(segment);
+			_Ptr		= _SegFirst + (index - _Data::segment_begin(segment));
+		}
+		else
+		{
+			_SegFirst	= nullptr;
+			_SegLast	= nullptr;
+			_Ptr		= nullptr;
+		}
+	}
+}; // END _Stable_Vector_Const_Iterator
+
+template<class StableVecData>
+class _Stable_Vector_Iterator : public _Stable_Vector_Const_Iterator<StableVecData>		// stable_vector iterator
+{
+private:
+	using _Base				= _Stable_Vector_Const_Iterator<StableVecData>;
+	using _Data				= StableVecData;
+
+public:
+    using iterator_category	= random_access_iterator_tag;
+	using value_type 		= typename _Data::value_type;
+	using difference_type 	= typename _Data::difference_type;
+	using reference			= typename _Data::reference;
+	using pointer			= typename _Data::pointer;
+
+public:
+
+	_Stable_Vector_Iterator() noexcept = default;
+
+	explicit _Stable_Vector_Iterator(size_t index, const _Data* data) noexcept
+		:_Base(index, data) { /*Empty*/ }
+
+	_Stable_Vector_Iterator& operator++() noexcept {
+		_Base::operator++();
+		return *this;
+	}
+
+	_Stable_Vector_Iterator operator++(int) noexcept {
+		_Stable_Vector_Iterator temp = *this;
+		_Base::operator++();
+		return temp;
+	}
+
+	_Stable_Vector_Iterator& operator+=(const difference_type diff) noexcept {
+		_Base::operator+=(diff);
+		return *this;
+	}
+
+	_Stable_Vector_Iterator operator+(const difference_type diff) const noexcept {
+		_Stable_Vector_Iterator temp = *this;
+		temp += diff;
+		return temp;
+	}
+
+	_Stable_Vector_Iterator& operator--() noexcept {
+		_Base::operator--();
+		return *this;
+	}
+
+	_Stable_Vector_Iterator operator--(int) noexcept {
+		_Stable_Vector_Iterator temp = *this;
+		_Base::operator--();
+		return temp;
+	}
+
+	_Stable_Vector_Iterator& operator-=(const difference_type diff) noexcept {
+		_Base::operator-=(diff);
+		return *this;
+	}
+
+	_Stable_Vector_Iterator operator-(const difference_type diff) const noexcept {
+		_Stable_Vector_Iterator temp = *this;
+		temp -= diff;
+		return temp;
+	}
+
+	using _Base::operator-;								// iterator difference
+
+	pointer operator->() const noexcept {
+		return const_cast<pointer>(_Base::operator->());
+	}
+
+	reference operator*() const noexcept {
+		return const_cast<reference>(_Base::operator*());
+	}
+
+	reference operator[](const difference_type diff) const noexcept {
+        return const_cast<reference>(_Base::operator[](diff));
+    }
+
+	pointer _segment_first() const noexcept {
+		return const_cast<pointer>(_Base::_segment_first());
+	}
+
+	pointer _segment_last(const _Stable_Vector_Iterator& last) const noexcept {
+		return const_cast<pointer>(_Base::_segment_last(last));
+	}
+}; // END _Stable_Vector_Iterator
+
+
+template<class Type, class Alloc = custom::allocator<Type>>
+class stable_vector			// stable_vector Template implemented as geometrically growing segments
+{
+	// Growth appends a segment twice the size of the previous one and never moves existing elements,
+	// so pointers, references and iterators stay valid until their element is removed.
+	// Elements are added and removed only at the back.
+
+private:
+	using _Data						= _Stable_Vector_Data<Type, Alloc>;
+	using _Alloc_Traits				= typename _Data::_Alloc_Traits;
+
+public:
+	static_assert(is_same_v<Type, typename Alloc::value_type>, "Object type and allocator type must be the same!");
+	static_assert(is_object_v<Type>, "Containers require object type!");
+
+	using value_type				= typename _Data::value_type;
+	using difference_type			= typename _Data::difference_type;
+	using reference					= typename _Data::reference;
+	using const_reference			= typename _Data::const_reference;
+	using pointer					= typename _Data::pointer;
+	using const_pointer				= typename _Data::const_pointer;
+	using allocator_type			= Alloc;
+
+	using iterator					= _Stable_Vector_Iterator<_Data>;
+	using const_iterator			= _Stable_Vector_Const_Iterator<_Data>;
+	using reverse_iterator			= custom::reverse_iterator<iterator>;
+	using const_reverse_iterator	= custom::reverse_iterator<const_iterator>;
+
+private:
+	_Data _data;															// Actual container data
+	allocator_type _alloc;													// allocator for segments
+
+public:
+	// Constructors
+
+	stable_vector() noexcept = default;
+
+	stable_vector(const size_t newSize) {									// Add multiple default copies Constructor
+		resize(newSize);
+	}
+
+	stable_vector(	const size_t newSize,
+					const value_type& copyValue) {							// Add multiple copies Constructor
+		resize(newSize, copyValue);
+	}
+
+	stable_vector(std::initializer_list<value_type> list) {
+		reserve(list.size());
+		for (const auto& val : list)
+			push_back(val);
+	}
+
+	template<class Iter, enable_if_t<is_iterator_v<Iter>, bool> = true>
+	stable_vector(Iter first, Iter last) {
+		for (/*Empty*/; first != last; ++first)
+			emplace_back(*first);
+	}
+
+	stable_vector(const stable_vector& other) {								// Copy Constructor
+		_copy(other);
+	}
+
+	stable_vector(stable_vector&& other) noexcept {							// Move Constructor, the segments change owner
+		_move(custom::move(other));
+	}
+
+	~stable_vector() noexcept {												// Destructor
+		_clean_up_segments();
+	}
+
+public:
+	// Operators
+
+	const_reference operator[](const size_t index) const noexcept {			// Acces object at index (read only)
+		CUSTOM_ASSERT(index < size(), "Index out of bounds.");
+		return *_data.element(index);
+	}
+
+	reference operator[](const size_t index) noexcept {						// Acces object at index
+		CUSTOM_ASSERT(index < size(), "Index out of bounds.");
+		return *_data.element(index);
+	}
+
+	stable_vector& operator=(const stable_vector& other) {					// Assign operator using reference
+		if (this != &other)
+		{
+			_clean_up_segments();
+			_copy(other);
+		}
+
+		return *this;
+	}
+
+	stable_vector& operator=(stable_vector&& other) noexcept {				// Assign operator using temporary
+		if (this != &other)
+		{
+			_clean_up_segments();
+			_move(custom::move(other));
+		}
+
+		return *this;
+	}
+
+public:
+	// Main functions
+
+	void reserve(const size_t newCapacity) {								// Allocate segments up front, existing elements stay in place
+		while (capacity() < newCapacity)
+			_add_segment();
+	}
+
+	void shrink_to_fit() {													// Free the segments past the last element
+		while (_data._SegmentCount > 0 && _Data::segment_begin(_data._SegmentCount - 1) >= size())
+		{
+			--_data._SegmentCount;
+			_alloc.deallocate(_data._Segments[_data._SegmentCount], _Data::segment_size(_data._SegmentCount));
+			_data._Segments[_data._SegmentCount] = nullptr;
+		}
+	}
+
+	void resize(const size_t newSize) {										// Change size and Construct/Destruct objects with default value if needed
+		while (size() > newSize)
+			pop_back();
+
+		reserve(newSize);
+		while (size() < newSize)
+			emplace_back();
+	}
+
+	void resize(const size_t newSize, const value_type& copyValue) {		// Change size and Construct/Destruct objects with given reference if needed
+		while (size() > newSize)
+			pop_back();
+
+		reserve(newSize);
+		while (size() < newSize)
+			push_back(copyValue);
+	}
+
+	template<class... Args>
+	void emplace_back(Args&&... args) {										// Construct object using arguments (Args) and add it to the tail
+		if (_data._Size == capacity())
+			_add_segment();													// nothing moves, so args may still refer to elements
+
+		_Alloc_Traits::construct(_alloc, _data.element(_data._Size), custom::forward<Args>(args)...);
+		++_data._Size;
+	}
+
+	void push_back(const value_type& copyValue) {							// Construct object using reference and add it to the tail
+		emplace_back(copyValue);
+	}
+
+	void push_back(value_type&& moveValue) {								// Construct object using temporary and add it to the tail
+		emplace_back(custom::move(moveValue));
+	}
+
+	void pop_back() {														// Remove last component, its segment is kept
+		if (!empty())
+			_Alloc_Traits::destroy(_alloc, _data.element(--_data._Size));
+	}
+
+	void clear() {															// Remove ALL components but keep segments
+		while (!empty())
+			pop_back();
+	}
+
+	size_t capacity() const noexcept {
+		return _data.capacity();
+	}
+
+	size_t size() const noexcept {
+		return _data._Size;
+	}
+
+	size_t max_size() const noexcept {
+		return (custom::min)(	static_cast<size_t>((numeric_limits<difference_type>::max)()),
+								_Alloc_Traits::max_size(_alloc));
+	}
+
+	bool empty() const noexcept {
+		return _data._Size == 0;
+	}
+
+	size_t segment_count() const noexcept {									// Allocated segments
+		return _data._SegmentCount;
+	}
+
+	const_reference at(const size_t index) const {							// Acces object at index with check (read only)
+		if (index >= size())
+			throw std::out_of_range("Index out of bounds.");
+
+		return *_data.element(index);
+	}
+
+	reference at(const size_t index) {										// Acces object at index with check
+		if (index >= size())
+			throw std::out_of_range("Index out of bounds.");
+
+		return *_data.element(index);
+	}
+
+	const_reference front() const noexcept {
+		CUSTOM_ASSERT(!empty(), "Container is empty.");
+		return *_data._Segments[0];
+	}
+
+	reference front() noexcept {											// Get the value of the first component
+		CUSTOM_ASSERT(!empty(), "Container is empty.");
+		return *_data._Segments[0];
+	}
+
+	const_reference back() const noexcept {
+		CUSTOM_ASSERT(!empty(), "Container is empty.");
+		return *_data.element(_data._Size - 1);
+	}
+
+	reference back() noexcept {												// Get the value of the last component
+		CUSTOM_ASSERT(!empty(), "Container is empty.");
+		return *_data.element(_data._Size - 1);
+	}
+
+public:
+	// iterator specific functions
+
+	iterator begin() noexcept {
+		return iterator(0, &_data);
+	}
+
+	const_iterator begin() const noexcept {
+		return const_iterator(0, &_data);
+	}
+
+	reverse_iterator rbegin() noexcept {
+		return reverse_iterator(end());
+	}
+
+	const_reverse_iterator rbegin() const noexcept {
+		return const_reverse_iterator(end());
+	}
+
+	iterator end() noexcept {
+		return iterator(_data._Size, &_data);
+	}
+
+	const_iterator end() const noexcept {
+		return const_iterator(_data._Size, &_data);
+	}
+
+	reverse_iterator rend() noexcept {
+		return reverse_iterator(begin());
+	}
+
+	const_reverse_iterator rend() const noexcept {
+		return const_reverse_iterator(begin());
+	}
+
+private:
+	// Helpers
+
+	void _add_segment() {
+		if (_data._SegmentCount == _Data::_MAX_SEGMENTS)
+			throw std::length_error("stable_vector too long.");
+
+		_data._Segments[_data._SegmentCount] = _alloc.allocate(_Data::segment_size(_data._SegmentCount));
+		++_data._SegmentCount;
+	}
+
+	void _copy(const stable_vector& other) {								// Generic copy function for stable_vector
+		reserve(other.size());
+		for (const auto& val : other)
+			push_back(val);
+	}
+
+	void _move(stable_vector&& other) noexcept {							// Generic move function for stable_vector
+		for (size_t segment = 0; segment < other._data._SegmentCount; ++segment)
+			_data._Segments[segment] = custom::exchange(other._data._Segments[segment], nullptr);
+
+		_data._SegmentCount	= custom::exchange(other._data._SegmentCount, 0);
+		_data._Size			= custom::exchange(other._data._Size, 0);
+	}
+
+	void _clean_up_segments() noexcept {									// Clear and Deallocate every segment
+		clear();
+		shrink_to_fit();
+	}
+}; // END stable_vector Template
+
+
+// stable_vector binary operators
+template<class _Type, class _Alloc>
+bool operator==(const stable_vector<_Type, _Alloc>& left, const stable_vector<_Type, _Alloc>& right) {
+	if (left.size() != right.size())
+		return false;
+
+	return custom::equal(left.begin(), left.end(), right.begin());
+}
+
+template<class _Type, class _Alloc>
+bool operator!=(const stable_vector<_Type, _Alloc>& left, const stable_vector<_Type, _Alloc>& right) {
+	return !(left == right);
+}
+
+CUSTOM_END
\ No newline at end of file
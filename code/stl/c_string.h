@@ -56,23 +56,45 @@ inline std::wistream& operator>>(std::wistream& is, wstring& wstring) {
 
 
 // basic_string Helpers
+// comparisons and hash work through basic_string_view, so they are transparent:
+// containers can be searched with basic_string, basic_string_view or const Type* without a temporary string
 template<class Type, class Alloc, class Traits>
 struct less<basic_string<Type, Alloc, Traits>>		// used by map, set
 {
-	constexpr bool operator()(	const basic_string<Type, Alloc, Traits>& left,
-								const basic_string<Type, Alloc, Traits>& right) const {
+	constexpr bool operator()(	const basic_string_view<Type, Traits> left,
+								const basic_string_view<Type, Traits> right) const {
 
 		return left.compare(right) < 0;
 	}
+
+	using is_transparent = int;
+};
+
+template<class Type, class Alloc, class Traits>
+struct equal_to<basic_string<Type, Alloc, Traits>>	// used by unordered_map, unordered_set
+{
+	constexpr bool operator()(	const basic_string_view<Type, Traits> left,
+								const basic_string_view<Type, Traits> right) const {
+
+		return left == right;
+	}
+
+	using is_transparent = int;
 };
 
 template<class Type, class Alloc, class Traits>
 struct hash<basic_string<Type, Alloc, Traits>>
 : _Base_Hash_Enabler<basic_string<Type, Alloc, Traits>, is_char_v<Type>>	// used by unordered_map, unordered_set
 {
-	static size_t compute_hash(const basic_string<Type, Alloc, Traits>& key) noexcept {
-		return detail::_hash_array_representation(key.c_str(), key.size());
+	static size_t compute_hash(const basic_string_view<Type, Traits> key) noexcept {	// same value as hash<basic_string_view>
+		return detail::_hash_array_representation(key.data(), key.size());
 	}
+
+	size_t operator()(const basic_string_view<Type, Traits> key) const noexcept {
+		return compute_hash(key);
+	}
+
+	using is_transparent = int;
 };
 
 CUSTOM_END
\ No newline at end of file
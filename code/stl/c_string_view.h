@@ -30,23 +30,44 @@ inline std::wostream& operator<<(std::wostream& os, const wstring_view& wstringV
 
 
 // basic_string_view Helpers
+// transparent: anything convertible to basic_string_view can be looked up
 template<class Type, class Traits>
 struct less<basic_string_view<Type, Traits>>		// used by map, set
 {
-	constexpr bool operator()(	const basic_string_view<Type, Traits>& left,
-								const basic_string_view<Type, Traits>& right) const {
+	constexpr bool operator()(	const basic_string_view<Type, Traits> left,
+								const basic_string_view<Type, Traits> right) const {
 
 		return left.compare(right) < 0;
 	}
+
+	using is_transparent = int;
+};
+
+template<class Type, class Traits>
+struct equal_to<basic_string_view<Type, Traits>>	// used by unordered_map, unordered_set
+{
+	constexpr bool operator()(	const basic_string_view<Type, Traits> left,
+								const basic_string_view<Type, Traits> right) const {
+
+		return left == right;
+	}
+
+	using is_transparent = int;
 };
 
 template<class Type, class Traits>
 struct hash<basic_string_view<Type, Traits>>
 : _Base_Hash_Enabler<basic_string_view<Type, Traits>, is_char_v<Type>>	// used by unordered_map, unordered_set
 {
-	static size_t compute_hash(const basic_string_view<Type, Traits>& key) noexcept {
+	static size_t compute_hash(const basic_string_view<Type, Traits> key) noexcept {
 		return detail::_hash_array_representation(key.data(), key.size());
 	}
+
+	size_t operator()(const basic_string_view<Type, Traits> key) const noexcept {
+		return compute_hash(key);
+	}
+
+	using is_transparent = int;
 };
 
 CUSTOM_END
\ No newline at end of file
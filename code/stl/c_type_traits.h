@@ -988,6 +988,33 @@ struct is_nothrow_destructible : _Is_Nothrow_Destructible<Ty>::type {};
 template<class Ty>
 constexpr bool is_nothrow_destructible_v = is_nothrow_destructible<Ty>::value;
 
+// is trivially destructible
+#if defined __has_builtin
+#if __has_builtin(__is_trivially_destructible)
+#define _CUSTOM_HAS_IS_TRIVIALLY_DESTRUCTIBLE 1
+#endif
+#endif
+
+#if defined _MSC_VER || defined _CUSTOM_HAS_IS_TRIVIALLY_DESTRUCTIBLE
+template<class Ty>
+struct is_trivially_destructible : bool_constant<__is_trivially_destructible(Ty)> {};
+#elif defined __GNUG__
+template<class Ty>
+struct is_trivially_destructible : bool_constant<is_destructible_v<Ty> && __has_trivial_destructor(Ty)> {};	// GCC before 14 has no __is_trivially_destructible
+#else
+#error No "is_trivially_destructible" implementation
+#endif  // is trivially destructible
+
+template<class Ty>
+constexpr bool is_trivially_destructible_v = is_trivially_destructible<Ty>::value;
+
+// is trivially relocatable (move construct + destroy the source == copy the bytes)
+template<class Ty>
+struct is_trivially_relocatable : bool_constant<is_trivially_copyable_v<Ty> && is_trivially_destructible_v<Ty>> {};	// specialize for types that opt in
+
+template<class Ty>
+constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<remove_cv_t<Ty>>::value;
+
 // is swappable helpers
 template<class Ty>
 struct is_swappable;
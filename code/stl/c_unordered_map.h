@@ -14,6 +14,9 @@ public:
 	using value_type		= pair<Key, Type>;
 	using allocator_type	= Alloc;
 
+	template<class... Args>
+	using _In_Place_Key_Extractor = _In_Place_Key_Extract_Map<Key, Args...>;
+
 public:
 
 	_Umap_Traits() = default;
@@ -55,6 +58,9 @@ public:
 	using iterator			= typename _Base::iterator;
 	using const_iterator 	= typename _Base::const_iterator;
 
+	using node_type			= typename _Base::node_type;
+	using insert_return_type	= typename _Base::insert_return_type;
+
 public:
 	// Constructors
 
@@ -109,6 +115,16 @@ public:
 		return this->_try_emplace(custom::move(key), custom::forward<Args>(args)...);
 	}
 
+	template<class Obj>
+	pair<iterator, bool> insert_or_assign(const key_type& key, Obj&& obj) {	// Insert if key is missing, assign mapped value otherwise
+		return _insert_or_assign(key, custom::forward<Obj>(obj));
+	}
+
+	template<class Obj>
+	pair<iterator, bool> insert_or_assign(key_type&& key, Obj&& obj) {
+		return _insert_or_assign(custom::move(key), custom::forward<Obj>(obj));
+	}
+
 	const mapped_type& at(const key_type& key) const {			// Access value at key with check
 		return this->_at(key);
 	}
@@ -116,6 +132,19 @@ public:
 	mapped_type& at(const key_type& key) {
 		return this->_at(key);
 	}
+
+private:
+	// Helpers
+
+	template<class _KeyType, class Obj>
+	pair<iterator, bool> _insert_or_assign(_KeyType&& key, Obj&& obj) {
+		pair<iterator, bool> result = this->_try_emplace(custom::forward<_KeyType>(key), custom::forward<Obj>(obj));
+
+		if (!result.second)		// obj was not consumed by construction
+			result.first->second = custom::forward<Obj>(obj);
+
+		return result;
+	}
 }; // END unordered_map Template
 
 CUSTOM_END
\ No newline at end of file
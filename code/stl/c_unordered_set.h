@@ -14,6 +14,9 @@ public:
 	using value_type		= mapped_type;
 	using allocator_type	= Alloc;
 
+	template<class... Args>
+	using _In_Place_Key_Extractor = _In_Place_Key_Extract_Set<Key, Args...>;
+
 public:
 
 	_Uset_Traits() = default;
@@ -55,6 +58,9 @@ public:
 	using iterator			= typename _Base::iterator;
 	using const_iterator	= typename _Base::const_iterator;
 
+	using node_type			= typename _Base::node_type;
+	using insert_return_type	= typename _Base::insert_return_type;
+
 public:
 	// Constructors
 
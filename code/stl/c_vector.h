@@ -3,6 +3,7 @@
 #include "c_utility.h"
 #include "c_algorithm.h"
 #include "c_iterator.h"
+#include "x_vector_storage.h"
 
 
 CUSTOM_BEGIN
@@ -117,6 +118,26 @@ public:
 		return !(*this == other);
 	}
 
+	constexpr difference_type operator-(const _Vector_Const_Iterator& other) const noexcept {
+		return static_cast<difference_type>(_Ptr - other._Ptr);
+	}
+
+	constexpr bool operator<(const _Vector_Const_Iterator& other) const noexcept {
+		return _Ptr < other._Ptr;
+	}
+
+	constexpr bool operator>(const _Vector_Const_Iterator& other) const noexcept {
+		return other < *this;
+	}
+
+	constexpr bool operator<=(const _Vector_Const_Iterator& other) const noexcept {
+		return !(other < *this);
+	}
+
+	constexpr bool operator>=(const _Vector_Const_Iterator& other) const noexcept {
+		return !(*this < other);
+	}
+
 public:
 
 	constexpr size_t get_index() const noexcept {					// Get the position for the element in array from iterator
@@ -202,6 +223,8 @@ public:
 		return temp;
 	}
 
+	using _Base::operator-;								// iterator difference
+
 	constexpr pointer operator->() const noexcept {
 		return const_cast<pointer>(_Base::operator->());
 	}
@@ -246,6 +269,14 @@ private:
 	
 	static constexpr size_t _DEFAULT_CAPACITY = 8;
 
+	using _Storage								= detail::_Vector_Storage_Traits<allocator_type>;
+
+	static constexpr bool _Copy_Bytes			= _Storage::_Copy_Bytes;
+	static constexpr bool _Relocate_Bytes		= _Storage::_Relocate_Bytes;
+
+	static constexpr bool _Large_Blocks			= is_same_v<allocator_type, allocator<value_type>> && (CUSTOM_LARGE_ALLOCATION_THRESHOLD > 0);
+	static constexpr bool _Remap_Blocks			= _Large_Blocks && _Relocate_Bytes && large_allocator<value_type>::can_reallocate;
+
 public:
 	// Constructors
 
@@ -318,13 +349,25 @@ public:
 
 	constexpr void reserve(const size_t newCapacity) {							// Allocate memory and move values if needed
 		if (newCapacity < size())
+		{
+			detail::_destroy_range(_alloc, _data._First + newCapacity, size() - newCapacity);
 			_data._Last = _data._First + newCapacity;
+		}
+
+		if (_remap_in_place(newCapacity))
+			return;
 
-		value_type* newArray 	= _alloc.allocate(newCapacity);
+		value_type* newArray 	= _allocate(newCapacity);
 		size_t newSize			= size();
 
-		for (size_t i = 0; i < newSize; ++i)
-			_Alloc_Traits::construct(_alloc, &newArray[i], custom::move(_data._First[i]));
+		if (_Relocate_Bytes && !custom::is_constant_evaluated())
+		{
+			detail::_copy_bytes(newArray, _data._First, newSize);
+			_data._Last = _data._First;											// old bytes now belong to newArray, nothing to destroy
+		}
+		else
+			for (size_t i = 0; i < newSize; ++i)
+				_Alloc_Traits::construct(_alloc, &newArray[i], custom::move(_data._First[i]));
 
 		_clean_up_array();
 		_data._First	= newArray;
@@ -339,31 +382,29 @@ public:
 	constexpr void realloc(const size_t newCapacity) {							// Allocate memory and populate it with default values (delete old)
 		_clean_up_array();
 
-		_data._First	= _alloc.allocate(newCapacity);
+		_data._First	= _allocate(newCapacity);
 		_data._Last		= _data._First + newCapacity;
 		_data._Final	= _data._First + newCapacity;
-		_construct_range(_data._First, newCapacity);
+		detail::_construct_range(_alloc, _data._First, newCapacity);
 	}
 
 	constexpr void realloc(	const size_t newCapacity,
 							const value_type& copyValue) {						// Allocate memory and populate it with given reference (delete old)
 		_clean_up_array();
 
-		_data._First	= _alloc.allocate(newCapacity);
+		_data._First	= _allocate(newCapacity);
 		_data._Last		= _data._First + newCapacity;
 		_data._Final	= _data._First + newCapacity;
-		_construct_range(_data._First, newCapacity, copyValue);
+		detail::_construct_range(_alloc, _data._First, newCapacity, copyValue);
 	}
 	
 	constexpr void resize(const size_t newSize) {								// Change size and Construct/Destruct objects with default value if needed
 		if (newSize < size())
-			_destroy_range(_data._First + newSize, size() - newSize);
+			detail::_destroy_range(_alloc, _data._First + newSize, size() - newSize);
 		else
 		{
-			if (newSize > capacity())
-				reserve(newSize);
-
-			_construct_range(_data._Last, newSize - size());
+			_extend_to(newSize);
+			detail::_construct_range(_alloc, _data._Last, newSize - size());
 		}
 
 		_data._Last = _data._First + newSize;
@@ -371,18 +412,35 @@ public:
 
 	constexpr void resize(const size_t newSize, const value_type& copyValue) {	// Change size and Construct/Destruct objects with given reference if needed
 		if (newSize < size())
-			_destroy_range(_data._First + newSize, size() - newSize);
+			detail::_destroy_range(_alloc, _data._First + newSize, size() - newSize);
 		else
 		{
-			if (newSize > capacity())
-				reserve(newSize);
-
-			_construct_range(_data._Last, newSize - size(), copyValue);
+			_extend_to(newSize);
+			detail::_construct_range(_alloc, _data._Last, newSize - size(), copyValue);
 		}
 
 		_data._Last = _data._First + newSize;
 	}
 
+	constexpr void resize_for_overwrite(const size_t newSize) {					// Change size, new elements are left uninitialized
+		static_assert(is_trivial_v<value_type>, "resize_for_overwrite requires a trivial type.");
+
+		_extend_to(newSize);
+		_data._Last = _data._First + newSize;
+	}
+
+	template<class Operation>
+	constexpr void resize_and_overwrite(const size_t count, Operation op) {		// op(data(), count) writes up to count elements and returns the new size
+		static_assert(is_trivial_v<value_type>, "resize_and_overwrite requires a trivial type.");
+
+		_extend_to(count);
+
+		const size_t newSize = static_cast<size_t>(custom::move(op)(_data._First, count));
+		CUSTOM_ASSERT(newSize <= count, "resize_and_overwrite operation returned a size past count.");
+
+		_data._Last = _data._First + newSize;
+	}
+
 	template<class... Args>
 	constexpr void emplace_back(Args&&... args) {								// Construct object using arguments (Args) and add it to the tail
 		_extend_if_full();
@@ -405,13 +463,16 @@ public:
 	template<class... Args>
 	constexpr iterator emplace(const_iterator where, Args&&... args) {		// Emplace object at where position with given arguments
 		size_t index = where.get_index();	// Don't check end()
-		emplace_back();
 
-		for (size_t i = size() - 1; i > index; --i)
-			_data._First[i] = custom::move(_data._First[i - 1]);
+		if (index == size())
+		{
+			emplace_back(custom::forward<Args>(args)...);
+			return iterator(_data._First + index, &_data);
+		}
 
-		_Alloc_Traits::destroy(_alloc, _data._First + index);
-		_Alloc_Traits::construct(_alloc, _data._First + index, custom::forward<Args>(args)...);
+		value_type value(custom::forward<Args>(args)...);						// args may refer to elements that are about to move
+		_open_gap(index, 1);
+		detail::_fill_gap(_alloc, _data, index, 1, &value, true_type{});
 
 		return iterator(_data._First + index, &_data);
 	}
@@ -424,20 +485,95 @@ public:
 		return emplace(where, custom::move(moveValue));
 	}
 
+	constexpr iterator insert(const_iterator where, const size_t count, const value_type& copyValue) {	// Push count copies at iterator position
+		size_t index = where.get_index();
+		if (count == 0)
+			return iterator(_data._First + index, &_data);
+
+		value_type value(copyValue);												// copyValue may be an element of this vector
+		_open_gap(index, count);
+		detail::_fill_gap_n(_alloc, _data, index, count, value);
+
+		return iterator(_data._First + index, &_data);
+	}
+
+	template<class Iter, enable_if_t<is_iterator_v<Iter>, bool> = true>
+	constexpr iterator insert(const_iterator where, Iter first, Iter last) {			// Push range at iterator position, the range must not come from this vector
+		size_t index = where.get_index();
+
+		if constexpr (is_forward_iterator_v<Iter>)
+		{
+			const size_t count = static_cast<size_t>(custom::distance(first, last));
+			if (count != 0)
+			{
+				_open_gap(index, count);
+				detail::_fill_gap(_alloc, _data, index, count, first, false_type{});
+			}
+		}
+		else																		// single pass, append then rotate into place once
+		{
+			const size_t oldSize = size();
+			for (/*Empty*/; first != last; ++first)
+				emplace_back(*first);
+
+			custom::rotate(_data._First + index, _data._First + oldSize, _data._Last);
+		}
+
+		return iterator(_data._First + index, &_data);
+	}
+
+	constexpr iterator insert(const_iterator where, std::initializer_list<value_type> list) {
+		return insert(where, list.begin(), list.end());
+	}
+
 	constexpr iterator erase(const_iterator where) {									// Remove component at iterator position
 		if (where.is_end())
 			throw std::out_of_range("vector erase iterator outside range.");
 
-		size_t index = where.get_index();
-		size_t beforeLast = size() - 1;
+		return erase(where, where + 1);
+	}
 
-		for (size_t i = index; i < beforeLast; ++i)
-			_data._First[i] = custom::move(_data._First[i + 1]);
-		pop_back();
+	constexpr iterator erase(const_iterator first, const_iterator last) {				// Remove components in [first, last)
+		_verify_range(first, last);
 
+		size_t index = first.get_index();
+		size_t count = last.get_index() - index;
+
+		detail::_erase_gap(_alloc, _data, index, count);
 		return iterator(_data._First + index, &_data);
 	}
 
+	constexpr void assign(const size_t count, const value_type& copyValue) {			// Replace content with count copies
+		value_type value(copyValue);													// copyValue may be an element of this vector
+		clear();
+
+		if (count > capacity())
+			reserve(count);
+
+		detail::_construct_range(_alloc, _data._First, count, value);
+		_data._Last = _data._First + count;
+	}
+
+	template<class Iter, enable_if_t<is_iterator_v<Iter>, bool> = true>
+	constexpr void assign(Iter first, Iter last) {									// Replace content with range, reusing existing elements
+		if constexpr (is_forward_iterator_v<Iter>)
+		{
+			const size_t count = static_cast<size_t>(custom::distance(first, last));
+			if (count > capacity())
+			{
+				clear();
+				reserve(count);													// grow once, nothing to move
+			}
+		}
+
+		for (first = detail::_assign_live(_alloc, _data, first, last); first != last; ++first)
+			emplace_back(*first);
+	}
+
+	constexpr void assign(std::initializer_list<value_type> list) {
+		assign(list.begin(), list.end());
+	}
+
 	constexpr size_t capacity() const noexcept {								// Get capacity
 		return static_cast<size_t>(_data._Final - _data._First);
 	}
@@ -456,7 +592,7 @@ public:
 	}
 	
 	constexpr void clear() {													// Remove ALL components but keep memory
-		_destroy_range(_data._First, size());
+		detail::_destroy_range(_alloc, _data._First, size());
 		_data._Last = _data._First;
 	}
 
@@ -494,11 +630,11 @@ public:
 		return _data._Last[-1];
 	}
 
-	constexpr const_reference data() const noexcept  {
+	constexpr const_pointer data() const noexcept  {
 		return _data._First;
 	}
 
-	constexpr reference data() noexcept {
+	constexpr pointer data() noexcept {
 		return _data._First;
 	}
 
@@ -541,11 +677,14 @@ private:
 	// Helpers
 
 	constexpr void _copy(const vector& other) {									// Generic copy function for vector
-		_data._First	= _alloc.allocate(other.capacity());
+		_data._First	= _allocate(other.capacity());
 		size_t newSize	= other.size();
 
-		for (size_t i = 0; i < newSize; ++i)
-			_Alloc_Traits::construct(_alloc, &_data._First[i], other._data._First[i]);
+		if (_Copy_Bytes && !custom::is_constant_evaluated())
+			detail::_copy_bytes(_data._First, other._data._First, newSize);
+		else
+			for (size_t i = 0; i < newSize; ++i)
+				_Alloc_Traits::construct(_alloc, &_data._First[i], other._data._First[i]);
 
 		_data._Last		= _data._First + other.size();
 		_data._Final	= _data._First + other.capacity();
@@ -557,19 +696,83 @@ private:
 		_data._Final 	= custom::exchange(other._data._Final, nullptr);
 	}
 
-	constexpr void _construct_range(value_type* const address, const size_t length) {
-		for (size_t i = 0; i < length; ++i)
-			_Alloc_Traits::construct(_alloc, address + i);
+
+
+	constexpr void _open_gap(const size_t index, const size_t count) {				// Relocate [index, size) count slots up, leaving the gap raw (grows at most once)
+		const size_t oldSize = size();
+
+		if (count > static_cast<size_t>(_data._Final - _data._Last))					// grow at most once
+		{
+			const size_t newCapacity	= (custom::max)(oldSize + count, capacity() + capacity() / 2 + 1);
+
+			if (_remap_in_place(newCapacity))
+			{
+				detail::_open_gap_in_place(_alloc, _data, index, count);
+				return;
+			}
+
+			value_type* newArray		= _allocate(newCapacity);
+
+			if (_Relocate_Bytes && !custom::is_constant_evaluated())
+			{
+				detail::_copy_bytes(newArray, _data._First, index);
+				detail::_copy_bytes(newArray + index + count, _data._First + index, oldSize - index);
+				_data._Last = _data._First;											// old bytes now belong to newArray, nothing to destroy
+			}
+			else
+			{
+				for (size_t i = 0; i < index; ++i)
+					_Alloc_Traits::construct(_alloc, newArray + i, custom::move(_data._First[i]));
+
+				for (size_t i = index; i < oldSize; ++i)
+					_Alloc_Traits::construct(_alloc, newArray + i + count, custom::move(_data._First[i]));
+			}
+
+			_clean_up_array();
+			_data._First	= newArray;
+			_data._Last		= newArray + oldSize + count;
+			_data._Final	= newArray + newCapacity;
+			return;
+		}
+
+		detail::_open_gap_in_place(_alloc, _data, index, count);
+	}
+
+	static constexpr bool _is_large(const size_t capacity) noexcept {
+		return _Large_Blocks && capacity * sizeof(value_type) >= CUSTOM_LARGE_ALLOCATION_THRESHOLD;
 	}
 
-	constexpr void _construct_range(value_type* const address, const size_t length, const value_type& value) {
-		for (size_t i = 0; i < length; ++i)
-			_Alloc_Traits::construct(_alloc, address + i, value);
+	constexpr value_type* _allocate(const size_t capacity) {					// Big arrays of the default allocator go to large_allocator
+		if constexpr (_Large_Blocks)
+			if (_is_large(capacity) && !custom::is_constant_evaluated())
+				return large_allocator<value_type>().allocate(capacity);
+
+		return _alloc.allocate(capacity);
 	}
 
-	constexpr void _destroy_range(value_type* address, const size_t length) {
-		for (size_t i = 0; i < length; ++i)
-			_Alloc_Traits::destroy(_alloc, address + i);
+	constexpr void _deallocate(value_type* const address, const size_t capacity) {	// capacity picks the same allocator as _allocate did
+		if constexpr (_Large_Blocks)
+			if (_is_large(capacity) && !custom::is_constant_evaluated())
+			{
+				large_allocator<value_type>().deallocate(address, capacity);
+				return;
+			}
+
+		_alloc.deallocate(address, capacity);
+	}
+
+	constexpr bool _remap_in_place(const size_t newCapacity) {				// Resize a large array through the kernel, without a second array or a copy
+		if constexpr (_Remap_Blocks)
+			if (_is_large(capacity()) && _is_large(newCapacity) && !custom::is_constant_evaluated())
+			{
+				const size_t oldSize = size();
+				_data._First	= large_allocator<value_type>().reallocate(_data._First, capacity(), newCapacity);
+				_data._Last		= _data._First + oldSize;
+				_data._Final	= _data._First + newCapacity;
+				return true;
+			}
+
+		return false;
 	}
 
 	constexpr void _extend_if_full() {											// Reserve 50% more capacity when full
@@ -577,11 +780,16 @@ private:
 			reserve(capacity() + capacity() / 2 + 1);
 	}
 
+	constexpr void _extend_to(const size_t newSize) {							// Reserve at least newSize, growing by 50% so repeated calls stay amortized
+		if (newSize > capacity())
+			reserve((custom::max)(newSize, capacity() + capacity() / 2 + 1));
+	}
+
 	constexpr void _clean_up_array() {											// Clear and Deallocate array
 		if (_data._First != nullptr)
 		{
-			_destroy_range(_data._First, size());
-			_alloc.deallocate(_data._First, capacity());
+			detail::_destroy_range(_alloc, _data._First, size());
+			_deallocate(_data._First, capacity());
 			_data._First	= nullptr;
 			_data._Last		= nullptr;
 			_data._Final	= nullptr;
@@ -589,6 +797,10 @@ private:
 	}
 }; // END vector Template
 
+template<class Type, class Alloc>
+struct is_trivially_relocatable<vector<Type, Alloc>>			// only owns the heap array
+	: is_trivially_relocatable<Alloc> {};
+
 
 // vector binary operators
 template<class _Type, class _Alloc>
@@ -0,0 +1,1010 @@
+#pragma once
+#include "x_memory.h"
+#include "c_pair.h"
+#include "c_utility.h"
+#include "c_iterator.h"
+#include "c_functional.h"	// for custom::Less
+
+#include <cstring>			// std::memmove
+
+
+CUSTOM_BEGIN
+
+CUSTOM_DETAIL_BEGIN
+
+template<class Value, size_t Capacity>
+struct _BTree_Internal;
+
+template<class Value, size_t Capacity>
+struct _BTree_Leaf				// Node with up to Capacity sorted values, storage past _Count is not constructed
+{
+	_BTree_Internal<Value, Capacity>* _Parent	= nullptr;
+	unsigned short _Position					= 0;		// index in _Parent->_Children
+	unsigned short _Count						= 0;
+	bool _IsLeaf								= true;
+	alignas(Value) unsigned char _Storage[Capacity * sizeof(Value)];
+
+	Value* _value_ptr(const size_t index) noexcept {
+		return reinterpret_cast<Value*>(_Storage) + index;
+	}
+
+	Value& _value(const size_t index) noexcept {
+		return *_value_ptr(index);
+	}
+};
+
+template<class Value, size_t Capacity>
+struct _BTree_Internal : _BTree_Leaf<Value, Capacity>		// Node with _Count + 1 children
+{
+	_BTree_Leaf<Value, Capacity>* _Children[Capacity + 1];
+};
+
+constexpr size_t _btree_capacity(const size_t valueSize, const size_t nodeBytes) noexcept {	// values that fit a node of nodeBytes
+	constexpr size_t header = sizeof(void*) + 2 * sizeof(unsigned short) + sizeof(bool);
+	const size_t capacity	= (nodeBytes > header) ? (nodeBytes - header) / valueSize : 0;
+
+	return (capacity < 3) ? 3 : (capacity > 1024 ? 1024 : capacity);
+}
+
+template<class Traits, size_t NodeBytes>
+struct _BTree_Data
+{
+	using key_type				= typename Traits::key_type;
+	using mapped_type			= typename Traits::mapped_type;
+	using key_compare			= typename Traits::key_compare;
+	using value_type			= typename Traits::value_type;
+	using allocator_type		= typename Traits::allocator_type;
+
+	using _Alloc_Traits			= allocator_traits<allocator_type>;
+
+	static constexpr size_t _CAPACITY	= _btree_capacity(sizeof(value_type), NodeBytes);
+	static constexpr size_t _MIN_COUNT	= (_CAPACITY - 1) / 2;			// fewest values in a non-root node
+
+	using _Leaf					= _BTree_Leaf<value_type, _CAPACITY>;
+	using _Internal				= _BTree_Internal<value_type, _CAPACITY>;
+	using _Alloc_Leaf			= typename _Alloc_Traits::template rebind_alloc<_Leaf>;
+	using _Alloc_Leaf_Traits	= allocator_traits<_Alloc_Leaf>;
+	using _Alloc_Internal		= typename _Alloc_Traits::template rebind_alloc<_Internal>;
+	using _Alloc_Internal_Traits= allocator_traits<_Alloc_Internal>;
+
+	using difference_type		= typename _Alloc_Traits::difference_type;
+	using reference				= typename _Alloc_Traits::reference;
+	using const_reference		= typename _Alloc_Traits::const_reference;
+	using pointer				= typename _Alloc_Traits::pointer;
+	using const_pointer			= typename _Alloc_Traits::const_pointer;
+
+	size_t _Size				= 0;									// Number of values held
+	_Leaf* _Root				= nullptr;								// nullptr while empty
+
+	static _Internal* internal(_Leaf* node) noexcept {
+		CUSTOM_ASSERT(!node->_IsLeaf, "Leaf node has no children.");
+		return static_cast<_Internal*>(node);
+	}
+
+	static _Leaf* leftmost(_Leaf* node) noexcept {					// return leftmost leaf in subtree at node
+		while (!node->_IsLeaf)
+			node = internal(node)->_Children[0];
+
+		return node;
+	}
+
+	static _Leaf* rightmost(_Leaf* node) noexcept {					// return rightmost leaf in subtree at node
+		while (!node->_IsLeaf)
+			node = internal(node)->_Children[node->_Count];
+
+		return node;
+	}
+};	// END _BTree_Data
+
+template<class BTreeData>
+class _BTree_Const_Iterator
+{
+private:
+	using _Data				= BTreeData;
+	using _Leaf				= typename _Data::_Leaf;
+
+public:
+    using iterator_category	= bidirectional_iterator_tag;
+	using value_type 		= typename _Data::value_type;
+	using difference_type	= typename _Data::difference_type;
+	using reference			= typename _Data::const_reference;
+	using pointer			= typename _Data::const_pointer;
+
+	_Leaf* _Ptr				= nullptr;									// nullptr for end
+	size_t _Index			= 0;
+	const _Data* _RefData	= nullptr;
+
+public:
+
+	_BTree_Const_Iterator() noexcept = default;
+
+	explicit _BTree_Const_Iterator(_Leaf* ptr, size_t index, const _Data* data) noexcept
+		:_Ptr(ptr), _Index(index), _RefData(data) { /*Empty*/ }
+
+	_BTree_Const_Iterator& operator++() noexcept {
+		CUSTOM_ASSERT(_Ptr != nullptr, "Cannot increment end iterator.");
+
+		if (!_Ptr->_IsLeaf)												// next is the first value of the right subtree
+		{
+			_Ptr	= _Data::leftmost(_Data::internal(_Ptr)->_Children[_Index + 1]);
+			_Index	= 0;
+		}
+		else if (++_Index == _Ptr->_Count)								// past the leaf, climb to the first unvisited separator
+		{
+			while (_Ptr != nullptr && _Index == _Ptr->_Count)
+			{
+				_Index	= _Ptr->_Position;
+				_Ptr	= _Ptr->_Parent;
+			}
+
+			if (_Ptr == nullptr)
+				_Index = 0;
+		}
+
+		return *this;
+	}
+
+	_BTree_Const_Iterator operator++(int) noexcept {
+		_BTree_Const_Iterator temp = *this;
+		++(*this);
+		return temp;
+	}
+
+	_BTree_Const_Iterator& operator--() noexcept {
+		if (_Ptr == nullptr)
+		{
+			CUSTOM_ASSERT(_RefData->_Root != nullptr, "Cannot decrement begin iterator.");
+			_Ptr	= _Data::rightmost(_RefData->_Root);
+			_Index	= _Ptr->_Count - 1;
+		}
+		else if (!_Ptr->_IsLeaf)										// previous is the last value of the left subtree
+		{
+			_Ptr	= _Data::rightmost(_Data::internal(_Ptr)->_Children[_Index]);
+			_Index	= _Ptr->_Count - 1;
+		}
+		else if (_Index > 0)
+			--_Index;
+		else
+		{
+			while (_Ptr->_Parent != nullptr && _Ptr->_Position == 0)
+				_Ptr = _Ptr->_Parent;
+
+			CUSTOM_ASSERT(_Ptr->_Parent != nullptr, "Cannot decrement begin iterator.");
+			_Index	= _Ptr->_Position - 1;
+			_Ptr	= _Ptr->_Parent;
+		}
+
+		return *this;
+	}
+
+	_BTree_Const_Iterator operator--(int) noexcept {
+		_BTree_Const_Iterator temp = *this;
+		--(*this);
+		return temp;
+	}
+
+	pointer operator->() const noexcept {
+		CUSTOM_ASSERT(_Ptr != nullptr, "Cannot access end iterator.");
+		return pointer_traits<pointer>::pointer_to(**this);
+	}
+
+	reference operator*() const noexcept {
+		CUSTOM_ASSERT(_Ptr != nullptr, "Cannot dereference end iterator.");
+		return _Ptr->_value(_Index);
+	}
+
+	bool operator==(const _BTree_Const_Iterator& other) const noexcept {
+		return _Ptr == other._Ptr && _Index == other._Index;
+	}
+
+	bool operator!=(const _BTree_Const_Iterator& other) const noexcept {
+		return !(*this == other);
+	}
+
+	friend void _verify_range(const _BTree_Const_Iterator& first, const _BTree_Const_Iterator& last) noexcept {
+		CUSTOM_ASSERT(first._RefData == last._RefData, "_BTree iterators in range are from different containers");
+		// No possible way to determine order.
+	}
+}; // END _BTree_Const_Iterator
+
+template<class BTreeData>
+class _BTree_Iterator : public _BTree_Const_Iterator<BTreeData>			// _BTree iterator
+{
+private:
+	using _Base				= _BTree_Const_Iterator<BTreeData>;
+	using _Data 			= BTreeData;
+	using _Leaf				= typename _Data::_Leaf;
+
+public:
+    using iterator_category	= bidirectional_iterator_tag;
+	using value_type 		= typename _Data::value_type;
+	using difference_type	= typename _Data::difference_type;
+	using reference 		= typename _Data::reference;
+	using pointer 			= typename _Data::pointer;
+
+public:
+
+	_BTree_Iterator() noexcept = default;
+
+	explicit _BTree_Iterator(_Leaf* ptr, size_t index, const _Data* data) noexcept
+		:_Base(ptr, index, data) { /*Empty*/ }
+
+	_BTree_Iterator& operator++() noexcept {
+		_Base::operator++();
+		return *this;
+	}
+
+	_BTree_Iterator operator++(int) noexcept {
+		_BTree_Iterator temp = *this;
+		_Base::operator++();
+		return temp;
+	}
+
+	_BTree_Iterator& operator--() noexcept {
+		_Base::operator--();
+		return *this;
+	}
+
+	_BTree_Iterator operator--(int) noexcept {
+		_BTree_Iterator temp = *this;
+		_Base::operator--();
+		return temp;
+	}
+
+	pointer operator->() const noexcept {
+		return const_cast<pointer>(_Base::operator->());
+	}
+
+	reference operator*() const noexcept {
+		return const_cast<reference>(_Base::operator*());
+	}
+}; // END _BTree_Iterator
+
+
+template<class Traits, size_t NodeBytes>
+class _BTree			// _BTree Template implemented as B-tree with values in every node
+{
+	// Nodes hold _CAPACITY values in one contiguous block (about NodeBytes), so lookups and scans
+	// touch a few cache lines per level instead of one node per value.
+	// Inserts split full nodes on the way back up. Erases take the predecessor for internal values
+	// and refill underfull nodes from a sibling, or merge with it.
+
+private:
+	using _Data						= _BTree_Data<Traits, NodeBytes>;
+	using _Alloc_Traits				= typename _Data::_Alloc_Traits;
+	using _Leaf						= typename _Data::_Leaf;
+	using _Internal					= typename _Data::_Internal;
+	using _Alloc_Leaf				= typename _Data::_Alloc_Leaf;
+	using _Alloc_Leaf_Traits		= typename _Data::_Alloc_Leaf_Traits;
+	using _Alloc_Internal			= typename _Data::_Alloc_Internal;
+
+	static constexpr size_t _CAPACITY	= _Data::_CAPACITY;
+	static constexpr size_t _MIN_COUNT	= _Data::_MIN_COUNT;
+
+	static constexpr bool _Relocate_Bytes	= is_trivially_relocatable_v<typename _Data::value_type>
+											&& !_Has_Construct_Member_Function<_Alloc_Leaf, typename _Data::value_type>::value
+											&& !_Has_Destroy_Member_Function<_Alloc_Leaf, typename _Data::value_type>::value;
+
+protected:
+    using key_type					= typename _Data::key_type;
+    using mapped_type				= typename _Data::mapped_type;
+    using key_compare				= typename _Data::key_compare;
+	using value_type				= typename _Data::value_type;
+	using difference_type			= typename _Data::difference_type;
+	using reference					= typename _Data::reference;
+	using const_reference			= typename _Data::const_reference;
+	using pointer					= typename _Data::pointer;
+	using const_pointer				= typename _Data::const_pointer;
+	using allocator_type			= typename _Data::allocator_type;
+
+	using iterator					= _BTree_Iterator<_Data>;
+	using const_iterator			= _BTree_Const_Iterator<_Data>;
+	using reverse_iterator			= custom::reverse_iterator<iterator>;
+	using const_reverse_iterator	= custom::reverse_iterator<const_iterator>;
+
+	template<class KeyType>
+	using _Enable_Transparent		= enable_if_t<conjunction_v<			// heterogeneous lookup when key_compare allows it
+													_Is_Transparent<key_compare>,
+													negation<is_convertible<KeyType, const_iterator>>>,
+										bool>;
+
+protected:
+	_Data _data;
+	_Alloc_Leaf _allocLeaf;
+	_Alloc_Internal _allocInternal;
+	key_compare _less;			// Used for comparison
+
+protected:
+	// Constructors
+
+	_BTree() = default;
+
+	_BTree(std::initializer_list<value_type> list) {
+		for (const auto& val : list)
+			emplace(val);
+	}
+
+	_BTree(const _BTree& other) {
+		_copy(other);
+	}
+
+	_BTree(_BTree&& other) noexcept {
+		_move(custom::move(other));
+	}
+
+	virtual ~_BTree() {
+		clear();
+	}
+
+protected:
+	// Operators
+
+	_BTree& operator=(const _BTree& other) {
+		if (this != &other)
+		{
+			clear();
+			_copy(other);
+		}
+
+		return *this;
+	}
+
+	_BTree& operator=(_BTree&& other) noexcept {
+		if (this != &other)
+		{
+			clear();
+			_move(custom::move(other));
+		}
+
+		return *this;
+	}
+
+public:
+    // Main functions
+
+    template<class... Args>
+	iterator emplace(Args&&... args) {								// Constructs the value first, then moves it into a leaf
+		value_type newValue(custom::forward<Args>(args)...);
+		_Leaf* node		= _data._Root;
+		size_t index	= 0;
+
+		if (_find_leaf_slot(Traits::extract_key(newValue), node, index))
+			return iterator(node, index, &_data);
+
+		return _insert_at(node, index, custom::move(newValue));
+	}
+
+	iterator erase(const key_type& key) {
+		return _erase(key);
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	iterator erase(const KeyType& key) {
+		return _erase(key);
+	}
+
+	iterator erase(const_iterator where) {
+		if (where == end())
+			throw std::out_of_range("btree erase iterator outside range.");
+
+		return _erase_at(where._Ptr, where._Index);
+	}
+
+	iterator erase(iterator where) {
+		if (where == end())
+			throw std::out_of_range("btree erase iterator outside range.");
+
+		return _erase_at(where._Ptr, where._Index);
+	}
+
+	const_iterator find(const key_type& key) const {
+		pair<_Leaf*, size_t> found = _find_in_tree(key);
+		return const_iterator(found.first, found.second, &_data);
+	}
+
+	iterator find(const key_type& key) {
+		pair<_Leaf*, size_t> found = _find_in_tree(key);
+		return iterator(found.first, found.second, &_data);
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	const_iterator find(const KeyType& key) const {
+		pair<_Leaf*, size_t> found = _find_in_tree(key);
+		return const_iterator(found.first, found.second, &_data);
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	iterator find(const KeyType& key) {
+		pair<_Leaf*, size_t> found = _find_in_tree(key);
+		return iterator(found.first, found.second, &_data);
+	}
+
+	bool contains(const key_type& key) const {
+		return _find_in_tree(key).first != nullptr;
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	bool contains(const KeyType& key) const {
+		return _find_in_tree(key).first != nullptr;
+	}
+
+	const_iterator lower_bound(const key_type& key) const {			// First value not less than key
+		pair<_Leaf*, size_t> found = _bound_in_tree(key, false);
+		return const_iterator(found.first, found.second, &_data);
+	}
+
+	iterator lower_bound(const key_type& key) {
+		pair<_Leaf*, size_t> found = _bound_in_tree(key, false);
+		return iterator(found.first, found.second, &_data);
+	}
+
+	const_iterator upper_bound(const key_type& key) const {			// First value greater than key
+		pair<_Leaf*, size_t> found = _bound_in_tree(key, true);
+		return const_iterator(found.first, found.second, &_data);
+	}
+
+	iterator upper_bound(const key_type& key) {
+		pair<_Leaf*, size_t> found = _bound_in_tree(key, true);
+		return iterator(found.first, found.second, &_data);
+	}
+
+	size_t size() const noexcept {
+		return _data._Size;
+	}
+
+	size_t max_size() const noexcept {
+		return (custom::min)(static_cast<size_t>((	numeric_limits<difference_type>::max)()),
+													_Alloc_Leaf_Traits::max_size(_allocLeaf) * _MIN_COUNT);
+	}
+
+	bool empty() const noexcept {
+		return _data._Size == 0;
+	}
+
+	void clear() {
+		if (_data._Root != nullptr)
+			_destroy_all(_data._Root);
+
+		_data._Root = nullptr;
+		_data._Size = 0;
+	}
+
+	static constexpr size_t node_capacity() noexcept {				// values per node
+		return _CAPACITY;
+	}
+
+public:
+	// iterator functions
+
+	iterator begin() {
+		return (_data._Root == nullptr) ? end() : iterator(_Data::leftmost(_data._Root), 0, &_data);
+	}
+
+	const_iterator begin() const {
+		return (_data._Root == nullptr) ? end() : const_iterator(_Data::leftmost(_data._Root), 0, &_data);
+	}
+
+	reverse_iterator rbegin() {
+		return reverse_iterator(end());
+	}
+
+	const_reverse_iterator rbegin() const {
+		return const_reverse_iterator(end());
+	}
+
+	iterator end() {
+		return iterator(nullptr, 0, &_data);
+	}
+
+	const_iterator end() const {
+		return const_iterator(nullptr, 0, &_data);
+	}
+
+	reverse_iterator rend() {
+		return reverse_iterator(begin());
+	}
+
+	const_reverse_iterator rend() const {
+		return const_reverse_iterator(begin());
+	}
+
+protected:
+	// Others
+
+	template<class _KeyType, class... Args>
+	pair<iterator, bool> _try_emplace(_KeyType&& key, Args&&... args) {			// Force construction with known key and given arguments for object
+		_Leaf* node		= _data._Root;
+		size_t index	= 0;
+
+		if (_find_leaf_slot(key, node, index))
+			return {iterator(node, index, &_data), false};
+
+		return {_insert_at(	node, index,
+							custom::piecewise_construct,
+							custom::forward_as_tuple(custom::forward<_KeyType>(key)),
+							custom::forward_as_tuple(custom::forward<Args>(args)...)),
+				true};
+	}
+
+	const mapped_type& _at(const key_type& key) const {				// Access _Value at key with check
+		const_iterator it = find(key);
+		if (it == end())
+			throw std::out_of_range("Invalid key.");
+
+		return Traits::extract_mapval(*it);
+	}
+
+	mapped_type& _at(const key_type& key) {
+		iterator it = find(key);
+		if (it == end())
+			throw std::out_of_range("Invalid key.");
+
+		return const_cast<mapped_type&>(Traits::extract_mapval(*it));
+	}
+
+private:
+	// Helpers
+
+	template<class KeyType>
+	size_t _lower_index(_Leaf* node, const KeyType& key) const {		// first value in node not less than key
+		size_t first = 0;
+
+		for (size_t count = node->_Count; count > 0; /*Empty*/)
+		{
+			const size_t step = count / 2;
+
+			if (_less(Traits::extract_key(node->_value(first + step)), key))
+			{
+				first += step + 1;
+				count -= step + 1;
+			}
+			else
+				count = step;
+		}
+
+		return first;
+	}
+
+	template<class KeyType>
+	size_t _upper_index(_Leaf* node, const KeyType& key) const {		// first value in node greater than key
+		size_t first = 0;
+
+		for (size_t count = node->_Count; count > 0; /*Empty*/)
+		{
+			const size_t step = count / 2;
+
+			if (!_less(key, Traits::extract_key(node->_value(first + step))))
+			{
+				first += step + 1;
+				count -= step + 1;
+			}
+			else
+				count = step;
+		}
+
+		return first;
+	}
+
+	template<class KeyType>
+	pair<_Leaf*, size_t> _find_in_tree(const KeyType& key) const {		// {nullptr, 0} if missing
+		for (_Leaf* node = _data._Root; node != nullptr; /*Empty*/)
+		{
+			const size_t index = _lower_index(node, key);
+
+			if (index < node->_Count && !_less(key, Traits::extract_key(node->_value(index))))
+				return {node, index};
+
+			if (node->_IsLeaf)
+				break;
+
+			node = _Data::internal(node)->_Children[index];
+		}
+
+		return {nullptr, 0};
+	}
+
+	template<class KeyType>
+	pair<_Leaf*, size_t> _bound_in_tree(const KeyType& key, const bool upper) const {	// the last candidate on the path is the bound
+		pair<_Leaf*, size_t> found = {nullptr, 0};
+
+		for (_Leaf* node = _data._Root; node != nullptr; /*Empty*/)
+		{
+			const size_t index = upper ? _upper_index(node, key) : _lower_index(node, key);
+
+			if (index < node->_Count)
+				found = {node, index};
+
+			if (node->_IsLeaf)
+				break;
+
+			node = _Data::internal(node)->_Children[index];
+		}
+
+		return found;
+	}
+
+	template<class KeyType>
+	bool _find_leaf_slot(const KeyType& key, _Leaf*& node, size_t& index) const {	// true and position if key exists, else the leaf slot for key
+		index = 0;
+
+		while (node != nullptr)
+		{
+			index = _lower_index(node, key);
+
+			if (index < node->_Count && !_less(key, Traits::extract_key(node->_value(index))))
+				return true;
+
+			if (node->_IsLeaf)
+				break;
+
+			node = _Data::internal(node)->_Children[index];
+		}
+
+		return false;
+	}
+
+	template<class... Args>
+	iterator _insert_at(_Leaf* node, size_t index, Args&&... args) {	// Construct value in leaf node at index
+		if (node == nullptr)
+			return _insert_root(custom::forward<Args>(args)...);
+
+		if (node->_Count == _CAPACITY)
+		{
+			_split(node);
+
+			if (index > node->_Count)									// slot moved to the new right sibling
+			{
+				index	-= node->_Count + 1;
+				node	= node->_Parent->_Children[node->_Position + 1];
+			}
+		}
+
+		_relocate_range(node->_value_ptr(index), node->_value_ptr(index + 1), node->_Count - index);
+
+		try
+		{
+			_Alloc_Leaf_Traits::construct(_allocLeaf, node->_value_ptr(index), custom::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			_relocate_range(node->_value_ptr(index + 1), node->_value_ptr(index), node->_Count - index);
+			CUSTOM_RERAISE;
+		}
+
+		++node->_Count;
+		++_data._Size;
+
+		return iterator(node, index, &_data);
+	}
+
+	template<class... Args>
+	iterator _insert_root(Args&&... args) {							// First value, the root is published only once the value exists
+		_Leaf* root = _create_node(true);
+
+		try
+		{
+			_Alloc_Leaf_Traits::construct(_allocLeaf, root->_value_ptr(0), custom::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			_free_node(root);
+			CUSTOM_RERAISE;
+		}
+
+		root->_Count	= 1;
+		_data._Root		= root;
+		++_data._Size;
+
+		return iterator(root, 0, &_data);
+	}
+
+	void _split(_Leaf* node) {											// Move the upper half into a new sibling and the median into the parent
+		if (node->_Parent == nullptr)									// grow a new root above node
+		{
+			_Internal* root = static_cast<_Internal*>(_create_node(false));
+			_set_child(root, 0, node);
+			_data._Root = root;
+		}
+		else if (node->_Parent->_Count == _CAPACITY)
+			_split(node->_Parent);
+
+		_Internal* parent		= node->_Parent;
+		const size_t position	= node->_Position;
+		const size_t middle		= _CAPACITY / 2;
+		_Leaf* sibling			= _create_node(node->_IsLeaf);
+
+		_relocate_range(node->_value_ptr(middle + 1), sibling->_value_ptr(0), node->_Count - middle - 1);
+
+		if (!node->_IsLeaf)
+			for (size_t i = middle + 1; i <= node->_Count; ++i)
+				_set_child(_Data::internal(sibling), i - middle - 1, _Data::internal(node)->_Children[i]);
+
+		_relocate_range(parent->_value_ptr(position), parent->_value_ptr(position + 1), parent->_Count - position);
+
+		for (size_t i = parent->_Count; i > position; --i)				// room for the median and the sibling
+			_set_child(parent, i + 1, parent->_Children[i]);
+
+		_relocate(node->_value_ptr(middle), parent->_value_ptr(position));
+		_set_child(parent, position + 1, sibling);
+
+		sibling->_Count	= static_cast<unsigned short>(node->_Count - middle - 1);
+		node->_Count	= static_cast<unsigned short>(middle);
+		++parent->_Count;
+	}
+
+	template<class KeyType>
+	iterator _erase(const KeyType& key) {
+		pair<_Leaf*, size_t> found = _find_in_tree(key);
+
+		if (found.first == nullptr)
+			return end();
+
+		return _erase_at(found.first, found.second);
+	}
+
+	iterator _erase_at(_Leaf* node, const size_t index) {				// Erase value and return iterator to the next one
+		const bool fromInternal	= !node->_IsLeaf;
+		_Leaf* leaf				= node;
+		size_t leafIndex		= index;
+
+		_Alloc_Leaf_Traits::destroy(_allocLeaf, node->_value_ptr(index));
+
+		if (fromInternal)												// the predecessor from a leaf takes its place
+		{
+			leaf		= _Data::rightmost(_Data::internal(node)->_Children[index]);
+			leafIndex	= leaf->_Count - 1u;
+			_relocate(leaf->_value_ptr(leafIndex), node->_value_ptr(index));
+		}
+
+		_relocate_range(leaf->_value_ptr(leafIndex + 1), leaf->_value_ptr(leafIndex), leaf->_Count - leafIndex - 1u);
+
+		--leaf->_Count;
+		--_data._Size;
+
+		// (leaf, leafIndex) marks the gap in front of the next value, kept valid while rebalancing
+		_rebalance(leaf, leaf, leafIndex);
+
+		while (leaf != nullptr && leafIndex == leaf->_Count)
+		{
+			leafIndex	= leaf->_Position;
+			leaf		= leaf->_Parent;
+		}
+
+		iterator next(leaf, (leaf == nullptr) ? 0 : leafIndex, &_data);
+		if (fromInternal)												// the gap is in front of the moved predecessor
+			++next;
+
+		return next;
+	}
+
+	void _rebalance(_Leaf* node, _Leaf*& tracked, size_t& trackedIndex) {	// Refill or merge underfull nodes from node up to the root
+		while (node != _data._Root)
+		{
+			if (node->_Count >= _MIN_COUNT)
+				return;
+
+			_Internal* parent		= node->_Parent;
+			const size_t position	= node->_Position;
+			_Leaf* left				= (position > 0) ? parent->_Children[position - 1] : nullptr;
+			_Leaf* right			= (position < parent->_Count) ? parent->_Children[position + 1] : nullptr;
+
+			if (left != nullptr && left->_Count > _MIN_COUNT)
+			{
+				_rotate_right(left, node, parent, position - 1);
+				if (tracked == node)
+					++trackedIndex;
+
+				return;
+			}
+
+			if (right != nullptr && right->_Count > _MIN_COUNT)
+			{
+				_rotate_left(node, right, parent, position);
+				return;
+			}
+
+			if (left != nullptr)
+			{
+				if (tracked == node)
+				{
+					tracked			= left;
+					trackedIndex	+= left->_Count + 1u;
+				}
+
+				_merge(left, node, parent, position - 1);
+			}
+			else
+				_merge(node, right, parent, position);
+
+			node = parent;
+		}
+
+		if (node->_Count > 0)
+			return;
+
+		if (node->_IsLeaf)												// last value erased
+		{
+			_free_node(node);
+			_data._Root		= nullptr;
+			tracked			= nullptr;
+			trackedIndex	= 0;
+		}
+		else															// the root lost its last separator, its only child takes over
+		{
+			_data._Root				= _Data::internal(node)->_Children[0];
+			_data._Root->_Parent	= nullptr;
+			_data._Root->_Position	= 0;
+			_free_node(node);
+		}
+	}
+
+	void _rotate_right(_Leaf* left, _Leaf* node, _Internal* parent, const size_t separator) {	// Move left's last value through the parent into node
+		_relocate_range(node->_value_ptr(0), node->_value_ptr(1), node->_Count);
+
+		if (!node->_IsLeaf)
+			for (size_t i = node->_Count + 1u; i > 0; --i)
+				_set_child(_Data::internal(node), i, _Data::internal(node)->_Children[i - 1]);
+
+		_relocate(parent->_value_ptr(separator), node->_value_ptr(0));
+		_relocate(left->_value_ptr(left->_Count - 1u), parent->_value_ptr(separator));
+
+		if (!node->_IsLeaf)
+			_set_child(_Data::internal(node), 0, _Data::internal(left)->_Children[left->_Count]);
+
+		--left->_Count;
+		++node->_Count;
+	}
+
+	void _rotate_left(_Leaf* node, _Leaf* right, _Internal* parent, const size_t separator) {	// Move right's first value through the parent into node
+		_relocate(parent->_value_ptr(separator), node->_value_ptr(node->_Count));
+		_relocate(right->_value_ptr(0), parent->_value_ptr(separator));
+
+		if (!node->_IsLeaf)
+			_set_child(_Data::internal(node), node->_Count + 1u, _Data::internal(right)->_Children[0]);
+
+		_relocate_range(right->_value_ptr(1), right->_value_ptr(0), right->_Count - 1u);
+
+		if (!right->_IsLeaf)
+			for (size_t i = 1; i <= right->_Count; ++i)
+				_set_child(_Data::internal(right), i - 1, _Data::internal(right)->_Children[i]);
+
+		++node->_Count;
+		--right->_Count;
+	}
+
+	void _merge(_Leaf* left, _Leaf* right, _Internal* parent, const size_t separator) {		// Append separator and right to left, then free right
+		const size_t leftCount = left->_Count;
+
+		_relocate(parent->_value_ptr(separator), left->_value_ptr(leftCount));
+
+		_relocate_range(right->_value_ptr(0), left->_value_ptr(leftCount + 1), right->_Count);
+
+		if (!left->_IsLeaf)
+			for (size_t i = 0; i <= right->_Count; ++i)
+				_set_child(_Data::internal(left), leftCount + 1 + i, _Data::internal(right)->_Children[i]);
+
+		left->_Count = static_cast<unsigned short>(leftCount + 1 + right->_Count);
+
+		_relocate_range(parent->_value_ptr(separator + 1), parent->_value_ptr(separator), parent->_Count - separator - 1u);
+
+		for (size_t i = separator + 1; i < parent->_Count; ++i)
+			_set_child(parent, i, parent->_Children[i + 1]);
+
+		--parent->_Count;
+		right->_Count = 0;
+		_free_node(right);
+	}
+
+	// Values only ever move between node slots by relocation: move-construct into the raw slot,
+	// then destroy the source (or copy the bytes when value_type is trivially relocatable).
+	// Nothing is assigned, so const keys are never written through. Relocation is noexcept,
+	// a throwing move terminates instead of leaving a node with a hole in its value run.
+	void _relocate(value_type* source, value_type* dest) noexcept {
+		if constexpr (_Relocate_Bytes)
+			std::memmove(static_cast<void*>(dest), static_cast<const void*>(source), sizeof(value_type));
+		else
+		{
+			_Alloc_Leaf_Traits::construct(_allocLeaf, dest, custom::move(*source));
+			_Alloc_Leaf_Traits::destroy(_allocLeaf, source);
+		}
+	}
+
+	void _relocate_range(value_type* source, value_type* dest, const size_t count) noexcept {	// Ranges may overlap within a node
+		if constexpr (_Relocate_Bytes)
+		{
+			if (count > 0)
+				std::memmove(static_cast<void*>(dest), static_cast<const void*>(source), count * sizeof(value_type));
+		}
+		else if (dest < source)
+		{
+			for (size_t i = 0; i < count; ++i)
+				_relocate(source + i, dest + i);
+		}
+		else
+		{
+			for (size_t i = count; i > 0; --i)
+				_relocate(source + i - 1, dest + i - 1);
+		}
+	}
+
+	static void _set_child(_Internal* parent, const size_t index, _Leaf* child) noexcept {
+		parent->_Children[index]	= child;
+		child->_Parent				= parent;
+		child->_Position			= static_cast<unsigned short>(index);
+	}
+
+	_Leaf* _create_node(const bool isLeaf) {							// values are not constructed
+		_Leaf* newNode = isLeaf ? _allocLeaf.allocate(1) : _allocInternal.allocate(1);
+
+		newNode->_Parent	= nullptr;
+		newNode->_Position	= 0;
+		newNode->_Count		= 0;
+		newNode->_IsLeaf	= isLeaf;
+
+		return newNode;
+	}
+
+	void _free_node(_Leaf* oldNode) {
+		if (oldNode->_IsLeaf)
+			_allocLeaf.deallocate(oldNode, 1);
+		else
+			_allocInternal.deallocate(_Data::internal(oldNode), 1);
+	}
+
+	_Leaf* _copy_all(_Leaf* source) {									// DFS Preorder
+		_Leaf* newNode = _create_node(source->_IsLeaf);
+
+		for (size_t i = 0; i < source->_Count; ++i)
+			_Alloc_Leaf_Traits::construct(_allocLeaf, newNode->_value_ptr(i), source->_value(i));
+
+		newNode->_Count = source->_Count;
+
+		if (!source->_IsLeaf)
+			for (size_t i = 0; i <= source->_Count; ++i)
+				_set_child(_Data::internal(newNode), i, _copy_all(_Data::internal(source)->_Children[i]));
+
+		return newNode;
+	}
+
+	void _destroy_all(_Leaf* subroot) {									// DFS Postorder
+		if (!subroot->_IsLeaf)
+			for (size_t i = 0; i <= subroot->_Count; ++i)
+				_destroy_all(_Data::internal(subroot)->_Children[i]);
+
+		for (size_t i = 0; i < subroot->_Count; ++i)
+			_Alloc_Leaf_Traits::destroy(_allocLeaf, subroot->_value_ptr(i));
+
+		_free_node(subroot);
+	}
+
+	void _copy(const _BTree& other) {
+		if (other._data._Root != nullptr)
+			_data._Root = _copy_all(other._data._Root);
+
+		_data._Size = other._data._Size;
+	}
+
+	void _move(_BTree&& other) {
+		_data._Root = custom::exchange(other._data._Root, nullptr);
+		_data._Size = custom::exchange(other._data._Size, 0);
+	}
+}; // END _BTree Template
+
+
+// _BTree binary operators
+template<class Traits, size_t NodeBytes>
+bool operator==(const _BTree<Traits, NodeBytes>& left, const _BTree<Traits, NodeBytes>& right) {
+	if (left.size() != right.size())
+		return false;
+
+	return custom::equal(left.begin(), left.end(), right.begin());
+}
+
+template<class Traits, size_t NodeBytes>
+bool operator!=(const _BTree<Traits, NodeBytes>& left, const _BTree<Traits, NodeBytes>& right) {
+	return !(left == right);
+}
+
+CUSTOM_DETAIL_END
+
+CUSTOM_END
\ No newline at end of file
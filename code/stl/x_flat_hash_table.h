@@ -0,0 +1,907 @@
+#pragma once
+#include "x_memory.h"
+#include "c_pair.h"
+#include "c_utility.h"
+#include "c_iterator.h"
+#include "c_functional.h"	// EqualTo, Hash
+#include "c_algorithm.h"	// max
+#include "c_bit.h"			// countr_zero, bit_ceil
+#include <cstring>			// std::memset, std::memcpy
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#define CUSTOM_FLAT_HASH_SSE2 1
+#include <emmintrin.h>		// _mm_cmpeq_epi8, _mm_movemask_epi8
+#elif defined __ARM_NEON || defined _M_ARM64
+#define CUSTOM_FLAT_HASH_NEON 1
+#include <arm_neon.h>		// vceqq_s8, vshrn_n_u16
+#endif
+
+
+CUSTOM_BEGIN
+
+CUSTOM_DETAIL_BEGIN
+
+// Control byte of a slot in _Flat_Hash_Table
+// full slots hold the low 7 bits of the hash (H2), special states are negative
+using _Ctrl_Type = signed char;
+
+constexpr _Ctrl_Type _Ctrl_Empty		= -128;						// 0b10000000
+constexpr _Ctrl_Type _Ctrl_Deleted		= -2;						// 0b11111110
+constexpr _Ctrl_Type _Ctrl_Sentinel		= -1;						// 0b11111111 placed after the last slot to stop iteration
+
+constexpr size_t _GROUP_WIDTH			= 16;						// slots probed at once
+
+// Set bits of a group match, one (group) lane per matching slot
+template<class MaskType, int Shift>
+class _Group_Bit_Mask
+{
+private:
+	MaskType _Mask;
+
+public:
+
+	explicit _Group_Bit_Mask(MaskType mask) noexcept
+		: _Mask(mask) { /*Empty*/ }
+
+	explicit operator bool() const noexcept {
+		return _Mask != 0;
+	}
+
+	size_t lowest() const noexcept {								// index of the first matching slot
+		return static_cast<size_t>(custom::countr_zero(_Mask)) >> Shift;
+	}
+
+	_Group_Bit_Mask& operator++() noexcept {						// drop the first matching slot
+		_Mask &= static_cast<MaskType>(_Mask - 1);
+		return *this;
+	}
+}; // END _Group_Bit_Mask
+
+#if defined CUSTOM_FLAT_HASH_SSE2
+
+class _Group		// 16 control bytes compared with SSE2
+{
+public:
+	using _Bit_Mask = _Group_Bit_Mask<unsigned int, 0>;
+
+private:
+	__m128i _Ctrl;
+
+public:
+
+	explicit _Group(const _Ctrl_Type* pos) noexcept
+		: _Ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) { /*Empty*/ }
+
+	_Bit_Mask match(const _Ctrl_Type h2) const noexcept {
+		return _Bit_Mask(static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), _Ctrl))));
+	}
+
+	_Bit_Mask match_empty() const noexcept {
+		return match(_Ctrl_Empty);
+	}
+
+	_Bit_Mask match_empty_or_deleted() const noexcept {				// special states below the sentinel
+		return _Bit_Mask(static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(_Ctrl_Sentinel), _Ctrl))));
+	}
+}; // END _Group
+
+#elif defined CUSTOM_FLAT_HASH_NEON
+
+class _Group		// 16 control bytes compared with NEON (4 mask bits per slot)
+{
+public:
+	using _Bit_Mask = _Group_Bit_Mask<unsigned long long, 2>;
+
+private:
+	int8x16_t _Ctrl;
+
+	static constexpr unsigned long long _LANE_MSBS = 0x8888888888888888ULL;
+
+public:
+
+	explicit _Group(const _Ctrl_Type* pos) noexcept
+		: _Ctrl(vld1q_s8(pos)) { /*Empty*/ }
+
+	_Bit_Mask match(const _Ctrl_Type h2) const noexcept {
+		return _to_mask(vceqq_s8(vdupq_n_s8(h2), _Ctrl));
+	}
+
+	_Bit_Mask match_empty() const noexcept {
+		return match(_Ctrl_Empty);
+	}
+
+	_Bit_Mask match_empty_or_deleted() const noexcept {
+		return _to_mask(vcltq_s8(_Ctrl, vdupq_n_s8(_Ctrl_Sentinel)));
+	}
+
+private:
+
+	static _Bit_Mask _to_mask(const uint8x16_t cmp) noexcept {		// narrow each 0xFF byte to a nibble
+		const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+		return _Bit_Mask(vget_lane_u64(vreinterpret_u64_u8(narrowed), 0) & _LANE_MSBS);
+	}
+}; // END _Group
+
+#else
+
+class _Group		// portable fallback, one mask bit per slot
+{
+public:
+	using _Bit_Mask = _Group_Bit_Mask<unsigned int, 0>;
+
+private:
+	const _Ctrl_Type* _Ctrl;
+
+public:
+
+	explicit _Group(const _Ctrl_Type* pos) noexcept
+		: _Ctrl(pos) { /*Empty*/ }
+
+	_Bit_Mask match(const _Ctrl_Type h2) const noexcept {
+		unsigned int mask = 0;
+		for (size_t i = 0; i < _GROUP_WIDTH; ++i)
+			mask |= static_cast<unsigned int>(_Ctrl[i] == h2) << i;
+
+		return _Bit_Mask(mask);
+	}
+
+	_Bit_Mask match_empty() const noexcept {
+		return match(_Ctrl_Empty);
+	}
+
+	_Bit_Mask match_empty_or_deleted() const noexcept {
+		unsigned int mask = 0;
+		for (size_t i = 0; i < _GROUP_WIDTH; ++i)
+			mask |= static_cast<unsigned int>(_Ctrl[i] < _Ctrl_Sentinel) << i;
+
+		return _Bit_Mask(mask);
+	}
+}; // END _Group
+
+#endif // CUSTOM_FLAT_HASH_SSE2
+
+
+template<class Traits>
+struct _Flat_Hash_Table_Data
+{
+	// deduce data types and forward them
+	using _Alloc_Traits			= allocator_traits<typename Traits::allocator_type>;
+	using _Alloc_Ctrl			= typename _Alloc_Traits::template rebind_alloc<_Ctrl_Type>;
+	using _Alloc_Ctrl_Traits	= allocator_traits<_Alloc_Ctrl>;
+
+	using value_type			= typename _Alloc_Traits::value_type;
+	using difference_type		= typename _Alloc_Traits::difference_type;
+	using reference				= typename _Alloc_Traits::reference;
+	using const_reference		= typename _Alloc_Traits::const_reference;
+	using pointer				= typename _Alloc_Traits::pointer;
+	using const_pointer			= typename _Alloc_Traits::const_pointer;
+
+	_Ctrl_Type* _Ctrl			= nullptr;							// Control bytes (_Capacity + 1 for sentinel)
+	pointer _Slots				= nullptr;							// Inline storage of values
+	size_t _Capacity			= 0;								// Number of slots (0 or power of 2 >= _GROUP_WIDTH)
+	size_t _Size				= 0;								// Number of full slots
+	size_t _GrowthLeft			= 0;								// Insertions into empty slots until resize
+};
+
+template<class FlatData>
+class _Flat_Hash_Table_Const_Iterator
+{
+private:
+	using _Data				= FlatData;
+
+public:
+	using iterator_category	= forward_iterator_tag;
+	using value_type		= typename _Data::value_type;
+	using difference_type	= typename _Data::difference_type;
+	using reference			= typename _Data::const_reference;
+	using pointer			= typename _Data::const_pointer;
+
+	using _Pointer			= typename _Data::pointer;
+
+	_Pointer _Ptr			= nullptr;
+	const _Data* _RefData	= nullptr;
+
+public:
+
+	_Flat_Hash_Table_Const_Iterator() noexcept = default;
+
+	explicit _Flat_Hash_Table_Const_Iterator(_Pointer ptr, const _Data* data) noexcept
+		:_Ptr(ptr), _RefData(data) { /*Empty*/ }
+
+	_Flat_Hash_Table_Const_Iterator& operator++() noexcept {
+		CUSTOM_ASSERT(_Ptr != _RefData->_Slots + _RefData->_Capacity, "Cannot increment end iterator.");
+		const _Ctrl_Type* ctrl = _RefData->_Ctrl + (_Ptr - _RefData->_Slots);
+
+		do
+		{
+			++ctrl;
+			++_Ptr;
+		} while (*ctrl < _Ctrl_Sentinel);	// skip empty and deleted slots
+
+		return *this;
+	}
+
+	_Flat_Hash_Table_Const_Iterator operator++(int) noexcept {
+		_Flat_Hash_Table_Const_Iterator temp = *this;
+		++(*this);
+		return temp;
+	}
+
+	pointer operator->() const noexcept {
+		return pointer_traits<pointer>::pointer_to(**this);
+	}
+
+	reference operator*() const noexcept {
+		CUSTOM_ASSERT(_Ptr != _RefData->_Slots + _RefData->_Capacity, "Cannot dereference end iterator.");
+		return *_Ptr;
+	}
+
+	bool operator==(const _Flat_Hash_Table_Const_Iterator& other) const noexcept {
+		return _Ptr == other._Ptr;
+	}
+
+	bool operator!=(const _Flat_Hash_Table_Const_Iterator& other) const noexcept {
+		return !(*this == other);
+	}
+
+public:
+
+	friend void _verify_range(const _Flat_Hash_Table_Const_Iterator& first, const _Flat_Hash_Table_Const_Iterator& last) noexcept {
+		CUSTOM_ASSERT(first._RefData == last._RefData, "flat hash table iterators in range are from different containers");
+		CUSTOM_ASSERT(first._Ptr <= last._Ptr, "flat hash table iterator range transposed");
+	}
+}; // END _Flat_Hash_Table_Const_Iterator
+
+template<class FlatData>
+class _Flat_Hash_Table_Iterator : public _Flat_Hash_Table_Const_Iterator<FlatData>
+{
+private:
+	using _Base				= _Flat_Hash_Table_Const_Iterator<FlatData>;
+	using _Data				= FlatData;
+
+public:
+	using iterator_category	= forward_iterator_tag;
+	using value_type		= typename _Data::value_type;
+	using difference_type	= typename _Data::difference_type;
+	using reference			= typename _Data::reference;
+	using pointer			= typename _Data::pointer;
+
+public:
+
+	_Flat_Hash_Table_Iterator() noexcept = default;
+
+	explicit _Flat_Hash_Table_Iterator(pointer ptr, const _Data* data) noexcept
+		: _Base(ptr, data) { /*Empty*/ }
+
+	_Flat_Hash_Table_Iterator& operator++() noexcept {
+		_Base::operator++();
+		return *this;
+	}
+
+	_Flat_Hash_Table_Iterator operator++(int) noexcept {
+		_Flat_Hash_Table_Iterator temp = *this;
+		_Base::operator++();
+		return temp;
+	}
+
+	pointer operator->() const noexcept {
+		return const_cast<pointer>(_Base::operator->());
+	}
+
+	reference operator*() const noexcept {
+		return const_cast<reference>(_Base::operator*());
+	}
+}; // END _Flat_Hash_Table_Iterator
+
+
+// _Flat_Hash_Table Template implemented with open addressing (Swiss table layout)
+// Values are stored inline in a slot array. A parallel array of control bytes
+// is probed a group of 16 at a time (SSE2/NEON when available) using 7 bits of the hash
+template<class Traits>
+class _Flat_Hash_Table
+{
+protected:
+	using _Data					= _Flat_Hash_Table_Data<Traits>;
+	using _Alloc_Traits			= typename _Data::_Alloc_Traits;
+	using _Alloc_Ctrl			= typename _Data::_Alloc_Ctrl;
+	using _Alloc_Ctrl_Traits	= typename _Data::_Alloc_Ctrl_Traits;
+
+	using key_type				= typename Traits::key_type;
+	using mapped_type			= typename Traits::mapped_type;
+	using hasher				= typename Traits::hasher;
+	using key_compare			= typename Traits::key_compare;
+
+	using value_type			= typename _Data::value_type;
+	using difference_type		= typename _Data::difference_type;
+	using reference				= typename _Data::reference;
+	using const_reference		= typename _Data::const_reference;
+	using pointer				= typename _Data::pointer;
+	using const_pointer			= typename _Data::const_pointer;
+	using allocator_type		= typename Traits::allocator_type;
+
+	using iterator				= _Flat_Hash_Table_Iterator<_Data>;
+	using const_iterator		= _Flat_Hash_Table_Const_Iterator<_Data>;
+
+	template<class KeyType>
+	using _Enable_Transparent	= enable_if_t<conjunction_v<				// heterogeneous lookup when both hasher and key_compare allow it
+												_Is_Transparent<hasher>,
+												_Is_Transparent<key_compare>,
+												negation<is_convertible<KeyType, const_iterator>>>,
+									bool>;
+
+protected:
+	hasher _hash;													// Used for initial(non-compressed) hash value
+	key_compare _compare;											// Used for comparison between keys
+	_Data _data;													// Actual container data
+	allocator_type _alloc;											// Used to allocate slots
+	_Alloc_Ctrl _allocCtrl;											// Used to allocate control bytes
+
+	static constexpr size_t _DEFAULT_CAPACITY	= _GROUP_WIDTH;		// Capacity on first insertion
+
+protected:
+	// Constructors
+
+	_Flat_Hash_Table() = default;
+
+	_Flat_Hash_Table(const size_t noSlots) {
+		reserve(noSlots);
+	}
+
+	_Flat_Hash_Table(std::initializer_list<value_type> list) {
+		reserve(list.size());
+		for (const auto& val : list)
+			emplace(val);
+	}
+
+	_Flat_Hash_Table(const _Flat_Hash_Table& other) {
+		_copy(other);
+	}
+
+	_Flat_Hash_Table(_Flat_Hash_Table&& other) noexcept {
+		_move(custom::move(other));
+	}
+
+	virtual ~_Flat_Hash_Table() {
+		_clean_up();
+	}
+
+protected:
+	// Operators
+
+	_Flat_Hash_Table& operator=(const _Flat_Hash_Table& other) {
+		if (_data._Ctrl != other._data._Ctrl)
+		{
+			_clean_up();
+			_copy(other);
+		}
+
+		return *this;
+	}
+
+	_Flat_Hash_Table& operator=(_Flat_Hash_Table&& other) noexcept {
+		if (_data._Ctrl != other._data._Ctrl)
+		{
+			_clean_up();
+			_move(custom::move(other));
+		}
+
+		return *this;
+	}
+
+public:
+	// Main Functions
+
+	template<class... Args>
+	iterator emplace(Args&&... args) {
+		using _Extractor = typename Traits::template _In_Place_Key_Extractor<remove_cv_ref_t<Args>...>;
+
+		if constexpr (_Extractor::_Extractable)
+			return _emplace_with_key(_Extractor::_extract(args...), custom::forward<Args>(args)...);
+		else
+		{
+			value_type newValue(custom::forward<Args>(args)...);	// key unknown until the value is constructed
+			return _emplace_with_key(Traits::extract_key(newValue), custom::move(newValue));
+		}
+	}
+
+	template<class... Args>
+	iterator emplace_hint(const_iterator hint, Args&&... args) {	// hint is used to skip hashing when it already holds the key
+		using _Extractor = typename Traits::template _In_Place_Key_Extractor<remove_cv_ref_t<Args>...>;
+
+		if constexpr (_Extractor::_Extractable)
+			if (hint != end() && _compare(Traits::extract_key(*hint), _Extractor::_extract(args...)))
+				return iterator(hint._Ptr, &_data);
+
+		return emplace(custom::forward<Args>(args)...);
+	}
+
+	iterator erase(const key_type& key) {
+		return _erase(key);
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	iterator erase(const KeyType& key) {
+		return _erase(key);
+	}
+
+	iterator erase(iterator where) {
+		if (where == end())
+			throw std::out_of_range("erase iterator outside range.");
+
+		_erase_slot(static_cast<size_t>(where._Ptr - _data._Slots));
+		return ++where;		// the slot is no longer full, so increment skips it
+	}
+
+	iterator erase(const_iterator where) {
+		return erase(iterator(where._Ptr, &_data));
+	}
+
+	iterator find(const key_type& key) {
+		return iterator(_data._Slots + _find(key), &_data);
+	}
+
+	const_iterator find(const key_type& key) const {
+		return const_iterator(_data._Slots + _find(key), &_data);
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	iterator find(const KeyType& key) {
+		return iterator(_data._Slots + _find(key), &_data);
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	const_iterator find(const KeyType& key) const {
+		return const_iterator(_data._Slots + _find(key), &_data);
+	}
+
+	bool contains(const key_type& key) const {
+		return _find(key) != _data._Capacity;
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	bool contains(const KeyType& key) const {
+		return _find(key) != _data._Capacity;
+	}
+
+	void rehash(const size_t noSlots) {								// rebuild table with at least noSlots
+		size_t newCapacity = _capacity_for((custom::max)(_data._Size, noSlots));
+		if (newCapacity == 0)
+			_clean_up();
+		else if (newCapacity != _data._Capacity || _data._GrowthLeft < _growth_for(newCapacity) - _data._Size)
+			_resize(newCapacity);									// also drops deleted markers
+	}
+
+	void reserve(const size_t size) {								// rehash for at least "size" elements
+		if (size > _data._Size + _data._GrowthLeft)
+			_resize(_capacity_for(size));
+	}
+
+	void clear() {
+		if (_data._Capacity == 0)
+			return;
+
+		_destroy_slots();
+		_reset_ctrl();
+		_data._Size = 0;
+	}
+
+	size_t bucket_count() const noexcept {							// Get number of slots
+		return _data._Capacity;
+	}
+
+	size_t size() const noexcept {
+		return _data._Size;
+	}
+
+	size_t max_size() const noexcept {
+		return (static_cast<size_t>(-1) / 2) / (sizeof(value_type) + sizeof(_Ctrl_Type));
+	}
+
+	bool empty() const noexcept {
+		return _data._Size == 0;
+	}
+
+	float load_factor() const noexcept {
+		return _data._Capacity == 0 ? 0.0F : static_cast<float>(_data._Size) / static_cast<float>(_data._Capacity);
+	}
+
+	float max_load_factor() const noexcept {
+		return 7.0F / 8.0F;
+	}
+
+	void print_details() const {									// For Debugging
+		std::cout << "Capacity= " << _data._Capacity << ' ' << "Size= " << _data._Size << '\n';
+
+		for (size_t i = 0; i < _data._Capacity; ++i)
+		{
+			if (i % _GROUP_WIDTH == 0)
+				std::cout << "Group " << i / _GROUP_WIDTH << " :\n";
+
+			std::cout << i << " : ";
+
+			if (_data._Ctrl[i] == _Ctrl_Empty)
+				std::cout << "empty";
+			else if (_data._Ctrl[i] == _Ctrl_Deleted)
+				std::cout << "deleted";
+			else if constexpr (is_same_v<key_type, value_type>)			// set, the key is the whole value
+				std::cout << Traits::extract_key(_data._Slots[i]);
+			else
+				std::cout << Traits::extract_key(_data._Slots[i]) << ' ' << Traits::extract_mapval(_data._Slots[i]);
+
+			std::cout << '\n';
+		}
+	}
+
+public:
+	// iterator functions
+
+	iterator begin() {
+		return iterator(_data._Slots + _first_full(), &_data);
+	}
+
+	const_iterator begin() const {
+		return const_iterator(_data._Slots + _first_full(), &_data);
+	}
+
+	iterator end() {
+		return iterator(_data._Slots + _data._Capacity, &_data);
+	}
+
+	const_iterator end() const {
+		return const_iterator(_data._Slots + _data._Capacity, &_data);
+	}
+
+protected:
+	// Others
+
+	template<class _KeyType, class... Args>
+	pair<iterator, bool> _try_emplace(_KeyType&& key, Args&&... args) {			// Force construction with known key and given arguments for object
+		const size_t hashVal		= _hash_of(key);
+		pair<size_t, bool> result	= _find_or_prepare_insert(key, hashVal);
+
+		if (result.second)
+		{
+			_Alloc_Traits::construct(	_alloc,
+										_data._Slots + result.first,
+										custom::piecewise_construct,
+										custom::forward_as_tuple(custom::forward<_KeyType>(key)),
+										custom::forward_as_tuple(custom::forward<Args>(args)...));
+			_mark_full(result.first, hashVal);
+		}
+
+		return {iterator(_data._Slots + result.first, &_data), result.second};
+	}
+
+	const mapped_type& _at(const key_type& key) const {				// Access _Value at key with check
+		const size_t index = _find(key);
+
+		if (index == _data._Capacity)
+			throw std::out_of_range("Invalid key.");
+
+		return Traits::extract_mapval(_data._Slots[index]);
+	}
+
+	mapped_type& _at(const key_type& key) {
+		const size_t index = _find(key);
+
+		if (index == _data._Capacity)
+			throw std::out_of_range("Invalid key.");
+
+		return const_cast<mapped_type&>(Traits::extract_mapval(_data._Slots[index]));
+	}
+
+private:
+	// Helpers
+
+	template<class KeyType>
+	size_t _hash_of(const KeyType& key) const {					// mixed so that both H1 and H2 are usable
+		return detail::_mix_hash(_hash(key));
+	}
+
+	static size_t _h1(const size_t hashVal) noexcept {				// selects the first probed group
+		return hashVal >> 7;
+	}
+
+	static _Ctrl_Type _h2(const size_t hashVal) noexcept {			// stored in the control byte
+		return static_cast<_Ctrl_Type>(hashVal & 0x7F);
+	}
+
+	size_t _group_mask() const noexcept {
+		return _data._Capacity / _GROUP_WIDTH - 1;
+	}
+
+	template<class KeyType>
+	size_t _find(const KeyType& key) const {						// index of key or _Capacity if not found
+		if (_data._Size == 0)
+			return _data._Capacity;
+
+		const size_t hashVal	= _hash_of(key);
+		const _Ctrl_Type h2		= _h2(hashVal);
+		const size_t groupMask	= _group_mask();
+		size_t groupIndex		= _h1(hashVal) & groupMask;
+
+		for (size_t probe = 1; /*until empty found*/; ++probe)
+		{
+			const size_t offset = groupIndex * _GROUP_WIDTH;
+			const _Group group(_data._Ctrl + offset);
+
+			for (auto match = group.match(h2); match; ++match)
+			{
+				const size_t index = offset + match.lowest();
+				if (_compare(Traits::extract_key(_data._Slots[index]), key))
+					return index;
+			}
+
+			if (group.match_empty())	// key would have been placed in this group
+				return _data._Capacity;
+
+			groupIndex = (groupIndex + probe) & groupMask;	// triangular probing visits every group
+		}
+	}
+
+	template<class... Args>
+	iterator _emplace_with_key(const key_type& key, Args&&... args) {
+		const size_t hashVal		= _hash_of(key);
+		pair<size_t, bool> result	= _find_or_prepare_insert(key, hashVal);
+
+		if (result.second)	// key may refer to args, don't use it after construction
+		{
+			_Alloc_Traits::construct(_alloc, _data._Slots + result.first, custom::forward<Args>(args)...);
+			_mark_full(result.first, hashVal);
+		}
+
+		return iterator(_data._Slots + result.first, &_data);
+	}
+
+	template<class KeyType>
+	iterator _erase(const KeyType& key) {
+		const size_t index = _find(key);
+
+		if (index == _data._Capacity)
+			return end();
+
+		return erase(iterator(_data._Slots + index, &_data));
+	}
+
+	pair<size_t, bool> _find_or_prepare_insert(const key_type& key, const size_t hashVal) {	// {index, true if slot must be constructed and marked}
+		if (_data._Capacity == 0)
+			_resize(_DEFAULT_CAPACITY);
+
+		const _Ctrl_Type h2		= _h2(hashVal);
+		const size_t groupMask	= _group_mask();
+		size_t groupIndex		= _h1(hashVal) & groupMask;
+		size_t target			= _data._Capacity;					// first empty or deleted slot on the probe path
+
+		for (size_t probe = 1; /*until empty found*/; ++probe)
+		{
+			const size_t offset = groupIndex * _GROUP_WIDTH;
+			const _Group group(_data._Ctrl + offset);
+
+			for (auto match = group.match(h2); match; ++match)
+			{
+				const size_t index = offset + match.lowest();
+				if (_compare(Traits::extract_key(_data._Slots[index]), key))
+					return {index, false};
+			}
+
+			if (target == _data._Capacity)
+				if (auto free = group.match_empty_or_deleted())
+					target = offset + free.lowest();
+
+			if (group.match_empty())
+				break;
+
+			groupIndex = (groupIndex + probe) & groupMask;
+		}
+
+		if (_data._Ctrl[target] == _Ctrl_Empty && _data._GrowthLeft == 0)	// reusing a deleted slot needs no growth
+		{
+			_grow();
+			target = _find_first_non_full(hashVal);
+		}
+
+		return {target, true};
+	}
+
+	void _mark_full(const size_t index, const size_t hashVal) noexcept {	// commit a prepared slot after construction
+		if (_data._Ctrl[index] == _Ctrl_Empty)
+			--_data._GrowthLeft;
+
+		_set_ctrl(index, _h2(hashVal));
+		++_data._Size;
+	}
+
+	size_t _find_first_non_full(const size_t hashVal) const {		// insertion slot for a key known to be absent
+		return _find_first_non_full(_data, hashVal);
+	}
+
+	static size_t _find_first_non_full(const _Data& data, const size_t hashVal) noexcept {
+		const size_t groupMask	= data._Capacity / _GROUP_WIDTH - 1;
+		size_t groupIndex		= _h1(hashVal) & groupMask;
+
+		for (size_t probe = 1; /*until found*/; ++probe)
+		{
+			const size_t offset = groupIndex * _GROUP_WIDTH;
+
+			if (auto free = _Group(data._Ctrl + offset).match_empty_or_deleted())
+				return offset + free.lowest();
+
+			groupIndex = (groupIndex + probe) & groupMask;
+		}
+	}
+
+	void _erase_slot(const size_t index) {
+		_Alloc_Traits::destroy(_alloc, _data._Slots + index);
+		--_data._Size;
+
+		// A probe only stops at a group with an empty slot.
+		// If the group already has one, no probe passes through it and the slot can become empty again.
+		const size_t offset = index - index % _GROUP_WIDTH;
+		if (_Group(_data._Ctrl + offset).match_empty())
+		{
+			_set_ctrl(index, _Ctrl_Empty);
+			++_data._GrowthLeft;
+		}
+		else
+			_set_ctrl(index, _Ctrl_Deleted);
+	}
+
+	void _set_ctrl(const size_t index, const _Ctrl_Type val) noexcept {
+		_data._Ctrl[index] = val;
+	}
+
+	void _grow() {
+		// many deleted markers: rehash in place (same capacity), else double
+		if (_data._Size <= _growth_for(_data._Capacity) / 2)
+			_resize(_data._Capacity);
+		else
+			_resize(_data._Capacity * 2);
+	}
+
+	void _resize(const size_t newCapacity) {						// rehash into new arrays, _data changes only after all elements moved
+		_Data newData;
+		newData._Capacity	= newCapacity;
+		newData._Ctrl		= _allocCtrl.allocate(newCapacity + 1);
+
+		try
+		{
+			newData._Slots = _alloc.allocate(newCapacity);
+		}
+		catch (...)
+		{
+			_allocCtrl.deallocate(newData._Ctrl, newCapacity + 1);
+			CUSTOM_RERAISE;
+		}
+
+		std::memset(newData._Ctrl, static_cast<unsigned char>(_Ctrl_Empty), newCapacity);
+		newData._Ctrl[newCapacity] = _Ctrl_Sentinel;
+
+		try
+		{
+			for (size_t i = 0; i < _data._Capacity; ++i)
+			{
+				if (_data._Ctrl[i] < 0)	// not full
+					continue;
+
+				const size_t hashVal	= _hash_of(Traits::extract_key(_data._Slots[i]));
+				const size_t target		= _find_first_non_full(newData, hashVal);
+
+				_Alloc_Traits::construct(_alloc, newData._Slots + target, custom::move(_data._Slots[i]));
+				newData._Ctrl[target] = _h2(hashVal);
+				++newData._Size;
+			}
+		}
+		catch (...)															// old elements stay in place (the ones already moved from are valid but unspecified)
+		{
+			for (size_t i = 0; i < newCapacity; ++i)
+				if (newData._Ctrl[i] >= 0)
+					_Alloc_Traits::destroy(_alloc, newData._Slots + i);
+
+			_allocCtrl.deallocate(newData._Ctrl, newCapacity + 1);
+			_alloc.deallocate(newData._Slots, newCapacity);
+			CUSTOM_RERAISE;
+		}
+
+		newData._GrowthLeft = _growth_for(newCapacity) - newData._Size;
+
+		_clean_up();														// destroy the moved-from elements and free the old arrays
+		_data = newData;
+	}
+
+	void _reset_ctrl() noexcept {									// mark all slots empty and place sentinel
+		std::memset(_data._Ctrl, static_cast<unsigned char>(_Ctrl_Empty), _data._Capacity);
+		_data._Ctrl[_data._Capacity]	= _Ctrl_Sentinel;
+		_data._GrowthLeft				= _growth_for(_data._Capacity);
+	}
+
+	size_t _first_full() const noexcept {
+		if (_data._Size == 0)
+			return _data._Capacity;
+
+		size_t index = 0;
+		while (_data._Ctrl[index] < _Ctrl_Sentinel)
+			++index;
+
+		return index;
+	}
+
+	static size_t _growth_for(const size_t capacity) noexcept {		// max elements for capacity (load factor 7/8)
+		return capacity - capacity / 8;
+	}
+
+	static size_t _capacity_for(const size_t size) noexcept {		// smallest power of 2 capacity that fits size
+		if (size == 0)
+			return 0;
+
+		size_t capacity = custom::bit_ceil(size + size / 7);
+		return capacity < _GROUP_WIDTH ? _GROUP_WIDTH : capacity;
+	}
+
+	void _destroy_slots() {
+		for (size_t i = 0; i < _data._Capacity; ++i)
+			if (_data._Ctrl[i] >= 0)
+				_Alloc_Traits::destroy(_alloc, _data._Slots + i);
+	}
+
+	void _clean_up() {
+		if (_data._Capacity == 0)
+			return;
+
+		_destroy_slots();
+		_allocCtrl.deallocate(_data._Ctrl, _data._Capacity + 1);
+		_alloc.deallocate(_data._Slots, _data._Capacity);
+		_data = _Data();
+	}
+
+	void _copy(const _Flat_Hash_Table& other) {						// same layout, so slots keep their positions
+		_hash		= other._hash;
+		_compare	= other._compare;
+
+		if (other._data._Capacity == 0)
+			return;
+
+		_data._Capacity		= other._data._Capacity;
+		_data._Ctrl			= _allocCtrl.allocate(_data._Capacity + 1);
+		_data._Slots		= _alloc.allocate(_data._Capacity);
+		std::memcpy(_data._Ctrl, other._data._Ctrl, _data._Capacity + 1);
+
+		for (size_t i = 0; i < _data._Capacity; ++i)
+			if (_data._Ctrl[i] >= 0)
+				_Alloc_Traits::construct(_alloc, _data._Slots + i, other._data._Slots[i]);
+
+		_data._Size			= other._data._Size;
+		_data._GrowthLeft	= other._data._GrowthLeft;
+	}
+
+	void _move(_Flat_Hash_Table&& other) noexcept {
+		_hash		= custom::move(other._hash);
+		_compare	= custom::move(other._compare);
+		_data		= other._data;
+		other._data	= _Data();
+	}
+};	// END _Flat_Hash_Table Template
+
+// _Flat_Hash_Table binary operators
+template<class Traits>
+bool operator==(const _Flat_Hash_Table<Traits>& left, const _Flat_Hash_Table<Traits>& right) {	// Contains the same elems
+	if (left.size() != right.size())
+		return false;
+
+	for (const auto& val : right)
+	{
+		auto it = left.find(Traits::extract_key(val));	// Search for key
+		if (it == left.end() || Traits::extract_mapval(*it) != Traits::extract_mapval(val))
+			return false;
+	}
+
+	return true;
+}
+
+template<class Traits>
+bool operator!=(const _Flat_Hash_Table<Traits>& left, const _Flat_Hash_Table<Traits>& right) {
+	return !(left == right);
+}
+
+CUSTOM_DETAIL_END
+
+CUSTOM_END
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+#include "c_vector.h"
+#include "c_algorithm.h"
+#include "c_functional.h"	// for custom::Less
+#include "c_pair.h"
+
+
+CUSTOM_BEGIN
+
+// tag struct declaration for ranges already sorted by key and free of equivalent keys
+struct sorted_unique_t { explicit sorted_unique_t() = default; };
+constexpr sorted_unique_t sorted_unique = sorted_unique_t();
+
+
+CUSTOM_DETAIL_BEGIN
+
+template<class Reference>
+struct _Flat_Arrow_Proxy						// operator-> for iterators that return a pair of references by value
+{
+	Reference _Ref;
+
+	constexpr Reference* operator->() noexcept {
+		return &_Ref;
+	}
+};
+
+template<class Container, class Compare>
+constexpr void _flat_sort_unique(Container& values, Compare comp) {		// One sort, then keep the first of every equivalent run
+	custom::sort(values.begin(), values.end(), comp);
+
+	auto newLast = custom::unique(values.begin(), values.end(),
+									[&comp](const auto& left, const auto& right) { return !comp(left, right); });
+
+	for (size_t newSize = static_cast<size_t>(newLast - values.begin()); values.size() > newSize; /*Empty*/)
+		values.pop_back();
+}
+
+CUSTOM_DETAIL_END
+
+CUSTOM_END
\ No newline at end of file
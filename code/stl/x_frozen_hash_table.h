@@ -0,0 +1,249 @@
+#pragma once
+#include "c_array.h"
+#include "c_functional.h"
+#include "c_string_view.h"
+
+
+CUSTOM_BEGIN
+
+template<class Key>
+struct frozen_hash									// constexpr hash used by frozen containers
+{
+	static_assert(is_integral_v<Key> || is_enum_v<Key>, "frozen_hash supports integral, enum and string_view keys. Provide a constexpr hasher for other types.");
+
+	constexpr size_t operator()(const Key& key) const noexcept {
+		return static_cast<size_t>(key);			// mixed by the table
+	}
+};
+
+template<class Type, class Traits>
+struct frozen_hash<basic_string_view<Type, Traits>>
+{
+	constexpr size_t operator()(const basic_string_view<Type, Traits> key) const noexcept {
+		if constexpr (sizeof(Type) == 1)
+			return detail::_wyhash_bytes(key.data(), key.size());		// same word hash as hash<string_view>
+		else
+			return detail::_fnv1a_append_chars(detail::_FNVOffsetBasis, key.data(), key.size());
+	}
+};
+
+
+CUSTOM_DETAIL_BEGIN
+
+template<size_t Size>
+struct _Frozen_Layout								// Result of the perfect hash search
+{
+	array<size_t, Size> _Seeds;						// per bucket: displacement seed, or slot index tagged with _DIRECT
+	array<size_t, Size> _Order;						// per slot: index of the source element
+};
+
+
+template<class Traits, size_t Size>
+class _Frozen_Hash_Table		// Immutable table with a minimal perfect hash built at compile time (hash and displace)
+{
+	// Every key is hashed once. The hash selects a bucket, and the bucket's seed remixes the hash
+	// into a slot, so a lookup is one hash, one seed read and one key compare.
+	// Buckets holding a single key store their slot directly.
+
+	static_assert(Size > 0, "Frozen containers require at least one element.");
+
+public:
+	using key_type			= typename Traits::key_type;
+	using mapped_type		= typename Traits::mapped_type;
+	using hasher			= typename Traits::hasher;
+	using key_compare		= typename Traits::key_compare;
+	using value_type		= typename Traits::value_type;
+	using difference_type	= ptrdiff_t;
+	using reference			= const value_type&;
+	using const_reference	= const value_type&;
+	using pointer			= const value_type*;
+	using const_pointer		= const value_type*;
+
+	using iterator			= typename array<value_type, Size>::const_iterator;	// elements can't be changed
+	using const_iterator	= iterator;
+
+private:
+	static constexpr size_t _DIRECT		= static_cast<size_t>(1) << (sizeof(size_t) * CHAR_BIT - 1);
+	static constexpr size_t _MAX_SEED	= static_cast<size_t>(1) << 20;
+
+	array<value_type, Size> _elems;					// elements in slot order
+	array<size_t, Size> _seeds;
+	hasher _hash;
+	key_compare _compare;
+
+public:
+	// Constructors
+
+	constexpr _Frozen_Hash_Table(const array<value_type, Size>& values)
+		: _Frozen_Hash_Table(values, _build(values, hasher(), key_compare()), make_index_sequence<Size>{}) { /*Empty*/ }
+
+private:
+	template<size_t... Idx>
+	constexpr _Frozen_Hash_Table(	const array<value_type, Size>& values,
+									const _Frozen_Layout<Size>& layout,
+									index_sequence<Idx...>)
+		: _elems{ values[layout._Order[Idx]]... }, _seeds(layout._Seeds) { /*Empty*/ }
+
+public:
+	// Main functions
+
+	constexpr const_iterator find(const key_type& key) const {
+		return begin() + static_cast<difference_type>(_slot_of(key));
+	}
+
+	constexpr bool contains(const key_type& key) const {
+		return _slot_of(key) != Size;
+	}
+
+	constexpr size_t count(const key_type& key) const {
+		return contains(key) ? 1 : 0;
+	}
+
+	constexpr size_t size() const noexcept {
+		return Size;
+	}
+
+	constexpr size_t max_size() const noexcept {
+		return Size;
+	}
+
+	constexpr bool empty() const noexcept {
+		return false;
+	}
+
+	constexpr hasher hash_function() const {
+		return _hash;
+	}
+
+	constexpr key_compare key_eq() const {
+		return _compare;
+	}
+
+public:
+	// iterator specific functions
+
+	constexpr const_iterator begin() const noexcept {
+		return _elems.begin();
+	}
+
+	constexpr const_iterator end() const noexcept {
+		return _elems.end();
+	}
+
+	constexpr const_iterator cbegin() const noexcept {
+		return _elems.begin();
+	}
+
+	constexpr const_iterator cend() const noexcept {
+		return _elems.end();
+	}
+
+protected:
+	// Helpers
+
+	constexpr size_t _slot_of(const key_type& key) const {						// slot holding key, or Size if missing
+		const size_t hashVal	= _mix_hash(_hash(key));
+		const size_t slot		= _slot_from(hashVal, _seeds[hashVal % Size]);
+
+		return _compare(Traits::extract_key(_elems[slot]), key) ? slot : Size;
+	}
+
+	static constexpr size_t _slot_from(const size_t hashVal, const size_t seed) noexcept {
+		return (seed & _DIRECT) ? (seed & ~_DIRECT) : _mix_hash(hashVal ^ seed) % Size;
+	}
+
+	static constexpr _Frozen_Layout<Size> _build(	const array<value_type, Size>& values,
+													const hasher& hash,
+													const key_compare& compare) {
+		_Frozen_Layout<Size> layout {};
+		array<size_t, Size> hashes {};
+		array<size_t, Size> bucketSize {};
+		array<size_t, Size> bucketStart {};
+		array<size_t, Size> grouped {};				// element indexes grouped by bucket
+		array<size_t, Size> slots {};				// candidate slots of the bucket being placed
+		array<bool, Size> used {};
+		size_t maxBucketSize = 0;
+
+		for (size_t i = 0; i < Size; ++i)
+		{
+			hashes[i] = _mix_hash(hash(Traits::extract_key(values[i])));
+			++bucketSize[hashes[i] % Size];
+		}
+
+		for (size_t bucket = 0, start = 0; bucket < Size; start += bucketSize[bucket++])
+		{
+			bucketStart[bucket] = start;
+			maxBucketSize		= (bucketSize[bucket] > maxBucketSize) ? bucketSize[bucket] : maxBucketSize;
+		}
+
+		array<size_t, Size> cursor = bucketStart;
+		for (size_t i = 0; i < Size; ++i)
+			grouped[cursor[hashes[i] % Size]++] = i;
+
+		for (size_t count = maxBucketSize; count > 1; --count)						// largest buckets first, while most slots are free
+			for (size_t bucket = 0; bucket < Size; ++bucket)
+			{
+				if (bucketSize[bucket] != count)
+					continue;
+
+				const size_t first = bucketStart[bucket];
+
+				for (size_t i = first; i < first + count; ++i)						// equal full hashes can't be separated by any seed
+					for (size_t j = i + 1; j < first + count; ++j)
+						if (hashes[grouped[i]] == hashes[grouped[j]])
+						{
+							if (compare(Traits::extract_key(values[grouped[i]]), Traits::extract_key(values[grouped[j]])))
+								throw std::invalid_argument("Duplicate key in frozen container.");
+
+							throw std::invalid_argument("Frozen container keys have colliding hashes.");
+						}
+
+				for (size_t seed = 1; ; ++seed)
+				{
+					if (seed == _MAX_SEED)
+						throw std::runtime_error("No perfect hash found for frozen container.");
+
+					bool fits = true;
+					for (size_t k = 0; fits && k < count; ++k)
+					{
+						slots[k] = _mix_hash(hashes[grouped[first + k]] ^ seed) % Size;
+						fits = !used[slots[k]];
+
+						for (size_t m = 0; fits && m < k; ++m)
+							fits = (slots[m] != slots[k]);
+					}
+
+					if (!fits)
+						continue;
+
+					for (size_t k = 0; k < count; ++k)
+					{
+						used[slots[k]]			= true;
+						layout._Order[slots[k]]	= grouped[first + k];
+					}
+
+					layout._Seeds[bucket] = seed;
+					break;
+				}
+			}
+
+		for (size_t bucket = 0, freeSlot = 0; bucket < Size; ++bucket)				// single keys take the remaining slots directly
+		{
+			if (bucketSize[bucket] != 1)
+				continue;
+
+			while (used[freeSlot])
+				++freeSlot;
+
+			used[freeSlot]				= true;
+			layout._Order[freeSlot]		= grouped[bucketStart[bucket]];
+			layout._Seeds[bucket]		= _DIRECT | freeSlot;
+		}
+
+		return layout;
+	}
+}; // END _Frozen_Hash_Table Template
+
+CUSTOM_DETAIL_END
+
+CUSTOM_END
\ No newline at end of file
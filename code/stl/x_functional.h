@@ -1,5 +1,7 @@
 #pragma once
 #include "c_type_traits.h"
+#include "c_bit.h"     // endian
+#include <cstring>   // std::memcpy
 
 
 CUSTOM_BEGIN
@@ -332,10 +334,176 @@ size_t _fnv1a_append_value( const size_t val,
     return _fnv1a_append_bytes(val, &reinterpret_cast<const unsigned char&>(key), sizeof(Key));
 }
 
+// accumulate chars [first, first + count) into partial FNV-1a hash val
+// reads each char byte by byte (little endian), so it can run in constant expressions
+template<class CharType>
+constexpr size_t _fnv1a_append_chars(   size_t val,
+                                        const CharType* const first,
+                                        const size_t count) noexcept {
+
+    for (size_t i = 0; i < count; ++i)
+        for (size_t byte = 0; byte < sizeof(CharType); ++byte)
+        {
+            val ^= (static_cast<size_t>(first[i]) >> (byte * CHAR_BIT)) & 0xFF;
+            val *= _FNVPrime;
+        }
+
+    return val;
+}
+
+// wyhash style hash: 16 bytes per step (48 in three independent lanes for long ranges)
+// each step is a 64x64->128 bit multiply folded back to 64 bits
+constexpr unsigned long long _WySecret[4] = {   0x2D358DCCAA6C78A5ULL, 0x8BB84B93962EACC9ULL,
+                                                0x4B33A62ED433D4A3ULL, 0x4D5A2DA51DE1AA47ULL};
+
+constexpr void _wy_mum(unsigned long long& low, unsigned long long& high) noexcept {    // low, high = low * high
+#if defined __SIZEOF_INT128__
+    const unsigned __int128 product = static_cast<unsigned __int128>(low) * high;
+    low     = static_cast<unsigned long long>(product);
+    high    = static_cast<unsigned long long>(product >> 64);
+#else
+    const unsigned long long lowLow     = (low & 0xFFFFFFFFULL) * (high & 0xFFFFFFFFULL);
+    const unsigned long long lowHigh    = (low & 0xFFFFFFFFULL) * (high >> 32);
+    const unsigned long long highLow    = (low >> 32) * (high & 0xFFFFFFFFULL);
+    const unsigned long long highHigh   = (low >> 32) * (high >> 32);
+    const unsigned long long middle     = (lowLow >> 32) + (lowHigh & 0xFFFFFFFFULL) + (highLow & 0xFFFFFFFFULL);
+
+    low     = (lowLow & 0xFFFFFFFFULL) | (middle << 32);
+    high    = highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+#endif
+}
+
+constexpr unsigned long long _wy_mix(unsigned long long first, unsigned long long second) noexcept {
+    _wy_mum(first, second);
+    return first ^ second;
+}
+
+// unaligned native-endian load of 4 or 8 bytes
+// Byte may be any 1 byte char type, so char ranges can be hashed in constant expressions
+template<class Byte>
+constexpr unsigned long long _wy_read(const Byte* const ptr, const size_t count) noexcept {
+    static_assert(sizeof(Byte) == 1, "Only byte ranges can be hashed.");
+
+    if (!custom::is_constant_evaluated())
+    {
+        if (count == 8)
+        {
+            unsigned long long val;
+            std::memcpy(&val, ptr, 8);
+            return val;
+        }
+
+        unsigned int val;
+        std::memcpy(&val, ptr, 4);
+        return val;
+    }
+
+    unsigned long long val = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const size_t byte = (endian::native == endian::little) ? i : count - 1 - i;
+        val |= static_cast<unsigned long long>(static_cast<unsigned char>(ptr[i])) << (byte * CHAR_BIT);
+    }
+
+    return val;
+}
+
+template<class Byte>
+constexpr unsigned long long _wy_read8(const Byte* const ptr) noexcept {
+    return _wy_read(ptr, 8);
+}
+
+template<class Byte>
+constexpr unsigned long long _wy_read4(const Byte* const ptr) noexcept {
+    return _wy_read(ptr, 4);
+}
+
+// hashes range [first, first + count)
+template<class Byte>
+constexpr size_t _wyhash_bytes(const Byte* first,
+                               const size_t count,
+                               unsigned long long seed = 0) noexcept {
+
+    unsigned long long a;
+    unsigned long long b;
+    seed ^= _wy_mix(seed ^ _WySecret[0], _WySecret[1]);
+
+    if (count <= 16)
+    {
+        if (count >= 4)             // two overlapping 4 byte reads from each end
+        {
+            const size_t shift = (count >> 3) << 2;
+            a = (_wy_read4(first) << 32) | _wy_read4(first + shift);
+            b = (_wy_read4(first + count - 4) << 32) | _wy_read4(first + count - 4 - shift);
+        }
+        else if (count > 0)
+        {
+            a = (static_cast<unsigned long long>(static_cast<unsigned char>(first[0])) << 16) |
+                (static_cast<unsigned long long>(static_cast<unsigned char>(first[count >> 1])) << 8) |
+                static_cast<unsigned char>(first[count - 1]);
+            b = 0;
+        }
+        else
+            a = b = 0;
+    }
+    else
+    {
+        size_t remaining = count;
+
+        if (remaining > 48)
+        {
+            unsigned long long seed1 = seed;
+            unsigned long long seed2 = seed;
+
+            do
+            {
+                seed    = _wy_mix(_wy_read8(first)      ^ _WySecret[1], _wy_read8(first + 8)    ^ seed);
+                seed1   = _wy_mix(_wy_read8(first + 16) ^ _WySecret[2], _wy_read8(first + 24)  ^ seed1);
+                seed2   = _wy_mix(_wy_read8(first + 32) ^ _WySecret[3], _wy_read8(first + 40)  ^ seed2);
+                first       += 48;
+                remaining   -= 48;
+            } while (remaining > 48);
+
+            seed ^= seed1 ^ seed2;
+        }
+
+        while (remaining > 16)
+        {
+            seed        = _wy_mix(_wy_read8(first) ^ _WySecret[1], _wy_read8(first + 8) ^ seed);
+            first       += 16;
+            remaining   -= 16;
+        }
+
+        a = _wy_read8(first + remaining - 16);      // last 16 bytes, may overlap the previous step
+        b = _wy_read8(first + remaining - 8);
+    }
+
+    a ^= _WySecret[1];
+    b ^= seed;
+    _wy_mum(a, b);
+
+    return static_cast<size_t>(_wy_mix(a ^ _WySecret[0] ^ count, b ^ _WySecret[1]));
+}
+
+// default hash for byte ranges
+inline size_t _hash_bytes(  const unsigned char* const first,
+                            const size_t count) noexcept {
+#if CUSTOM_HASH_FNV1A
+    return _fnv1a_append_bytes(_FNVOffsetBasis, first, count);
+#else
+    return _wyhash_bytes(first, count);
+#endif
+}
+
+constexpr size_t _FAST_HASH_MIN_BYTES = 2 * sizeof(size_t);    // smaller keys stay on FNV-1a, which is cheap for a few bytes
+
 // bitwise hashes the representation of a key
 template<class Key>
 size_t _hash_representation(const Key& key) noexcept {
-    return _fnv1a_append_value(_FNVOffsetBasis, key);
+    if constexpr (sizeof(Key) >= _FAST_HASH_MIN_BYTES)
+        return _hash_bytes(&reinterpret_cast<const unsigned char&>(key), sizeof(Key));
+    else
+        return _fnv1a_append_value(_FNVOffsetBasis, key);
 }
 
 // bitwise hashes the representation of an array
@@ -344,7 +512,30 @@ size_t _hash_array_representation(  const Key* const first,
                                     const size_t count) noexcept {
 
     static_assert(is_trivial_v<Key>, "Only trivial types can be directly hashed.");
-    return _fnv1a_append_bytes(_FNVOffsetBasis, reinterpret_cast<const unsigned char*>(first), count * sizeof(Key));
+    return _hash_bytes(reinterpret_cast<const unsigned char*>(first), count * sizeof(Key));
+}
+
+// spreads the entropy of a hash value over all its bits (murmur3 finalizer)
+// used by containers that index with the low/high bits of a possibly weak hash
+constexpr size_t _mix_hash(size_t val) noexcept {
+    if constexpr (sizeof(size_t) == 8)
+    {
+        val ^= val >> 33;
+        val *= static_cast<size_t>(0xFF51AFD7ED558CCDULL);
+        val ^= val >> 33;
+        val *= static_cast<size_t>(0xC4CEB9FE1A85EC53ULL);
+        val ^= val >> 33;
+    }
+    else
+    {
+        val ^= val >> 16;
+        val *= static_cast<size_t>(0x85EBCA6BU);
+        val ^= val >> 13;
+        val *= static_cast<size_t>(0xC2B2AE35U);
+        val ^= val >> 16;
+    }
+
+    return val;
 }
 
 CUSTOM_DETAIL_END   // hash representation
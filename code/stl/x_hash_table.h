@@ -1,28 +1,175 @@
 #pragma once
 #include "c_list.h"
 #include "c_vector.h"
+#include "x_node_handle.h"
 #include "c_pair.h"
 #include "c_utility.h"
 #include "c_functional.h"	// EqualTo, Hash
+#include "c_bit.h"			// bit_ceil
 #include <cmath>			// std::ceil
 
+#if CUSTOM_HASH_TABLE_STATS
+#include "c_chrono.h"		// rehash timing
+#endif
+
 
 CUSTOM_BEGIN
 
+// Decides whether _Hash_Table nodes store the (mixed) hash of their key.
+// Cached hashes make rehash free of hashing and reject most mismatches before key_compare.
+// Keys that are cheap to hash are not cached by default. Specialize to override.
+template<class Key, class Hash>
+struct _Cache_Hash_Code : bool_constant<!(is_arithmetic_v<Key> || is_enum_v<Key> || is_pointer_v<Key>)> {};
+
+
+// Key extraction from emplace arguments (Args are cv-ref removed)
+// When extractable, containers probe for the key before constructing (and allocating) anything
+template<class Key, class... Args>
+struct _In_Place_Key_Extract_Set							// unordered_set: emplace(key)
+{
+	static constexpr bool _Extractable = false;
+};
+
+template<class Key>
+struct _In_Place_Key_Extract_Set<Key, Key>
+{
+	static constexpr bool _Extractable = true;
+
+	static const Key& _extract(const Key& key) noexcept {
+		return key;
+	}
+};
+
+template<class Key, class... Args>
+struct _In_Place_Key_Extract_Map							// unordered_map: emplace(key, val) or emplace(pair)
+{
+	static constexpr bool _Extractable = false;
+};
+
+template<class Key, class Second>
+struct _In_Place_Key_Extract_Map<Key, Key, Second>
+{
+	static constexpr bool _Extractable = true;
+
+	static const Key& _extract(const Key& key, const Second&) noexcept {
+		return key;
+	}
+};
+
+template<class Key, class Second>
+struct _In_Place_Key_Extract_Map<Key, pair<Key, Second>>
+{
+	static constexpr bool _Extractable = true;
+
+	static const Key& _extract(const pair<Key, Second>& val) noexcept {
+		return val.first;
+	}
+};
+
+#if CUSTOM_HASH_TABLE_STATS
+struct hash_table_stats						// snapshot returned by stats()
+{
+	size_t bucket_count					= 0;
+	size_t size							= 0;
+	size_t empty_buckets				= 0;
+	size_t max_chain					= 0;
+	vector<size_t> chain_histogram;			// chain_histogram[n] = number of buckets holding n nodes
+
+	size_t rehash_count					= 0;	// full rehashes and started incremental rehashes
+	double rehash_ms					= 0;	// cumulative, including incremental migration steps
+
+	size_t successful_finds				= 0;
+	size_t successful_comparisons		= 0;	// nodes inspected by successful finds
+	size_t unsuccessful_finds			= 0;
+	size_t unsuccessful_comparisons		= 0;	// nodes inspected by unsuccessful finds
+
+	double average_successful_comparisons() const noexcept {
+		return successful_finds == 0 ? 0.0 : static_cast<double>(successful_comparisons) / static_cast<double>(successful_finds);
+	}
+
+	double average_unsuccessful_comparisons() const noexcept {
+		return unsuccessful_finds == 0 ? 0.0 : static_cast<double>(unsuccessful_comparisons) / static_cast<double>(unsuccessful_finds);
+	}
+};	// END hash_table_stats
+#endif	// CUSTOM_HASH_TABLE_STATS
+
 CUSTOM_DETAIL_BEGIN
 
+#if CUSTOM_HASH_TABLE_STATS
+struct _Hash_Table_Counters					// updated by const lookups, so increments are relaxed atomics where available
+{
+	size_t _RehashCount					= 0;
+	long long _RehashNanoseconds		= 0;
+	size_t _SuccessfulFinds				= 0;
+	size_t _SuccessfulComparisons		= 0;
+	size_t _UnsuccessfulFinds			= 0;
+	size_t _UnsuccessfulComparisons		= 0;
+
+	template<class Ty>
+	static void _add(Ty& counter, const Ty val) noexcept {
+#if defined __GNUG__
+		__atomic_fetch_add(&counter, val, __ATOMIC_RELAXED);
+#else
+		counter += val;
+#endif
+	}
+
+	template<class Ty>
+	static Ty _load(const Ty& counter) noexcept {
+#if defined __GNUG__
+		return __atomic_load_n(&counter, __ATOMIC_RELAXED);
+#else
+		return counter;
+#endif
+	}
+};	// END _Hash_Table_Counters
+
+class _Rehash_Timer							// adds its lifetime to the rehash time of counters
+{
+private:
+	_Hash_Table_Counters& _Counters;
+	chrono::steady_clock::time_point _Start;
+
+public:
+	explicit _Rehash_Timer(_Hash_Table_Counters& counters)
+		: _Counters(counters), _Start(chrono::steady_clock::now()) { /*Empty*/ }
+
+	~_Rehash_Timer() {
+		auto elapsed = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - _Start);
+		_Hash_Table_Counters::_add(_Counters._RehashNanoseconds, static_cast<long long>(elapsed.count()));
+	}
+
+	_Rehash_Timer(const _Rehash_Timer&)				= delete;
+	_Rehash_Timer& operator=(const _Rehash_Timer&)	= delete;
+};	// END _Rehash_Timer
+#endif	// CUSTOM_HASH_TABLE_STATS
+
+template<class NodePtr>
+struct _Hash_Bucket					// trivial, so a new bucket array can be left unwritten until migration reaches it
+{
+	size_t first;					// node count
+	NodePtr second;					// first node in bucket
+};	// END _Hash_Bucket
+
 // _Hash_Table Template implemented as vector of nodes stored in a list
-// The vector holds pairs for bucket count and the first node in bucket
+// The vector holds buckets with the node count and the first node in bucket
+// Bucket count is a power of 2 and the bucket index is a mask of the mixed hash
+// In incremental rehash mode growth keeps the old buckets and migrates a few of them on every insert
 template<class Traits>
 class _Hash_Table
 {
 protected:
-	using _Iter_List			= list<typename Traits::value_type, typename Traits::allocator_type>;		// list of value_type used for iteration
+	static constexpr bool _CACHE_HASH = _Cache_Hash_Code<typename Traits::key_type, typename Traits::hasher>::value;
+
+	using _Node_Type			= conditional_t<_CACHE_HASH,
+												_Hashed_Double_Node<typename Traits::value_type>,
+												_Double_Node<typename Traits::value_type>>;
+	using _Iter_List			= list<typename Traits::value_type, typename Traits::allocator_type, _Node_Type>;		// list of value_type used for iteration
 	using _Alloc_Node			= typename _Iter_List::_Alloc_Node;
 	using _Alloc_Node_Traits	= typename _Iter_List::_Alloc_Node_Traits;
 	using _NodePtr 				= typename _Iter_List::_NodePtr;
-	using _Bucket 				= pair<size_t, _NodePtr>;
-	using _Hash_Vector			= vector<_Bucket>;						// vector of pairs
+	using _Bucket 				= _Hash_Bucket<_NodePtr>;
+	using _Hash_Vector			= vector<_Bucket>;						// vector of buckets
 
 	using key_type           	= typename Traits::key_type;
     using mapped_type        	= typename Traits::mapped_type;
@@ -40,15 +187,33 @@ protected:
 	using iterator				= typename _Iter_List::iterator;			// iterator for this container (identical to list iterator)
 	using const_iterator		= typename _Iter_List::const_iterator;
 
+	using node_type				= _Node_Handle<_Node_Type, _Alloc_Node, Traits>;
+	using insert_return_type	= _Insert_Return_Type<iterator, node_type>;
+
+	template<class KeyType>
+	using _Enable_Transparent	= enable_if_t<conjunction_v<				// heterogeneous lookup when both hasher and key_compare allow it
+												_Is_Transparent<hasher>,
+												_Is_Transparent<key_compare>,
+												negation<is_convertible<KeyType, const_iterator>>>,
+									bool>;
+
 protected:
 	hasher _hash;														// Used for initial(non-compressed) hash value
 	key_compare _compare;												// Used for comparison between keys
 	_Iter_List _elems;													// Used to iterate through container
 	_Hash_Vector _buckets;												// Used to map elems from _Iter_List
 	_Alloc_Node _alloc;													// Used to allocate nodes
+	_Hash_Vector _oldBuckets;											// Buckets not yet migrated by an incremental rehash (empty if none in progress)
+	size_t _migrateIndex		= 0;									// First old bucket not yet migrated
+	bool _incremental			= false;								// Grow by migrating buckets gradually instead of all at once
+
+#if CUSTOM_HASH_TABLE_STATS
+	mutable _Hash_Table_Counters _counters;								// Lookup and rehash statistics (not copied or moved)
+#endif
 
 	static constexpr float _TABLE_LOAD_FACTOR	= 0.75;					// The maximum load factor admitted before rehashing
 	static constexpr size_t _DEFAULT_BUCKETS	= 8;					// Default number of buckets
+	static constexpr size_t _MIGRATE_STEP		= 4;					// Old buckets migrated per insert (> 1 / _TABLE_LOAD_FACTOR, so it ends before the next growth)
 
 protected:
     // Constructors
@@ -61,11 +226,16 @@ protected:
 		rehash((noBuckets < _DEFAULT_BUCKETS) ? _DEFAULT_BUCKETS : noBuckets);
 	}
 
-	_Hash_Table(const _Hash_Table& other)
-		: _elems(other._elems), _buckets(other._buckets) { /*Empty*/ }
+	_Hash_Table(const _Hash_Table& other) {
+		_copy(other);
+	}
 
 	_Hash_Table(_Hash_Table&& other) noexcept
-		: _elems(custom::move(other._elems)), _buckets(custom::move(other._buckets)) { /*Empty*/ }
+		:	_elems(custom::move(other._elems)),
+			_buckets(custom::move(other._buckets)),
+			_oldBuckets(custom::move(other._oldBuckets)),
+			_migrateIndex(custom::exchange(other._migrateIndex, 0)),
+			_incremental(other._incremental) { /*Empty*/ }
 
 	virtual ~_Hash_Table() = default;
 
@@ -75,8 +245,8 @@ protected:
 	_Hash_Table& operator=(const _Hash_Table& other) {
 		if (_elems._data._Head != other._elems._data._Head)
 		{
-			_elems 		= other._elems;
-			_buckets 	= other._buckets;
+			_elems.clear();
+			_copy(other);
 		}
 
 		return *this;
@@ -85,8 +255,11 @@ protected:
 	_Hash_Table& operator=(_Hash_Table&& other) noexcept {
 		if (_elems._data._Head != other._elems._data._Head)
 		{
-			_elems 		= custom::move(other._elems);
-			_buckets 	= custom::move(other._buckets);
+			_elems 			= custom::move(other._elems);
+			_buckets 		= custom::move(other._buckets);
+			_oldBuckets		= custom::move(other._oldBuckets);
+			_migrateIndex	= custom::exchange(other._migrateIndex, 0);
+			_incremental	= other._incremental;
 		}
 
 		return *this;
@@ -95,47 +268,34 @@ protected:
 public:
 	// Main Functions
 
-    template<class... Args>
+	template<class... Args>
 	iterator emplace(Args&&... args) {
-		_NodePtr newNode 		= _alloc.allocate(1);
-		_Alloc_Node_Traits::construct(_alloc, &(newNode->_Value), custom::forward<Args>(args)...);
-		const key_type& newKey 	= Traits::extract_key(newNode->_Value);
-		iterator it 			= find(newKey);
+		using _Extractor = typename Traits::template _In_Place_Key_Extractor<remove_cv_ref_t<Args>...>;
 
-		if (it != end())	// Destroy newly-created Node if key exists
-		{
-			_Alloc_Node_Traits::destroy(_alloc, &(newNode->_Value));
-			_alloc.deallocate(newNode, 1);
-			return it;
-		}
+		if constexpr (_Extractor::_Extractable)
+			return _emplace_with_key(_Extractor::_extract(args...), custom::forward<Args>(args)...);
 		else
-		{
-			_rehash_if_overload();
-			_map_and_link_node(bucket(newKey), newNode);
+			return _emplace_node_first(custom::forward<Args>(args)...);
+	}
 
-			return iterator(newNode, &_elems._data);
-		}
+	template<class... Args>
+	iterator emplace_hint(const_iterator hint, Args&&... args) {	// hint is used to skip hashing when it already holds the key
+		using _Extractor = typename Traits::template _In_Place_Key_Extractor<remove_cv_ref_t<Args>...>;
+
+		if constexpr (_Extractor::_Extractable)
+			if (hint != end() && _compare(Traits::extract_key(*hint), _Extractor::_extract(args...)))
+				return iterator(hint._Ptr, &_elems._data);
+
+		return emplace(custom::forward<Args>(args)...);
 	}
 
 	iterator erase(const key_type& key) {
-		iterator it = find(key);
-
-		if (it == end())
-			return it;
+		return _erase(key);
+	}
 
-		// Update bucket
-		size_t index = bucket(key);
-		if (it._Ptr == _buckets[index].second)	// is the starting node in bucket
-		{
-			if (_buckets[index].first == 1)	// is the only node in bucket
-				_buckets[index].second = nullptr;
-			else
-				_buckets[index].second = it._Ptr->_Next;
-		}
-		--_buckets[index].first;
-		
-		// Remove value from iteration list and return next Node iterator
-		return _elems.erase(it);
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	iterator erase(const KeyType& key) {
+		return _erase(key);
 	}
 
 	iterator erase(iterator where) {
@@ -152,20 +312,108 @@ public:
 		return erase(Traits::extract_key(*where));
 	}
 
+	insert_return_type insert(node_type&& node) {					// Relink an extracted node, no allocation
+		if (node.empty())
+			return {end(), false, node_type()};
+
+		const key_type& key		= Traits::extract_key(node.value());
+		const size_t hashVal	= _hash_of(key);
+		_NodePtr found			= _find(key, hashVal);
+
+		if (found != _elems._data._Head)	// node stays with the caller
+			return {iterator(found, &_elems._data), false, custom::move(node)};
+
+		_NodePtr newNode = node._release();
+		_set_node_hash(newNode, hashVal);
+		_rehash_if_overload();
+		_map_and_link_node(_bucket_of(hashVal), newNode);
+
+		return {iterator(newNode, &_elems._data), true, node_type()};
+	}
+
+	iterator insert(const_iterator, node_type&& node) {
+		return insert(custom::move(node)).position;
+	}
+
+	node_type extract(const_iterator where) {						// Unlink node and hand it over, no deallocation
+		if (where == end())
+			throw std::out_of_range("extract iterator outside range.");
+
+		_NodePtr node = where._Ptr;
+		_extract_node(node, _node_hash(node));
+
+		return node_type(node, _alloc);
+	}
+
+	node_type extract(const key_type& key) {
+		const size_t hashVal	= _hash_of(key);
+		_NodePtr found			= _find(key, hashVal);
+
+		if (found == _elems._data._Head)
+			return node_type();
+
+		_extract_node(found, hashVal);
+		return node_type(found, _alloc);
+	}
+
+	void merge(_Hash_Table& source) {								// Relink nodes whose keys are missing here, duplicates stay in source
+		if (_elems._data._Head == source._elems._data._Head)
+			return;
+
+		for (_NodePtr node = source._elems._data._Head->_Next; node != source._elems._data._Head; /*Empty*/)
+		{
+			_NodePtr next			= node->_Next;
+			const key_type& key		= Traits::extract_key(node->_Value);
+			const size_t hashVal	= _hash_of(key);
+
+			if (_find(key, hashVal) == _elems._data._Head)
+			{
+				source._extract_node(node, source._node_hash(node));
+				_set_node_hash(node, hashVal);
+				_rehash_if_overload();
+				_map_and_link_node(_bucket_of(hashVal), node);
+			}
+
+			node = next;
+		}
+	}
+
+	void merge(_Hash_Table&& source) {
+		merge(source);
+	}
+
 	iterator find(const key_type& key) {
-		return iterator(_find(key), &_elems._data);
+		return iterator(_find(key, _hash_of(key)), &_elems._data);
 	}
 
 	const_iterator find(const key_type& key) const {
-		return const_iterator(_find(key), &_elems._data);
+		return const_iterator(_find(key, _hash_of(key)), &_elems._data);
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	iterator find(const KeyType& key) {
+		return iterator(_find(key, _hash_of(key)), &_elems._data);
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	const_iterator find(const KeyType& key) const {
+		return const_iterator(_find(key, _hash_of(key)), &_elems._data);
 	}
 
 	bool contains(const key_type& key) const {
 		return find(key) != end();
 	}
 
-	void rehash(const size_t noBuckets) {							// rebuild table with at least noBuckets
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	bool contains(const KeyType& key) const {
+		return find(key) != end();
+	}
+
+	void rehash(const size_t noBuckets) {							// rebuild table with at least noBuckets (rounded to a power of 2)
+		_finish_migration();
+
 		size_t newBucketCount = (custom::max)(_min_load_factor_buckets(size()), noBuckets);	// don't violate bucket_count() >= size() / max_load_factor()
+		newBucketCount = custom::bit_ceil(newBucketCount);
 		if (newBucketCount > bucket_count())
 			_force_rehash(newBucketCount);
 	}
@@ -176,6 +424,7 @@ public:
 
 	void clear() {
 		_elems.clear();						// Delete all Node* with values
+		_drop_migration();
 
 		for (auto& val : _buckets)			// Update _buckets to empty
 		{
@@ -189,11 +438,22 @@ public:
 	}
 
 	size_t bucket_size(const size_t index) const {					// Get the size of the bucket at index
-		return _buckets[index].first;
+		if (!_is_migrating() || (index & (_oldBuckets.size() - 1)) < _migrateIndex)
+			return _buckets[index].first;
+
+		const size_t oldIndex = index & (_oldBuckets.size() - 1);
+
+		size_t count		= 0;					// not migrated yet, count the old bucket nodes that will land here
+		_NodePtr current	= _oldBuckets[oldIndex].second;
+		for (size_t i = 0; i < _oldBuckets[oldIndex].first; ++i, current = current->_Next)
+			if (_bucket_index(_node_hash(current)) == index)
+				++count;
+
+		return count;
 	}
 
 	size_t bucket(const key_type& key) const {						// Get bucket index from key
-		return _hash(key) % bucket_count();
+		return _bucket_index(_hash_of(key));
 	}
 
 	size_t size() const {
@@ -216,7 +476,55 @@ public:
 		return _TABLE_LOAD_FACTOR;
 	}
 
+	void set_incremental_rehash(const bool incremental) {			// Bound the work of a single insert during growth
+		if (!incremental)
+			_finish_migration();
+
+		_incremental = incremental;
+	}
+
+	bool incremental_rehash() const noexcept {
+		return _incremental;
+	}
+
+#if CUSTOM_HASH_TABLE_STATS
+	hash_table_stats stats() const {								// O(bucket_count()) snapshot of chains and counters
+		hash_table_stats result;
+		result.bucket_count		= bucket_count();
+		result.size				= size();
+
+		for (size_t i = 0; i < bucket_count(); ++i)
+		{
+			const size_t chain = bucket_size(i);
+
+			if (chain >= result.chain_histogram.size())
+				result.chain_histogram.resize(chain + 1);
+
+			++result.chain_histogram[chain];
+			result.max_chain = (custom::max)(result.max_chain, chain);
+		}
+
+		if (!result.chain_histogram.empty())
+			result.empty_buckets = result.chain_histogram[0];
+
+		result.rehash_count					= _Hash_Table_Counters::_load(_counters._RehashCount);
+		result.rehash_ms					= static_cast<double>(_Hash_Table_Counters::_load(_counters._RehashNanoseconds)) / 1e6;
+		result.successful_finds				= _Hash_Table_Counters::_load(_counters._SuccessfulFinds);
+		result.successful_comparisons		= _Hash_Table_Counters::_load(_counters._SuccessfulComparisons);
+		result.unsuccessful_finds			= _Hash_Table_Counters::_load(_counters._UnsuccessfulFinds);
+		result.unsuccessful_comparisons		= _Hash_Table_Counters::_load(_counters._UnsuccessfulComparisons);
+
+		return result;
+	}
+
+	void reset_stats() noexcept {
+		_counters = _Hash_Table_Counters();
+	}
+#endif	// CUSTOM_HASH_TABLE_STATS
+
 	void print_details()  {									// For Debugging
+		_finish_migration();
+
 		std::cout << "Capacity= " << _buckets.size() << ' ' << "Size= " << _elems.size() << '\n';
 
 		for (size_t i = 0; i < _buckets.size(); ++i)
@@ -257,10 +565,19 @@ protected:
 
 	template<class _KeyType, class... Args>
 	pair<iterator, bool> _try_emplace(_KeyType&& key, Args&&... args) {			// Force construction with known key and given arguments for object
-		iterator it = find(key);		// Check key and decide to construct or not
+		const size_t hashVal = _hash_of(key);
+		return _try_emplace_hashed(hashVal, custom::forward<_KeyType>(key), custom::forward<Args>(args)...);
+	}
 
-		if (it != end())
-			return {it, false};
+	// The _hashed functions take hashVal = _mix_hash(hasher()(key)), computed once by a caller
+	// that also uses it elsewhere (concurrent_unordered_map picks the shard from its high bits)
+
+	template<class _KeyType, class... Args>
+	pair<iterator, bool> _try_emplace_hashed(const size_t hashVal, _KeyType&& key, Args&&... args) {
+		_NodePtr found = _find(key, hashVal);		// Check key and decide to construct or not
+
+		if (found != _elems._data._Head)
+			return {iterator(found, &_elems._data), false};
 		else
 		{
 			_NodePtr newNode = _alloc.allocate(1);
@@ -271,15 +588,40 @@ protected:
 										custom::forward_as_tuple(custom::forward<_KeyType>(key)),
 										custom::forward_as_tuple(custom::forward<Args>(args)...)
 										);
-			const key_type& newKey = Traits::extract_key(newNode->_Value);
 
+			_set_node_hash(newNode, hashVal);
 			_rehash_if_overload();
-			_map_and_link_node(bucket(newKey), newNode);
+			_map_and_link_node(_bucket_of(hashVal), newNode);
 
 			return {iterator(newNode, &_elems._data), true};
 		}
 	}
 
+	template<class KeyType>
+	iterator _find_hashed(const KeyType& key, const size_t hashVal) {
+		return iterator(_find(key, hashVal), &_elems._data);
+	}
+
+	template<class KeyType>
+	const_iterator _find_hashed(const KeyType& key, const size_t hashVal) const {
+		return const_iterator(_find(key, hashVal), &_elems._data);
+	}
+
+	template<class KeyType>
+	iterator _erase_hashed(const KeyType& key, const size_t hashVal) {
+		_NodePtr found = _find(key, hashVal);
+
+		if (found == _elems._data._Head)
+			return end();
+
+		_NodePtr next = found->_Next;
+		_extract_node(found, hashVal);
+		_Alloc_Node_Traits::destroy(_alloc, &(found->_Value));
+		_alloc.deallocate(found, 1);
+
+		return iterator(next, &_elems._data);
+	}
+
 	const mapped_type& _at(const key_type& key) const {				// Access _Value at key with check
 		const_iterator it = find(key);
 
@@ -301,35 +643,169 @@ protected:
 private:
 	// Helpers
 
-	_NodePtr _find(const key_type& key) const {
-		const _Bucket& currentBucket 	= _buckets[bucket(key)];
+	template<class KeyType>
+	size_t _hash_of(const KeyType& key) const {						// mixed, so that masking keeps the entropy of weak hashes
+		return detail::_mix_hash(_hash(key));
+	}
+
+	size_t _bucket_index(const size_t hashVal) const noexcept {
+		return hashVal & (bucket_count() - 1);
+	}
+
+	size_t _node_hash(_NodePtr node) const {						// stored hash, or recomputed if not cached
+		if constexpr (_CACHE_HASH)
+			return node->_Hash;
+		else
+			return _hash_of(Traits::extract_key(node->_Value));
+	}
+
+	bool _is_migrating() const noexcept {
+		return !_oldBuckets.empty();
+	}
+
+	_Bucket& _bucket_of(const size_t hashVal) {						// the bucket currently holding hashVal (old if not migrated yet)
+		if (_is_migrating())
+		{
+			const size_t oldIndex = hashVal & (_oldBuckets.size() - 1);
+			if (oldIndex >= _migrateIndex)
+				return _oldBuckets[oldIndex];
+		}
+
+		return _buckets[_bucket_index(hashVal)];
+	}
+
+	const _Bucket& _bucket_of(const size_t hashVal) const {
+		return const_cast<_Hash_Table*>(this)->_bucket_of(hashVal);
+	}
+
+	static void _set_node_hash(_NodePtr node, const size_t hashVal) noexcept {
+		if constexpr (_CACHE_HASH)
+			node->_Hash = hashVal;
+		else
+			(void)node, (void)hashVal;
+	}
+
+	static bool _node_hash_may_match(_NodePtr node, const size_t hashVal) noexcept {	// cheap rejection before key_compare
+		if constexpr (_CACHE_HASH)
+			return node->_Hash == hashVal;
+		else
+			return (void)node, (void)hashVal, true;
+	}
+
+	template<class... Args>
+	iterator _emplace_node_first(Args&&... args) {					// key unknown until the value is constructed
+		_NodePtr newNode 		= _alloc.allocate(1);
+		_Alloc_Node_Traits::construct(_alloc, &(newNode->_Value), custom::forward<Args>(args)...);
+		const key_type& newKey 	= Traits::extract_key(newNode->_Value);
+		const size_t hashVal	= _hash_of(newKey);
+		_NodePtr found			= _find(newKey, hashVal);
+
+		if (found != _elems._data._Head)	// Destroy newly-created Node if key exists
+		{
+			_Alloc_Node_Traits::destroy(_alloc, &(newNode->_Value));
+			_alloc.deallocate(newNode, 1);
+			return iterator(found, &_elems._data);
+		}
+		else
+		{
+			_set_node_hash(newNode, hashVal);
+			_rehash_if_overload();
+			_map_and_link_node(_bucket_of(hashVal), newNode);
+
+			return iterator(newNode, &_elems._data);
+		}
+	}
+
+	template<class... Args>
+	iterator _emplace_with_key(const key_type& key, Args&&... args) {	// probe first, allocate only on a miss
+		const size_t hashVal	= _hash_of(key);
+		_NodePtr found			= _find(key, hashVal);
+
+		if (found != _elems._data._Head)
+			return iterator(found, &_elems._data);
+
+		_NodePtr newNode = _alloc.allocate(1);	// key may refer to args, don't use it after construction
+		_Alloc_Node_Traits::construct(_alloc, &(newNode->_Value), custom::forward<Args>(args)...);
+
+		_set_node_hash(newNode, hashVal);
+		_rehash_if_overload();
+		_map_and_link_node(_bucket_of(hashVal), newNode);
+
+		return iterator(newNode, &_elems._data);
+	}
+
+	template<class KeyType>
+	_NodePtr _find(const KeyType& key, const size_t hashVal) const {
+		if (_elems._data._Size == 0)	// also covers moved-from tables without buckets
+			return _elems._data._Head;
+
+		const _Bucket& currentBucket 	= _bucket_of(hashVal);
 		size_t remainingNodes			= currentBucket.first;
 		_NodePtr currentNode			= currentBucket.second;
 
-		while (remainingNodes > 0 && !_compare(Traits::extract_key(currentNode->_Value), key))
+		while (remainingNodes > 0 &&
+				!(_node_hash_may_match(currentNode, hashVal) && _compare(Traits::extract_key(currentNode->_Value), key)))
 		{
 			currentNode = currentNode->_Next;
 			--remainingNodes;
 		}
 
+#if CUSTOM_HASH_TABLE_STATS
+		if (remainingNodes == 0)
+		{
+			_Hash_Table_Counters::_add(_counters._UnsuccessfulFinds, size_t(1));
+			_Hash_Table_Counters::_add(_counters._UnsuccessfulComparisons, currentBucket.first);
+		}
+		else
+		{
+			_Hash_Table_Counters::_add(_counters._SuccessfulFinds, size_t(1));
+			_Hash_Table_Counters::_add(_counters._SuccessfulComparisons, currentBucket.first - remainingNodes + 1);
+		}
+#endif
+
 		if (remainingNodes == 0)	// not found
 			return _elems._data._Head;
 
 		return currentNode;
 	}
 
-	void _map_and_link_node(size_t index, _NodePtr newNode) {
-		if (_buckets[index].first == 0)	// bucket is empty
+	template<class KeyType>
+	iterator _erase(const KeyType& key) {
+		return _erase_hashed(key, _hash_of(key));
+	}
+
+	void _extract_node(_NodePtr node, const size_t hashVal) {		// unlink node from its bucket and from the iteration list
+		_Bucket& currentBucket = _bucket_of(hashVal);
+		if (node == currentBucket.second)	// is the starting node in bucket
+		{
+			if (currentBucket.first == 1)	// is the only node in bucket
+				currentBucket.second = nullptr;
+			else
+				currentBucket.second = node->_Next;
+		}
+		--currentBucket.first;
+
+		_elems._unlink_node(node);
+	}
+
+	void _map_and_link_node(_Bucket& bucket, _NodePtr newNode) {
+		if (bucket.first == 0)	// bucket is empty
 			_elems._link_node_before(_elems._data._Head, newNode);	// link last
 		else
-			_elems._link_node_before(_buckets[index].second, newNode);	// link before the first one in bucket
+			_elems._link_node_before(bucket.second, newNode);	// link before the first one in bucket
 
 		// update bucket
-		++_buckets[index].first;
-		_buckets[index].second = newNode;
+		++bucket.first;
+		bucket.second = newNode;
 	}
 
-	void _force_rehash(const size_t noBuckets) {
+	void _force_rehash(const size_t noBuckets) {					// works on any node order, so pending migration is simply dropped
+#if CUSTOM_HASH_TABLE_STATS
+		_Hash_Table_Counters::_add(_counters._RehashCount, size_t(1));
+		_Rehash_Timer timer(_counters);
+#endif
+
+		_drop_migration();
 		_buckets.realloc(noBuckets);
 
 		for (auto it = _elems.begin(); it != _elems.end(); /*no increment here*/)
@@ -337,8 +813,8 @@ private:
 			// save next iterator
 			auto nextIter = custom::next(it);
 
-			// remap node
-			size_t index = bucket(Traits::extract_key(*it));
+			// remap node (no hashing when cached)
+			size_t index = _bucket_index(_node_hash(it._Ptr));
 			if (_buckets[index].first == 0)	// bucket is empty
 			{
 				// do nothing - no need to relink
@@ -360,8 +836,100 @@ private:
 	}
 
 	void _rehash_if_overload() {									// Check load factor and rehash if needed
+		if (bucket_count() == 0)									// moved-from
+		{
+			_force_rehash(_DEFAULT_BUCKETS);
+			return;
+		}
+
+		if (_is_migrating())
+			_migrate_buckets(_MIGRATE_STEP);
+
 		if (static_cast<float>(size() + 1) / static_cast<float>(bucket_count()) > max_load_factor())
-			_force_rehash(2 * bucket_count());
+		{
+			if (_incremental)
+				_start_migration(2 * bucket_count());
+			else
+				_force_rehash(2 * bucket_count());
+		}
+	}
+
+	void _start_migration(const size_t noBuckets) {					// current buckets become old, nodes move over on later inserts
+		_finish_migration();
+
+#if CUSTOM_HASH_TABLE_STATS
+		_Hash_Table_Counters::_add(_counters._RehashCount, size_t(1));
+#endif
+
+		_oldBuckets		= custom::move(_buckets);
+		_migrateIndex	= 0;
+		_buckets.resize_for_overwrite(noBuckets);					// no O(n) fill, _migrate_buckets clears each new bucket before use
+
+		_migrate_buckets(_MIGRATE_STEP);
+	}
+
+	void _migrate_buckets(size_t count) {							// relink the nodes of the next count old buckets into the new ones
+#if CUSTOM_HASH_TABLE_STATS
+		_Rehash_Timer timer(_counters);
+#endif
+
+		// nodes of an old bucket only land in new buckets fed by that same old bucket,
+		// so relinking inside its run keeps every new bucket contiguous
+		for (/*Empty*/; count > 0 && _migrateIndex < _oldBuckets.size(); --count, ++_migrateIndex)
+		{
+			const _Bucket& oldBucket	= _oldBuckets[_migrateIndex];
+			_NodePtr current			= oldBucket.second;
+
+			// new buckets fed by this old one are unread until now (index & (old size - 1) == _migrateIndex)
+			for (size_t index = _migrateIndex; index < _buckets.size(); index += _oldBuckets.size())
+				_buckets[index] = _Bucket{0, nullptr};
+
+			for (size_t remaining = oldBucket.first; remaining > 0; --remaining)
+			{
+				_NodePtr next		= current->_Next;
+				_Bucket& newBucket	= _buckets[_bucket_index(_node_hash(current))];
+
+				if (newBucket.first != 0)	// else leave in place
+				{
+					_elems._unlink_node(current);
+					_elems._link_node_before(newBucket.second, current);
+				}
+
+				++newBucket.first;
+				newBucket.second	= current;
+				current				= next;
+			}
+		}
+
+		if (_migrateIndex == _oldBuckets.size())
+			_drop_migration();
+	}
+
+	void _finish_migration() {
+		if (_is_migrating())
+			_migrate_buckets(_oldBuckets.size());
+	}
+
+	void _drop_migration() {										// forget old buckets (release memory)
+		_oldBuckets		= _Hash_Vector();
+		_migrateIndex	= 0;
+	}
+
+	void _copy(const _Hash_Table& other) {							// relink copies into own buckets, reusing cached hashes
+		_hash			= other._hash;
+		_compare		= other._compare;
+		_incremental	= other._incremental;
+		_drop_migration();
+		_buckets.realloc((custom::max)(other.bucket_count(), _DEFAULT_BUCKETS));
+
+		for (_NodePtr otherNode = other._elems._data._Head->_Next; otherNode != other._elems._data._Head; otherNode = otherNode->_Next)
+		{
+			_NodePtr newNode = _elems._create_common_node(otherNode->_Value);
+			const size_t hashVal = other._node_hash(otherNode);
+
+			_set_node_hash(newNode, hashVal);
+			_map_and_link_node(_bucket_of(hashVal), newNode);
+		}
 	}
 
 	size_t _min_load_factor_buckets(const size_t size) const {		// returns the minimum number of buckets necessary for the elements in list
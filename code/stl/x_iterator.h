@@ -123,4 +123,38 @@ noexcept(noexcept(pred(left, right)) && noexcept(pred(right, left))) {
     return res;
 }
 
+// segmented iterators
+// Iterators of block based containers (deque, stable_vector) expose the contiguous run of elements
+// that starts at the current one, so algorithms can loop over raw pointers one block at a time.
+// Such an iterator provides:
+//     using _Segmented = true_type;
+//     pointer _segment_first() const noexcept;                     // address of the current element
+//     pointer _segment_last(const Iter& last) const noexcept;      // end of its block, or of [*this, last) if shorter
+template<class Iter, class = void>
+constexpr bool _Is_Segmented_Iterator_v = false;
+
+template<class Iter>
+constexpr bool _Is_Segmented_Iterator_v<Iter, void_t<typename Iter::_Segmented>> = Iter::_Segmented::value;
+
+template<class SegmentedIt, class SegmentFunction>
+constexpr SegmentedIt _for_each_segment(SegmentedIt first, const SegmentedIt last, SegmentFunction func) {
+    // call func(segFirst, segLast) on each contiguous run of [first, last)
+    // func returns where it stopped, anything before segLast ends the walk there
+
+    using _Diff = typename iterator_traits<SegmentedIt>::difference_type;
+
+    while (first != last)
+    {
+        const auto segFirst = first._segment_first();
+        const auto segLast  = first._segment_last(last);
+        const auto stop     = func(segFirst, segLast);
+
+        first += static_cast<_Diff>(stop - segFirst);
+        if (stop != segLast)
+            break;
+    }
+
+    return first;
+}
+
 CUSTOM_END
\ No newline at end of file
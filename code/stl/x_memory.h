@@ -4,6 +4,13 @@
 #include "c_pair.h"
 #include "c_iterator.h"
 
+#include <new>              // std::bad_alloc
+
+#if defined __linux__
+#include <sys/mman.h>       // mmap, mremap, madvise
+#include <unistd.h>         // sysconf
+#endif
+
 
 CUSTOM_BEGIN
 
@@ -562,6 +569,101 @@ public:
 }; // END Allocator
 
 
+CUSTOM_DETAIL_BEGIN
+
+#if defined __linux__
+inline size_t _page_rounded(const size_t bytes) noexcept {
+	static const size_t pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+	return (bytes + pageSize - 1) & ~(pageSize - 1);
+}
+
+inline void* _map_pages(const size_t bytes) {							// Anonymous mapping, backed by huge pages where the kernel allows it
+	void* address = ::mmap(nullptr, _page_rounded(bytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (address == MAP_FAILED)
+		throw std::bad_alloc();
+
+	(void)::madvise(address, _page_rounded(bytes), MADV_HUGEPAGE);		// only a hint, THP may be disabled
+	return address;
+}
+
+inline void* _remap_pages(void* const address, const size_t oldBytes, const size_t newBytes) {	// The kernel moves page table entries, the contents are never copied
+	void* newAddress = ::mremap(address, _page_rounded(oldBytes), _page_rounded(newBytes), MREMAP_MAYMOVE);
+	if (newAddress == MAP_FAILED)
+		throw std::bad_alloc();
+
+	if (newBytes > oldBytes)
+		(void)::madvise(newAddress, _page_rounded(newBytes), MADV_HUGEPAGE);
+
+	return newAddress;
+}
+
+inline void _unmap_pages(void* const address, const size_t bytes) noexcept {
+	(void)::munmap(address, _page_rounded(bytes));
+}
+#endif  // __linux__
+
+CUSTOM_DETAIL_END
+
+
+template<class Type>
+class large_allocator		// Allocator for big blocks, page mapped with huge pages on Linux and plain ::operator new elsewhere
+{
+public:
+	static_assert(!is_const_v<Type>, "The C++ Standard forbids containers of const elements ");
+	static_assert(!is_function_v<Type>, "The C++ Standard forbids allocators for function elements ");
+	static_assert(!is_reference_v<Type>, "The C++ Standard forbids allocators for reference elements ");
+
+public:
+	using value_type        = Type;
+	using difference_type   = ptrdiff_t;
+
+#if defined __linux__
+	static constexpr bool can_reallocate = true;		// reallocate() is available
+#else
+	static constexpr bool can_reallocate = false;
+#endif
+
+public:
+	// Constructors & Operators
+
+	large_allocator() noexcept = default;
+	large_allocator(const large_allocator&) noexcept = default;
+
+	template<class Ty>
+	large_allocator(const large_allocator<Ty>&) noexcept { /*Empty*/ }
+	large_allocator& operator=(const large_allocator&) = default;
+
+	~large_allocator() = default;
+
+public:
+	// Main functions
+
+	Type* allocate(const size_t capacity) {
+		static_assert(sizeof(Type) > 0, "Type must be complete before calling allocate");
+#if defined __linux__
+		return static_cast<Type*>(detail::_map_pages(capacity * sizeof(Type)));
+#else
+		return static_cast<Type*>(::operator new(capacity * sizeof(Type)));
+#endif
+	}
+
+	void deallocate(Type* address, const size_t capacity) {
+		CUSTOM_ASSERT(address != nullptr || capacity > 0, "Invalid block deallocation");
+#if defined __linux__
+		detail::_unmap_pages(address, capacity * sizeof(Type));
+#else
+		::operator delete(address, capacity * sizeof(Type));
+#endif
+	}
+
+#if defined __linux__
+	Type* reallocate(Type* address, const size_t oldCapacity, const size_t newCapacity) {	// Resize the block keeping its bytes, so Type must be trivially relocatable
+		return static_cast<Type*>(detail::_remap_pages(address, oldCapacity * sizeof(Type), newCapacity * sizeof(Type)));
+	}
+#endif
+}; // END large_allocator
+
+
 // check construct/destruct existence
 template<class Alloc, class Ty, class = void>
 struct _Has_Construct_Member_Function : false_type {};
@@ -1,5 +1,6 @@
 #pragma once
 #include "c_utility.h"
+#include <cstdint>		// uintptr_t
 
 
 CUSTOM_BEGIN
@@ -58,15 +59,52 @@ struct _Double_Node			// Struct that holds data and references to next and previ
 
 
 template<class Type>
-struct _Tree_Node			// Used in _Search_Tree
+struct _Hashed_Double_Node		// _Double_Node that also caches the hash of its value (used by _Hash_Table)
 {
 	using value_type = Type;
-	
-	enum class Colors
-	{
-		Red,
-		Black
-	};
+
+	value_type _Value;
+	_Hashed_Double_Node* _Previous 	= nullptr;
+	_Hashed_Double_Node* _Next 		= nullptr;
+	size_t _Hash					= 0;
+
+	_Hashed_Double_Node()										= default;
+	~_Hashed_Double_Node() 										= default;
+	_Hashed_Double_Node(const _Hashed_Double_Node&)				= delete;
+	_Hashed_Double_Node& operator=(const _Hashed_Double_Node&)	= delete;
+
+	_Hashed_Double_Node(const value_type& copyVal)
+		:_Value(copyVal) { /*Empty*/ }
+
+	_Hashed_Double_Node(value_type&& moveVal)
+		:_Value(custom::move(moveVal)) { /*Empty*/ }
+
+	template<class... Args>
+	_Hashed_Double_Node(Args&&... args)
+		: _Value(custom::forward<Args>(args)...) { /*Empty*/ }
+}; // END _Hashed_Double_Node
+
+
+template<bool HasSubtreeSize>
+struct _Tree_Node_Size {};					// no extra field by default
+
+template<>
+struct _Tree_Node_Size<true>				// Used for order statistics
+{
+	size_t _SubtreeSize = 0;				// nodes in the subtree rooted here, 0 for Head
+};
+
+enum class _Tree_Color
+{
+	Red,
+	Black
+};
+
+template<class Type, bool HasSubtreeSize = false>
+struct _Tree_Node : _Tree_Node_Size<HasSubtreeSize>		// Used in _Search_Tree
+{
+	using value_type	= Type;
+	using Colors		= _Tree_Color;
 
 	value_type _Value;
 	_Tree_Node* _Parent	= nullptr;
@@ -90,11 +128,107 @@ struct _Tree_Node			// Used in _Search_Tree
 	_Tree_Node(Args&&... args)
 		: _Value(custom::forward<Args>(args)...) { /*Empty*/ }
 
+	_Tree_Node* _parent() const noexcept {
+		return _Parent;
+	}
+
+	void _set_parent(_Tree_Node* parent) noexcept {
+		_Parent = parent;
+	}
+
+	void _init_links(_Tree_Node* parent, const Colors color, const bool isNil) noexcept {	// first write on raw allocated memory
+		_Parent	= parent;
+		_Color	= color;
+		_IsNil	= isNil;
+	}
+
+	Colors _color() const noexcept {
+		return _Color;
+	}
+
+	void _set_color(const Colors color) noexcept {
+		_Color = color;
+	}
+
+	bool _is_nil() const noexcept {
+		return _IsNil;
+	}
+
+	void _set_nil(const bool isNil) noexcept {
+		_IsNil = isNil;
+	}
+
 	bool is_leaf() const {
 		return (_Left->_IsNil && _Right->_IsNil);
 	}
 }; // END Tree Node
 
+
+template<class Type, bool HasSubtreeSize = false>
+struct _Compact_Tree_Node : _Tree_Node_Size<HasSubtreeSize>		// _Tree_Node with the nil and color flags in the low bits of the parent pointer
+{
+	using value_type	= Type;
+	using Colors		= _Tree_Color;
+
+	static constexpr uintptr_t _BLACK_BIT	= 1;
+	static constexpr uintptr_t _NIL_BIT		= 2;
+	static constexpr uintptr_t _FLAGS		= _BLACK_BIT | _NIL_BIT;
+
+	value_type _Value;
+	_Compact_Tree_Node* _Left 	= nullptr;
+	_Compact_Tree_Node* _Right 	= nullptr;
+	uintptr_t _ParentAndFlags	= 0;			// red, not nil, no parent
+
+	_Compact_Tree_Node()										= default;
+	~_Compact_Tree_Node()										= default;
+	_Compact_Tree_Node(const _Compact_Tree_Node&)				= delete;
+	_Compact_Tree_Node& operator=(const _Compact_Tree_Node&)	= delete;
+
+	_Compact_Tree_Node(const value_type& copyVal)
+		:_Value(copyVal) { /*Empty*/ }
+
+	_Compact_Tree_Node(value_type&& moveVal)
+		:_Value(custom::move(moveVal)) { /*Empty*/ }
+
+	template<class... Args>
+	_Compact_Tree_Node(Args&&... args)
+		: _Value(custom::forward<Args>(args)...) { /*Empty*/ }
+
+	_Compact_Tree_Node* _parent() const noexcept {
+		return reinterpret_cast<_Compact_Tree_Node*>(_ParentAndFlags & ~_FLAGS);
+	}
+
+	void _set_parent(_Compact_Tree_Node* parent) noexcept {
+		_ParentAndFlags = reinterpret_cast<uintptr_t>(parent) | (_ParentAndFlags & _FLAGS);
+	}
+
+	void _init_links(_Compact_Tree_Node* parent, const Colors color, const bool isNil) noexcept {	// full tagged value, the old bits may be garbage
+		_ParentAndFlags =	reinterpret_cast<uintptr_t>(parent) |
+							((color == Colors::Black) ? _BLACK_BIT : 0) |
+							(isNil ? _NIL_BIT : 0);
+	}
+
+	Colors _color() const noexcept {
+		return (_ParentAndFlags & _BLACK_BIT) ? Colors::Black : Colors::Red;
+	}
+
+	void _set_color(const Colors color) noexcept {
+		_ParentAndFlags = (color == Colors::Black) ? (_ParentAndFlags | _BLACK_BIT) : (_ParentAndFlags & ~_BLACK_BIT);
+	}
+
+	bool _is_nil() const noexcept {
+		return (_ParentAndFlags & _NIL_BIT) != 0;
+	}
+
+	void _set_nil(const bool isNil) noexcept {
+		_ParentAndFlags = isNil ? (_ParentAndFlags | _NIL_BIT) : (_ParentAndFlags & ~_NIL_BIT);
+	}
+
+	bool is_leaf() const {
+		return (_Left->_is_nil() && _Right->_is_nil());
+	}
+}; // END Compact Tree Node
+
 CUSTOM_DETAIL_END
 
 CUSTOM_END
\ No newline at end of file
@@ -0,0 +1,126 @@
+#pragma once
+#include "x_memory.h"
+#include "c_utility.h"
+
+
+CUSTOM_BEGIN
+
+CUSTOM_DETAIL_BEGIN
+
+template<class Node, class AllocNode, class Traits>
+class _Node_Handle				// Owns a node extracted from an associative container (node_type)
+{
+private:
+	using _Alloc_Node_Traits	= allocator_traits<AllocNode>;
+	using _NodePtr				= typename _Alloc_Node_Traits::pointer;
+
+public:
+	using key_type				= typename Traits::key_type;
+	using mapped_type			= typename Traits::mapped_type;
+	using value_type			= typename Traits::value_type;
+	using allocator_type		= typename Traits::allocator_type;
+
+private:
+	_NodePtr _Ptr				= nullptr;
+	AllocNode _Alloc;
+
+public:
+	// Constructors
+
+	_Node_Handle() noexcept = default;
+
+	_Node_Handle(_NodePtr node, const AllocNode& alloc) noexcept		// Used by containers to hand over a node
+		: _Ptr(node), _Alloc(alloc) { /*Empty*/ }
+
+	_Node_Handle(_Node_Handle&& other) noexcept
+		: _Ptr(custom::exchange(other._Ptr, nullptr)), _Alloc(other._Alloc) { /*Empty*/ }
+
+	~_Node_Handle() {
+		_clear();
+	}
+
+	_Node_Handle(const _Node_Handle&)				= delete;
+	_Node_Handle& operator=(const _Node_Handle&)	= delete;
+
+public:
+	// Operators
+
+	_Node_Handle& operator=(_Node_Handle&& other) noexcept {
+		if (_Ptr != other._Ptr)
+		{
+			_clear();
+			_Ptr	= custom::exchange(other._Ptr, nullptr);
+			_Alloc	= other._Alloc;
+		}
+
+		return *this;
+	}
+
+	explicit operator bool() const noexcept {
+		return _Ptr != nullptr;
+	}
+
+public:
+	// Main functions
+
+	bool empty() const noexcept {
+		return _Ptr == nullptr;
+	}
+
+	allocator_type get_allocator() const {
+		return allocator_type(_Alloc);
+	}
+
+	value_type& value() const noexcept {
+		CUSTOM_ASSERT(_Ptr != nullptr, "Node handle is empty.");
+		return _Ptr->_Value;
+	}
+
+	key_type& key() const noexcept {								// the key can be changed before inserting the node again
+		CUSTOM_ASSERT(_Ptr != nullptr, "Node handle is empty.");
+		return const_cast<key_type&>(Traits::extract_key(_Ptr->_Value));
+	}
+
+	mapped_type& mapped() const noexcept {
+		CUSTOM_ASSERT(_Ptr != nullptr, "Node handle is empty.");
+		return const_cast<mapped_type&>(Traits::extract_mapval(_Ptr->_Value));
+	}
+
+	void swap(_Node_Handle& other) noexcept {
+		custom::swap(_Ptr, other._Ptr);
+		custom::swap(_Alloc, other._Alloc);
+	}
+
+	_NodePtr _get_node() const noexcept {
+		return _Ptr;
+	}
+
+	_NodePtr _release() noexcept {									// Container takes ownership back
+		return custom::exchange(_Ptr, nullptr);
+	}
+
+private:
+	// Helpers
+
+	void _clear() noexcept {
+		if (_Ptr != nullptr)
+		{
+			_Alloc_Node_Traits::destroy(_Alloc, &(_Ptr->_Value));
+			_Alloc.deallocate(_Ptr, 1);
+			_Ptr = nullptr;
+		}
+	}
+}; // END _Node_Handle
+
+
+template<class Iterator, class NodeType>
+struct _Insert_Return_Type		// Result of insert(node_type&&) (insert_return_type)
+{
+	Iterator position;
+	bool inserted;
+	NodeType node;
+}; // END _Insert_Return_Type
+
+CUSTOM_DETAIL_END
+
+CUSTOM_END
\ No newline at end of file
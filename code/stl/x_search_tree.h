@@ -1,13 +1,32 @@
 #pragma once
+#include "x_node.h"
 #include "x_memory.h"
 #include "c_pair.h"
 #include "c_utility.h"
 #include "c_iterator.h"
 #include "c_functional.h"	// for custom::Less
+#include "x_node_handle.h"
+
+#if defined __GNUG__
+#include "c_thread.h"		// optional parallel set operations
+#include <exception>		// std::exception_ptr, to rethrow from a worker
+#endif
 
 
 CUSTOM_BEGIN
 
+struct default_tree_policy					// plain red-black tree
+{
+	static constexpr bool order_statistics	= false;
+	static constexpr bool compact_nodes		= true;		// color and nil flags in the parent pointer, when the allocator allows it
+};
+
+struct order_statistic_tree_policy			// nodes keep subtree sizes for rank() and nth() in O(log n)
+{
+	static constexpr bool order_statistics	= true;
+	static constexpr bool compact_nodes		= true;
+};
+
 CUSTOM_DETAIL_BEGIN
 
 enum class _Tree_Child
@@ -23,7 +42,22 @@ struct _Tree_Node_ID 			// Indicator for child placement
 	_Tree_Child _Child 	= _Tree_Child::Left;
 };
 
-template<class Traits>
+template<class Value, class Alloc, class Policy>
+struct _Select_Tree_Node					// compact node needs raw pointers with free low bits
+{
+private:
+	using _Compact			= _Compact_Tree_Node<Value, Policy::order_statistics>;
+	using _Compact_Pointer	= typename allocator_traits<typename allocator_traits<Alloc>::template rebind_alloc<_Compact>>::pointer;
+
+	static constexpr bool _UseCompact =	Policy::compact_nodes &&
+										is_same_v<_Compact_Pointer, _Compact*> &&
+										alignof(_Compact) > _Compact::_FLAGS;
+
+public:
+	using type = conditional_t<_UseCompact, _Compact, _Tree_Node<Value, Policy::order_statistics>>;
+};
+
+template<class Traits, class Policy>
 struct _Search_Tree_Data
 {
 	using key_type				= typename Traits::key_type;
@@ -33,7 +67,7 @@ struct _Search_Tree_Data
 	using allocator_type		= typename Traits::allocator_type;
 	
 	using _Alloc_Traits			= allocator_traits<allocator_type>;
-	using _Node					= detail::_Tree_Node<value_type>;
+	using _Node					= typename _Select_Tree_Node<value_type, allocator_type, Policy>::type;
 	using _Alloc_Node			= typename _Alloc_Traits::template rebind_alloc<_Node>;
 	using _Alloc_Node_Traits	= allocator_traits<_Alloc_Node>;
 	using _NodePtr				= typename _Alloc_Node_Traits::pointer;
@@ -48,14 +82,14 @@ struct _Search_Tree_Data
 	_NodePtr _Head				= nullptr;								// Helper node used to link min and max elems for iteration (root == head->parent)
 
 	_NodePtr leftmost(_NodePtr node) const {						// return leftmost node in subtree at node
-		while (!node->_Left->_IsNil)
+		while (!node->_Left->_is_nil())
 			node = node->_Left;
 
 		return node;
 	}
 
 	_NodePtr rightmost(_NodePtr node) const {						// return rightmost node in subtree at node
-		while (!node->_Right->_IsNil)
+		while (!node->_Right->_is_nil())
 			node = node->_Right;
 
 		return node;
@@ -89,13 +123,13 @@ public:
 	_Search_Tree_Const_Iterator& operator++() noexcept {
 		CUSTOM_ASSERT(_Ptr != _RefData->_Head, "Cannot increment end iterator.");
 
-		if (_Ptr->_Right->_IsNil)
+		if (_Ptr->_Right->_is_nil())
 		{
-			_NodePtr node = _Ptr->_Parent;
-			while (!node->_IsNil && _Ptr == node->_Right)
+			_NodePtr node = _Ptr->_parent();
+			while (!node->_is_nil() && _Ptr == node->_Right)
 			{
 				_Ptr = node;
-				node = _Ptr->_Parent;
+				node = _Ptr->_parent();
 			}
 			_Ptr = node;
 		}
@@ -114,18 +148,18 @@ public:
 	_Search_Tree_Const_Iterator& operator--() noexcept {
 		CUSTOM_ASSERT(_Ptr != _RefData->_Head->_Left, "Cannot decrement begin iterator.");
 
-		if (_Ptr->_IsNil)
+		if (_Ptr->_is_nil())
 			_Ptr = _Ptr->_Right;
-		else if (_Ptr->_Left->_IsNil)
+		else if (_Ptr->_Left->_is_nil())
 		{
-			_NodePtr node = _Ptr->_Parent;
-			while (!node->_IsNil && _Ptr == node->_Left)
+			_NodePtr node = _Ptr->_parent();
+			while (!node->_is_nil() && _Ptr == node->_Left)
 			{
 				_Ptr = node;
-				node = _Ptr->_Parent;
+				node = _Ptr->_parent();
 			}
 
-			if (!_Ptr->_IsNil)	// decrement non-begin
+			if (!_Ptr->_is_nil())	// decrement non-begin
 				_Ptr = node;
 		}
 		else
@@ -218,11 +252,14 @@ public:
 }; // END _Search_Tree_Iterator
 
 
-template<class Traits>
+template<class Traits, class Policy = default_tree_policy>
 class _Search_Tree			// _Search_Tree Template implemented as Red-Black Tree
 {
 private:
-	using _Data						= _Search_Tree_Data<Traits>;
+	static constexpr bool _OrderStatistics = Policy::order_statistics;
+	static constexpr size_t _SMALL_OPERAND_RATIO = 8;			// set operations with an operand this many times smaller go element by element
+
+	using _Data						= _Search_Tree_Data<Traits, Policy>;
 	using _Alloc_Traits				= typename _Data::_Alloc_Traits;
 	using _Node						= typename _Data::_Node;
 	using _Alloc_Node				= typename _Data::_Alloc_Node;
@@ -246,6 +283,15 @@ protected:
 	using reverse_iterator			= custom::reverse_iterator<iterator>;
 	using const_reverse_iterator	= custom::reverse_iterator<const_iterator>;
 
+	using node_type					= _Node_Handle<_Node, _Alloc_Node, Traits>;
+	using insert_return_type		= _Insert_Return_Type<iterator, node_type>;
+
+	template<class KeyType>
+	using _Enable_Transparent		= enable_if_t<conjunction_v<			// heterogeneous lookup when key_compare allows it
+													_Is_Transparent<key_compare>,
+													negation<is_convertible<KeyType, const_iterator>>>,
+										bool>;
+
 protected:
 	_Data _data;
 	_Alloc_Node _alloc;
@@ -263,6 +309,19 @@ protected:
 			emplace(val);
 	}
 
+	template<class Iter>
+	_Search_Tree(Iter first, Iter last) : _Search_Tree() {				// O(n) when the range is already sorted
+		if constexpr (is_forward_iterator_v<Iter>)
+			if (_is_sorted_range(first, last))
+			{
+				assign_sorted(first, last);
+				return;
+			}
+
+		for (/*Empty*/; first != last; ++first)
+			emplace(*first);
+	}
+
 	_Search_Tree(const _Search_Tree& other) : _Search_Tree() {
 		_copy(other);
 	}
@@ -272,7 +331,7 @@ protected:
 	}
 
 	virtual ~_Search_Tree() {
-		_destroy_all(_data._Head->_Parent);
+		_destroy_all(_data._Head->_parent());
 		_free_head();
 	}
 
@@ -321,17 +380,36 @@ public:
 		}
 	}
 
-	iterator erase(const key_type& key) {
-		iterator it = find(key);
+	template<class... Args>
+	iterator emplace_hint(const_iterator hint, Args&&... args) {	// O(1) search when the key belongs right before hint (end() for sorted input)
+		_NodePtr newNode 		= _create_common_node(custom::forward<Args>(args)...);
+		const key_type& newKey 	= Traits::extract_key(newNode->_Value);
+		_Tree_Node_ID<_NodePtr> position;
 
-		if (it == end())
+		if (_hint_insertion_slot(hint._Ptr, newKey, position))
+		{
+			_insert(newNode, position);
+			return iterator(newNode, &_data);
+		}
+
+		iterator it = find(newKey);									// wrong hint or existing key, full search
+		if (it != end())
+		{
+			_free_common_node_default(newNode);
 			return it;
+		}
 
-		_NodePtr nodeToErase 	= it._Ptr;
-		iterator nextIterator 	= ++iterator(nodeToErase, &_data);
-		_destroy(nodeToErase);
+		_insert(newNode, _find_insertion_slot(newNode));
+		return iterator(newNode, &_data);
+	}
 
-		return nextIterator;
+	iterator erase(const key_type& key) {
+		return _erase(key);
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	iterator erase(const KeyType& key) {
+		return _erase(key);
 	}
 
 	iterator erase(const_iterator where) {
@@ -348,6 +426,65 @@ public:
 		return erase(Traits::extract_key(where._Ptr->_Value));
 	}
 
+	insert_return_type insert(node_type&& node) {					// Relink an extracted node, no allocation
+		if (node.empty())
+			return {end(), false, node_type()};
+
+		_NodePtr found = _find_in_tree(Traits::extract_key(node.value()));
+		if (found != _data._Head)	// node stays with the caller
+			return {iterator(found, &_data), false, custom::move(node)};
+
+		_NodePtr newNode = node._release();
+		_reset_node(newNode);
+		_insert(newNode, _find_insertion_slot(newNode));
+
+		return {iterator(newNode, &_data), true, node_type()};
+	}
+
+	iterator insert(const_iterator, node_type&& node) {
+		return insert(custom::move(node)).position;
+	}
+
+	node_type extract(const_iterator where) {						// Unlink node and hand it over, no deallocation
+		if (where == end())
+			throw std::out_of_range("map extract iterator outside range.");
+
+		_extract(where._Ptr);
+		return node_type(where._Ptr, _alloc);
+	}
+
+	node_type extract(const key_type& key) {
+		_NodePtr found = _find_in_tree(key);
+
+		if (found == _data._Head)
+			return node_type();
+
+		_extract(found);
+		return node_type(found, _alloc);
+	}
+
+	void merge(_Search_Tree& source) {								// Relink nodes whose keys are missing here, duplicates stay in source
+		if (_data._Head == source._data._Head)
+			return;
+
+		for (iterator it = source.begin(); it != source.end(); /*Empty*/)
+		{
+			_NodePtr node = it._Ptr;
+			++it;			// before extraction rebalances source
+
+			if (_find_in_tree(Traits::extract_key(node->_Value)) == _data._Head)
+			{
+				source._extract(node);
+				_reset_node(node);
+				_insert(node, _find_insertion_slot(node));
+			}
+		}
+	}
+
+	void merge(_Search_Tree&& source) {
+		merge(source);
+	}
+
 	const_iterator find (const key_type& key) const {
 		return const_iterator(_find_in_tree(key), &_data);
 	}
@@ -356,6 +493,79 @@ public:
 		return iterator(_find_in_tree(key), &_data);
 	}
 
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	const_iterator find(const KeyType& key) const {
+		return const_iterator(_find_in_tree(key), &_data);
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	iterator find(const KeyType& key) {
+		return iterator(_find_in_tree(key), &_data);
+	}
+
+	bool contains(const key_type& key) const {
+		return _find_in_tree(key) != _data._Head;
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	bool contains(const KeyType& key) const {
+		return _find_in_tree(key) != _data._Head;
+	}
+
+	const_iterator lower_bound(const key_type& key) const {			// First element not less than key
+		return const_iterator(_lower_bound(key), &_data);
+	}
+
+	iterator lower_bound(const key_type& key) {
+		return iterator(_lower_bound(key), &_data);
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	const_iterator lower_bound(const KeyType& key) const {
+		return const_iterator(_lower_bound(key), &_data);
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	iterator lower_bound(const KeyType& key) {
+		return iterator(_lower_bound(key), &_data);
+	}
+
+	const_iterator upper_bound(const key_type& key) const {			// First element greater than key
+		return const_iterator(_upper_bound(key), &_data);
+	}
+
+	iterator upper_bound(const key_type& key) {
+		return iterator(_upper_bound(key), &_data);
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	const_iterator upper_bound(const KeyType& key) const {
+		return const_iterator(_upper_bound(key), &_data);
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	iterator upper_bound(const KeyType& key) {
+		return iterator(_upper_bound(key), &_data);
+	}
+
+	pair<const_iterator, const_iterator> equal_range(const key_type& key) const {	// Elements equivalent to key (at most one)
+		return {lower_bound(key), upper_bound(key)};
+	}
+
+	pair<iterator, iterator> equal_range(const key_type& key) {
+		return {lower_bound(key), upper_bound(key)};
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	pair<const_iterator, const_iterator> equal_range(const KeyType& key) const {
+		return {lower_bound(key), upper_bound(key)};
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	pair<iterator, iterator> equal_range(const KeyType& key) {
+		return {lower_bound(key), upper_bound(key)};
+	}
+
 	size_t size() const noexcept {
 		return _data._Size;
 	}
@@ -370,18 +580,107 @@ public:
 	}
 
 	void clear() {
-		_destroy_all(_data._Head->_Parent);
-		_data._Head->_Parent 	= _data._Head;
+		_destroy_all(_data._Head->_parent());
+		_data._Head->_set_parent(_data._Head);
 		_data._Head->_Left 		= _data._Head;
 		_data._Head->_Right		= _data._Head;
 		_data._Size				= 0;
 	}
 
+	template<class Iter>
+	void assign_sorted(Iter first, Iter last) {						// O(n) build from a range sorted by key, equivalent keys keep the first, empty if it throws
+		static_assert(is_forward_iterator_v<Iter>, "assign_sorted requires forward iterators.");
+
+		clear();
+
+		const size_t count = _count_sorted_unique(first, last);
+		size_t redDepth = 0;										// the last, partially filled level is red
+		while ((static_cast<size_t>(2) << redDepth) <= count + 1)
+			++redDepth;
+
+		_Subtree tree = {_build_sorted(first, last, count, 0, redDepth), 0};
+		_finish_set_operation(tree, count);
+	}
+
+	// If the comparator or an allocation throws, the elements reached so far stay in a valid tree and the exception propagates.
+	// With threads > 1 the comparator and the allocator are called from several threads at once and must be safe for it.
+	void union_with(const _Search_Tree& other, const size_t threads = 1) {			// Add copies of the elements of other that are missing here
+		if (_data._Head == other._data._Head)
+			return;
+
+		if (other._data._Size * _SMALL_OPERAND_RATIO <= _data._Size)	// O(m log n) lookups beat splitting the large tree
+		{
+			for (const value_type& val : other)
+				if (_find_in_tree(Traits::extract_key(val)) == _data._Head)
+				{
+					_NodePtr newNode = _create_common_node(val);
+					_insert(newNode, _find_insertion_slot(newNode));
+				}
+
+			return;
+		}
+
+		const size_t oldSize	= _data._Size;
+		size_t matches			= 0;
+		_Subtree tree			= _release_tree();
+		_set_operation_guarded(tree, [&]() { _union(tree, other._data._Head->_parent(), _black_height(other._data._Head->_parent()), matches, _fork_depth(threads)); });
+		_finish_set_operation(tree, oldSize + other._data._Size - matches);
+	}
+
+	void intersect_with(const _Search_Tree& other, const size_t threads = 1) {		// Keep only elements whose keys are in other
+		if (_data._Head == other._data._Head)
+			return;
+
+		size_t matches	= 0;
+		_Subtree tree	= _release_tree();
+		_set_operation_guarded(tree, [&]() { _intersect(tree, other._data._Head->_parent(), _black_height(other._data._Head->_parent()), matches, _fork_depth(threads)); });
+		_finish_set_operation(tree, matches);
+	}
+
+	void difference_with(const _Search_Tree& other, const size_t threads = 1) {		// Erase elements whose keys are in other
+		if (_data._Head == other._data._Head)
+		{
+			clear();
+			return;
+		}
+
+		if (other._data._Size * _SMALL_OPERAND_RATIO <= _data._Size)
+		{
+			for (const value_type& val : other)
+				_erase(Traits::extract_key(val));
+
+			return;
+		}
+
+		const size_t oldSize	= _data._Size;
+		size_t matches			= 0;
+		_Subtree tree			= _release_tree();
+		_set_operation_guarded(tree, [&]() { _difference(tree, other._data._Head->_parent(), _black_height(other._data._Head->_parent()), matches, _fork_depth(threads)); });
+		_finish_set_operation(tree, oldSize - matches);
+	}
+
+	size_t rank(const key_type& key) const {						// Number of elements less than key, O(log n)
+		return _rank(key);
+	}
+
+	template<class KeyType, _Enable_Transparent<KeyType> = true>
+	size_t rank(const KeyType& key) const {
+		return _rank(key);
+	}
+
+	const_iterator nth(const size_t index) const {					// Element at index in sorted order, end() if index >= size(), O(log n)
+		return const_iterator(_nth(index), &_data);
+	}
+
+	iterator nth(const size_t index) {
+		return iterator(_nth(index), &_data);
+	}
+
 	void print_details() const {									// For Debugging
 		std::cout << "Size= " << _data._Size << '\n';
 		std::cout << "first= " << Traits::extract_key(_data._Head->_Left->_Value) << '\n';
 		std::cout << "Last= " << Traits::extract_key(_data._Head->_Right->_Value) << '\n';
-		_print_graph(0, _data._Head->_Parent, "HEAD");
+		_print_graph(0, _data._Head->_parent(), "HEAD");
 	}
 
 public:
@@ -464,13 +763,13 @@ private:
 		custom::string str;
 		str.append(ident, '\t');
 
-		if (!root->_IsNil)
-			std::cout << str << Traits::extract_key(root->_Value) << " [" << ((int)root->_Color ? "black" : "red") << " " << rlFlag << "]\n";
+		if (!root->_is_nil())
+			std::cout << str << Traits::extract_key(root->_Value) << " [" << ((int)root->_color() ? "black" : "red") << " " << rlFlag << "]\n";
 
-		if (!root->_Left->_IsNil)
+		if (!root->_Left->_is_nil())
 			_print_graph(ident + 1, root->_Left, "LEFT");
 
-		if (!root->_Right->_IsNil)
+		if (!root->_Right->_is_nil())
 			_print_graph(ident + 1, root->_Right, "RIGHT");
 	}
 	
@@ -478,65 +777,79 @@ private:
 		_NodePtr promotedNode = subroot->_Right;
 		subroot->_Right = promotedNode->_Left;			// subroot adopt left child of promoted
 
-		if (!promotedNode->_Left->_IsNil)
-			promotedNode->_Left->_Parent = subroot;		// subroot-right-left parent set
+		if (!promotedNode->_Left->_is_nil())
+			promotedNode->_Left->_set_parent(subroot);		// subroot-right-left parent set
 
-		promotedNode->_Parent = subroot->_Parent;		// promoted takes subroot parent
+		promotedNode->_set_parent(subroot->_parent());		// promoted takes subroot parent
 
-		if (subroot == _data._Head->_Parent)			// special case when tree root is chosen for rotation
-			_data._Head->_Parent = promotedNode;
-		else if (subroot == subroot->_Parent->_Left)	// parent links his new promoted child
-			subroot->_Parent->_Left = promotedNode;
+		if (subroot == _data._Head->_parent())			// special case when tree root is chosen for rotation
+			_data._Head->_set_parent(promotedNode);
+		else if (subroot == subroot->_parent()->_Left)	// parent links his new promoted child
+			subroot->_parent()->_Left = promotedNode;
 		else
-			subroot->_Parent->_Right = promotedNode;
+			subroot->_parent()->_Right = promotedNode;
 
 		promotedNode->_Left = subroot;					// promoted takes subroot as left child
-		subroot->_Parent = promotedNode;				// subroot has promoted as new parent
+		subroot->_set_parent(promotedNode);				// subroot has promoted as new parent
+
+		_update_size(subroot);
+		_update_size(promotedNode);
 	}
 
 	void _rotate_right(_NodePtr subroot) {					// promotes subroot left
 		_NodePtr promotedNode = subroot->_Left;
 		subroot->_Left = promotedNode->_Right;			// subroot adopt right child of promoted
 
-		if (!promotedNode->_Right->_IsNil)
-			promotedNode->_Right->_Parent = subroot;	// subroot-left-right parent set
+		if (!promotedNode->_Right->_is_nil())
+			promotedNode->_Right->_set_parent(subroot);	// subroot-left-right parent set
 
-		promotedNode->_Parent = subroot->_Parent;		// promoted takes subroot parent
+		promotedNode->_set_parent(subroot->_parent());		// promoted takes subroot parent
 
-		if (subroot == _data._Head->_Parent)			// special case when tree root is chosen for rotation
-			_data._Head->_Parent = promotedNode;
-		else if (subroot == subroot->_Parent->_Left)
-			subroot->_Parent->_Left = promotedNode;		// parent links his new promoted child
+		if (subroot == _data._Head->_parent())			// special case when tree root is chosen for rotation
+			_data._Head->_set_parent(promotedNode);
+		else if (subroot == subroot->_parent()->_Left)
+			subroot->_parent()->_Left = promotedNode;		// parent links his new promoted child
 		else
-			subroot->_Parent->_Right = promotedNode;
+			subroot->_parent()->_Right = promotedNode;
 
 		promotedNode->_Right = subroot;					// promoted takes subroot as right child
-		subroot->_Parent = promotedNode;				// subroot has promoted as new parent
+		subroot->_set_parent(promotedNode);				// subroot has promoted as new parent
+
+		_update_size(subroot);
+		_update_size(promotedNode);
 	}
 
 	_NodePtr _copy_all(_NodePtr subroot) {								// DFS Preorder
-		if (subroot->_IsNil)
+		if (subroot->_is_nil())
 			return _data._Head;
 
-		_NodePtr newNode = _alloc.allocate(1);
-		_Alloc_Node_Traits::construct(_alloc, &(newNode->_Value), subroot->_Value);
+		_NodePtr newNode = _create_common_node(subroot->_Value);
+		newNode->_set_color(subroot->_color());
 
-		newNode->_IsNil		= false;
-		newNode->_Color		= subroot->_Color;
+		if constexpr (_OrderStatistics)
+			newNode->_SubtreeSize = subroot->_SubtreeSize;
 
-		newNode->_Left = _copy_all(subroot->_Left);
-		if (!newNode->_Left->_IsNil)
-			newNode->_Left->_Parent = newNode;
+		try
+		{
+			newNode->_Left = _copy_all(subroot->_Left);
+			if (!newNode->_Left->_is_nil())
+				newNode->_Left->_set_parent(newNode);
 
-		newNode->_Right = _copy_all(subroot->_Right);
-		if (!newNode->_Right->_IsNil)
-			newNode->_Right->_Parent = newNode;
+			newNode->_Right = _copy_all(subroot->_Right);
+			if (!newNode->_Right->_is_nil())
+				newNode->_Right->_set_parent(newNode);
+		}
+		catch (...)
+		{
+			_destroy_all(newNode);						// children not copied yet are still nil
+			CUSTOM_RERAISE;
+		}
 
 		return newNode;
 	}
 
 	void _destroy_all(_NodePtr subroot) {								// DFS Postorder
-		if (subroot->_IsNil)
+		if (subroot->_is_nil())
 			return;
 
 		_destroy_all(subroot->_Left);
@@ -546,7 +859,7 @@ private:
 	}
 
 	_NodePtr _in_order_successor(_NodePtr node) const {
-		if (!node->_Right->_IsNil)
+		if (!node->_Right->_is_nil())
 			node = _data.leftmost(node->_Right);
 		else
 			node = _data.leftmost(node);
@@ -554,18 +867,45 @@ private:
 		return node;
 	}
 
-	_NodePtr _find_in_tree(const key_type& key) const {
+	template<class KeyType>
+	_NodePtr _find_in_tree(const KeyType& key) const {				// lower bound walk, needs only _less
+		_NodePtr found = _lower_bound(key);
+
+		if (found == _data._Head || _less(key, Traits::extract_key(found->_Value)))
+			return _data._Head;
+
+		return found;
+	}
+
+	template<class KeyType>
+	_NodePtr _lower_bound(const KeyType& key) const {				// first node not less than key, or head
 		_NodePtr found = _data._Head;
 
-		for (_NodePtr iterNode = _data._Head->_Parent; !iterNode->_IsNil; )
+		for (_NodePtr iterNode = _data._Head->_parent(); !iterNode->_is_nil(); )
 		{
-			if (key == Traits::extract_key(iterNode->_Value))
+			if (_less(Traits::extract_key(iterNode->_Value), key))
+				iterNode = iterNode->_Right;
+			else
 			{
 				found = iterNode;
-				iterNode = _data._Head;
+				iterNode = iterNode->_Left;
 			}
-			else if (_less(key, Traits::extract_key(iterNode->_Value)))
+		}
+
+		return found;
+	}
+
+	template<class KeyType>
+	_NodePtr _upper_bound(const KeyType& key) const {				// first node greater than key, or head
+		_NodePtr found = _data._Head;
+
+		for (_NodePtr iterNode = _data._Head->_parent(); !iterNode->_is_nil(); )
+		{
+			if (_less(key, Traits::extract_key(iterNode->_Value)))
+			{
+				found = iterNode;
 				iterNode = iterNode->_Left;
+			}
 			else
 				iterNode = iterNode->_Right;
 		}
@@ -573,25 +913,85 @@ private:
 		return found;
 	}
 
+	bool _hint_insertion_slot(_NodePtr hint, const key_type& key, _Tree_Node_ID<_NodePtr>& position) const {	// true if key fits between hint's predecessor and hint
+		if (_data._Size == 0)
+		{
+			position._Parent = _data._Head;
+			return true;
+		}
+
+		if (hint == _data._Head)									// append after the largest key
+		{
+			if (!_less(Traits::extract_key(_data._Head->_Right->_Value), key))
+				return false;
+
+			position._Parent	= _data._Head->_Right;
+			position._Child		= _Tree_Child::Right;
+			return true;
+		}
+
+		if (!_less(key, Traits::extract_key(hint->_Value)))
+			return false;
+
+		if (hint == _data._Head->_Left)								// new smallest key
+		{
+			position._Parent	= hint;
+			position._Child		= _Tree_Child::Left;
+			return true;
+		}
+
+		_NodePtr prev = (--const_iterator(hint, &_data))._Ptr;
+		if (!_less(Traits::extract_key(prev->_Value), key))
+			return false;
+
+		if (prev->_Right->_is_nil())									// otherwise hint is leftmost in prev's right subtree
+		{
+			position._Parent	= prev;
+			position._Child		= _Tree_Child::Right;
+		}
+		else
+		{
+			position._Parent	= hint;
+			position._Child		= _Tree_Child::Left;
+		}
+
+		return true;
+	}
+
+	template<class KeyType>
+	iterator _erase(const KeyType& key) {
+		iterator it = find(key);
+
+		if (it == end())
+			return it;
+
+		_NodePtr nodeToErase 	= it._Ptr;
+		iterator nextIterator 	= ++iterator(nodeToErase, &_data);
+		_extract(nodeToErase);
+		_free_common_node_default(nodeToErase);
+
+		return nextIterator;
+	}
+
 	_Tree_Node_ID<_NodePtr> _find_insertion_slot(_NodePtr newNode) const {	// Find parent for newly created node
 		_Tree_Node_ID<_NodePtr> position;
 
-		if (_data._Head->_Parent == _data._Head)					// first node
+		if (_data._Head->_parent() == _data._Head)					// first node
 			position._Parent = _data._Head;
 		else
-			for (_NodePtr iterNode = _data._Head->_Parent; !iterNode->_IsNil; /*Empty*/)
+			for (_NodePtr iterNode = _data._Head->_parent(); !iterNode->_is_nil(); /*Empty*/)
 			{
 				position._Parent = iterNode;
 				if (_less(Traits::extract_key(newNode->_Value), Traits::extract_key(iterNode->_Value)))
 				{
 					iterNode = iterNode->_Left;
-					if (iterNode->_IsNil)
+					if (iterNode->_is_nil())
 						position._Child = _Tree_Child::Left;
 				}
 				else
 				{
 					iterNode = iterNode->_Right;
-					if (iterNode->_IsNil)
+					if (iterNode->_is_nil())
 						position._Child = _Tree_Child::Right;
 				}
 			}
@@ -603,14 +1003,14 @@ private:
 		++_data._Size;
 
 		// Raw Insert
-		newNode->_Parent = position._Parent;
+		newNode->_set_parent(position._Parent);
 
 		if (position._Parent == _data._Head)						// first node
 		{
-			_data._Head->_Parent	= newNode;
+			_data._Head->_set_parent(newNode);
 			_data._Head->_Left		= newNode;
 			_data._Head->_Right		= newNode;
-			newNode->_Color 		= _Node::Colors::Black;
+			newNode->_set_color(_Node::Colors::Black);
 		}
 		else if (position._Child == _Tree_Child::Left)				// add to left
 		{
@@ -625,64 +1025,68 @@ private:
 				_data._Head->_Right = newNode;
 		}
 
+		if constexpr (_OrderStatistics)
+			for (_NodePtr ancestor = position._Parent; ancestor != _data._Head; ancestor = ancestor->_parent())
+				++ancestor->_SubtreeSize;
+
 		// Fix Insert
 		_NodePtr uncle = nullptr;
 		_NodePtr tempNode = newNode;													// initialize violation with newly inserted node
 
-		while (tempNode->_Parent->_Color == _Node::Colors::Red)
+		while (tempNode->_parent()->_color() == _Node::Colors::Red)
 		{
-			if (tempNode->_Parent == tempNode->_Parent->_Parent->_Left)
+			if (tempNode->_parent() == tempNode->_parent()->_parent()->_Left)
 			{
-				uncle = tempNode->_Parent->_Parent->_Right;
-				if (uncle->_Color == _Node::Colors::Black)							// uncle black
+				uncle = tempNode->_parent()->_parent()->_Right;
+				if (uncle->_color() == _Node::Colors::Black)							// uncle black
 				{
-					if (tempNode == tempNode->_Parent->_Right)						// case 2 = uncle black (triangle)
+					if (tempNode == tempNode->_parent()->_Right)						// case 2 = uncle black (triangle)
 					{
-						tempNode = tempNode->_Parent;
+						tempNode = tempNode->_parent();
 						_rotate_left(tempNode);
 					}
 
-					tempNode->_Parent->_Color			= _Node::Colors::Black;		// case 3 = uncle black (line)
-					tempNode->_Parent->_Parent->_Color	= _Node::Colors::Red;
-					_rotate_right(tempNode->_Parent->_Parent);
+					tempNode->_parent()->_set_color(_Node::Colors::Black);		// case 3 = uncle black (line)
+					tempNode->_parent()->_parent()->_set_color(_Node::Colors::Red);
+					_rotate_right(tempNode->_parent()->_parent());
 				}
 				else																// case 1 = uncle red
 				{
-					tempNode->_Parent->_Color			= _Node::Colors::Black;
-					uncle->_Color						= _Node::Colors::Black;
-					tempNode->_Parent->_Parent->_Color	= _Node::Colors::Red;
-					tempNode							= tempNode->_Parent->_Parent;
+					tempNode->_parent()->_set_color(_Node::Colors::Black);
+					uncle->_set_color(_Node::Colors::Black);
+					tempNode->_parent()->_parent()->_set_color(_Node::Colors::Red);
+					tempNode							= tempNode->_parent()->_parent();
 				}
 			}
 			else																	// simetrical situation
 			{
-				uncle = tempNode->_Parent->_Parent->_Left;
-				if (uncle->_Color == _Node::Colors::Black)
+				uncle = tempNode->_parent()->_parent()->_Left;
+				if (uncle->_color() == _Node::Colors::Black)
 				{
-					if (tempNode == tempNode->_Parent->_Left)
+					if (tempNode == tempNode->_parent()->_Left)
 					{
-						tempNode = tempNode->_Parent;
+						tempNode = tempNode->_parent();
 						_rotate_right(tempNode);
 					}
 
-					tempNode->_Parent->_Color			= _Node::Colors::Black;
-					tempNode->_Parent->_Parent->_Color	= _Node::Colors::Red;
-					_rotate_left(tempNode->_Parent->_Parent);
+					tempNode->_parent()->_set_color(_Node::Colors::Black);
+					tempNode->_parent()->_parent()->_set_color(_Node::Colors::Red);
+					_rotate_left(tempNode->_parent()->_parent());
 				}
 				else
 				{
-					tempNode->_Parent->_Color			= _Node::Colors::Black;
-					uncle->_Color						= _Node::Colors::Black;
-					tempNode->_Parent->_Parent->_Color	= _Node::Colors::Red;
-					tempNode							= tempNode->_Parent->_Parent;
+					tempNode->_parent()->_set_color(_Node::Colors::Black);
+					uncle->_set_color(_Node::Colors::Black);
+					tempNode->_parent()->_parent()->_set_color(_Node::Colors::Red);
+					tempNode							= tempNode->_parent()->_parent();
 				}
 			}
 		}
 
-		_data._Head->_Parent->_Color = _Node::Colors::Black;							// root is black
+		_data._Head->_parent()->_set_color(_Node::Colors::Black);							// root is black
 	}
 
-	void _destroy(_NodePtr oldNode) {
+	void _extract(_NodePtr oldNode) {								// rebalance and detach oldNode (still allocated)
 		--_data._Size;
 
 		_NodePtr fixNode; 			// the node to recolor as needed
@@ -696,43 +1100,50 @@ private:
 			_transplant(oldNode, tempNode);
 		}
 
+		if constexpr (_OrderStatistics)						// oldNode counts as empty while rotations recompute sizes
+		{
+			oldNode->_SubtreeSize = 0;
+			for (_NodePtr ancestor = oldNode->_parent(); ancestor != _data._Head; ancestor = ancestor->_parent())
+				--ancestor->_SubtreeSize;
+		}
+
 		// Rebalance only if old color is black
-		if (oldNode->_Color == _Node::Colors::Black)
+		if (oldNode->_color() == _Node::Colors::Black)
 		{
 			fixNode 		= oldNode;
-			fixNodeParent 	= oldNode->_Parent;
+			fixNodeParent 	= oldNode->_parent();
 
-			for (/*Empty*/; fixNode != _data._Head->_Parent && fixNode->_Color == _Node::Colors::Black; fixNodeParent = fixNode->_Parent)
+			for (/*Empty*/; fixNode != _data._Head->_parent() && fixNode->_color() == _Node::Colors::Black; fixNodeParent = fixNode->_parent())
 			{
 				if (fixNode == fixNodeParent->_Left)	// left subtree
 				{
                     tempNode = fixNodeParent->_Right;
-                    if (tempNode->_Color == _Node::Colors::Red) 
+                    if (tempNode->_color() == _Node::Colors::Red) 
 					{
-                        tempNode->_Color = _Node::Colors::Black;
-                        fixNodeParent->_Color = _Node::Colors::Red;
+                        tempNode->_set_color(_Node::Colors::Black);
+                        fixNodeParent->_set_color(_Node::Colors::Red);
                         _rotate_left(fixNodeParent);
                         tempNode = fixNodeParent->_Right;
                     }
 
-                    if (tempNode->_Left->_Color == _Node::Colors::Black && tempNode->_Right->_Color == _Node::Colors::Black)
+                    if (tempNode->_Left->_color() == _Node::Colors::Black && tempNode->_Right->_color() == _Node::Colors::Black)
 					{
-                        tempNode->_Color = _Node::Colors::Red;
+                        tempNode->_set_color(_Node::Colors::Red);
                         fixNode = fixNodeParent;
                     } 
 					else
 					{
-                        if (tempNode->_Right->_Color == _Node::Colors::Black)
+                        if (tempNode->_Right->_color() == _Node::Colors::Black)
 						{
-                            tempNode->_Left->_Color = _Node::Colors::Black;
-                            tempNode->_Color = _Node::Colors::Red;
+                            tempNode->_Left->_set_color(_Node::Colors::Black);
+                            tempNode->_set_color(_Node::Colors::Red);
                             _rotate_right(tempNode);
                             tempNode = fixNodeParent->_Right;
                         }
 
-                        tempNode->_Color 			= fixNodeParent->_Color;
-                        fixNodeParent->_Color 		= _Node::Colors::Black;
-                        tempNode->_Right->_Color 	= _Node::Colors::Black;
+                        tempNode->_set_color(fixNodeParent->_color());
+                        fixNodeParent->_set_color(_Node::Colors::Black);
+                        tempNode->_Right->_set_color(_Node::Colors::Black);
                         _rotate_left(fixNodeParent);
                         break;	// rebalanced
                     }
@@ -740,44 +1151,53 @@ private:
 				else	// right subtree
 				{
                     tempNode = fixNodeParent->_Left;
-                    if (tempNode->_Color == _Node::Colors::Red)
+                    if (tempNode->_color() == _Node::Colors::Red)
 					{
-                        tempNode->_Color = _Node::Colors::Black;
-                        fixNodeParent->_Color = _Node::Colors::Red;
+                        tempNode->_set_color(_Node::Colors::Black);
+                        fixNodeParent->_set_color(_Node::Colors::Red);
                         _rotate_right(fixNodeParent);
                         tempNode = fixNodeParent->_Left;
                     }
 
-                    if (tempNode->_Right->_Color == _Node::Colors::Black && tempNode->_Left->_Color == _Node::Colors::Black)
+                    if (tempNode->_Right->_color() == _Node::Colors::Black && tempNode->_Left->_color() == _Node::Colors::Black)
 					{
-                        tempNode->_Color = _Node::Colors::Red;
+                        tempNode->_set_color(_Node::Colors::Red);
                         fixNode = fixNodeParent;
                     }
 					else
 					{
-                        if (tempNode->_Left->_Color == _Node::Colors::Black)
+                        if (tempNode->_Left->_color() == _Node::Colors::Black)
 						{
-                            tempNode->_Right->_Color = _Node::Colors::Black;
-                            tempNode->_Color = _Node::Colors::Red;
+                            tempNode->_Right->_set_color(_Node::Colors::Black);
+                            tempNode->_set_color(_Node::Colors::Red);
                             _rotate_left(tempNode);
                             tempNode = fixNodeParent->_Left;
                         }
 
-                        tempNode->_Color 			= fixNodeParent->_Color;
-                        fixNodeParent->_Color 		= _Node::Colors::Black;
-                        tempNode->_Left->_Color 	= _Node::Colors::Black;
+                        tempNode->_set_color(fixNodeParent->_color());
+                        fixNodeParent->_set_color(_Node::Colors::Black);
+                        tempNode->_Left->_set_color(_Node::Colors::Black);
                         _rotate_right(fixNodeParent);
                         break;	// rebalanced
                     }
                 }
 			}
 
-            fixNode->_Color = _Node::Colors::Black;									// stopping node is black
+            fixNode->_set_color(_Node::Colors::Black);									// stopping node is black
 		}
 
-		_free_common_node(oldNode);
-		_data._Head->_Left 		= _data.leftmost(_data._Head->_Parent);
-		_data._Head->_Right 	= _data.rightmost(_data._Head->_Parent);
+		_detach_from_parent(oldNode);
+
+		if (_data._Size == 0)										// leftmost(head) would return the detached node
+		{
+			_data._Head->_Left	= _data._Head;
+			_data._Head->_Right	= _data._Head;
+		}
+		else
+		{
+			_data._Head->_Left 		= _data.leftmost(_data._Head->_parent());
+			_data._Head->_Right 	= _data.rightmost(_data._Head->_parent());
+		}
 	}
 
 	void _transplant(_NodePtr first, _NodePtr second) {
@@ -786,29 +1206,36 @@ private:
 
 		_swap_parents(first, second);	
 		_swap_children(first, second);
-		custom::swap(first->_Color, second->_Color);
+		const auto firstColor = first->_color();
+		first->_set_color(second->_color());
+		second->_set_color(firstColor);
+
+		if constexpr (_OrderStatistics)						// sizes belong to positions
+			custom::swap(first->_SubtreeSize, second->_SubtreeSize);
 	}
 
 	void _swap_parents(_NodePtr first, _NodePtr second) {
 		// check head first
-		if (first->_Parent != _data._Head)
-			if (first == first->_Parent->_Left)
-				first->_Parent->_Left = second;
+		if (first->_parent() != _data._Head)
+			if (first == first->_parent()->_Left)
+				first->_parent()->_Left = second;
 			else
-				first->_Parent->_Right = second;
+				first->_parent()->_Right = second;
 		else
-			_data._Head->_Parent = second;
+			_data._Head->_set_parent(second);
 
 		// check head second
-		if (second->_Parent != _data._Head)
-			if (second == second->_Parent->_Left)
-				second->_Parent->_Left = first;
+		if (second->_parent() != _data._Head)
+			if (second == second->_parent()->_Left)
+				second->_parent()->_Left = first;
 			else
-				second->_Parent->_Right = first;
+				second->_parent()->_Right = first;
 		else
-			_data._Head->_Parent = first;
+			_data._Head->_set_parent(first);
 
-		custom::swap(first->_Parent, second->_Parent);
+		const _NodePtr firstParent = first->_parent();
+		first->_set_parent(second->_parent());
+		second->_set_parent(firstParent);
 	}
 
 	void _swap_children(_NodePtr first, _NodePtr second) {
@@ -816,32 +1243,33 @@ private:
 		custom::swap(first->_Left, second->_Left);
 
 		if (first->_Left != _data._Head)
-			first->_Left->_Parent = first;
+			first->_Left->_set_parent(first);
 		if (second->_Left != _data._Head)
-			second->_Left->_Parent = second;
+			second->_Left->_set_parent(second);
 
 		// right child
 		custom::swap(first->_Right, second->_Right);
 		
 		if (first->_Right != _data._Head)
-			first->_Right->_Parent = first;
+			first->_Right->_set_parent(first);
 		if (second->_Right != _data._Head)
-			second->_Right->_Parent = second;
+			second->_Right->_set_parent(second);
 	}
 
 	void _create_head() {
 		// don't construct value, it's not needed
 		_data._Head 			= _alloc.allocate(1);
-		_data._Head->_Parent	= _data._Head;
+		_data._Head->_init_links(_data._Head, _Node::Colors::Black, true);
 		_data._Head->_Left		= _data._Head;
 		_data._Head->_Right		= _data._Head;
-		_data._Head->_IsNil		= true;
-		_data._Head->_Color		= _Node::Colors::Black;
+
+		if constexpr (_OrderStatistics)
+			_data._Head->_SubtreeSize = 0;
 	}
 
 	void _free_head() {
 		// don't destroy value, it's not constructed
-		_data._Head->_Parent	= nullptr;
+		_data._Head->_set_parent(nullptr);
 		_data._Head->_Left		= nullptr;
 		_data._Head->_Right		= nullptr;
 		_alloc.deallocate(_data._Head, 1);
@@ -850,41 +1278,599 @@ private:
 	template<class... Args>
 	_NodePtr _create_common_node(Args&&... args) {
 		_NodePtr newNode 	= _alloc.allocate(1);
-		_Alloc_Node_Traits::construct(_alloc, &(newNode->_Value), custom::forward<Args>(args)...);
-		newNode->_Parent	= _data._Head;
-		newNode->_Left		= _data._Head;
-		newNode->_Right		= _data._Head;
-		newNode->_IsNil		= false;
-		newNode->_Color		= _Node::Colors::Red;
 
+		try
+		{
+			_Alloc_Node_Traits::construct(_alloc, &(newNode->_Value), custom::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			_alloc.deallocate(newNode, 1);
+			CUSTOM_RERAISE;
+		}
+
+		_reset_node(newNode);
 		return newNode;
 	}
 
+	void _reset_node(_NodePtr node) const noexcept {				// unlinked red node, ready for _insert
+		node->_init_links(_data._Head, _Node::Colors::Red, false);
+		node->_Left		= _data._Head;
+		node->_Right	= _data._Head;
+
+		if constexpr (_OrderStatistics)
+			node->_SubtreeSize = 1;
+	}
+
 	void _free_common_node_default(_NodePtr oldNode) {
-		oldNode->_Parent	= nullptr;
+		oldNode->_set_parent(nullptr);
 		oldNode->_Left		= nullptr;
 		oldNode->_Right		= nullptr;
 		_Alloc_Node_Traits::destroy(_alloc, &(oldNode->_Value));
 		_alloc.deallocate(oldNode, 1);
 	}
 
-	void _free_common_node(_NodePtr oldNode) {
-		// detach parent from node
-		if (oldNode == _data._Head->_Parent)
-			_data._Head->_Parent = _data._Head;
-		else if (oldNode == oldNode->_Parent->_Left)
-			oldNode->_Parent->_Left = _data._Head;
+	void _detach_from_parent(_NodePtr oldNode) {
+		if (oldNode == _data._Head->_parent())
+			_data._Head->_set_parent(_data._Head);
+		else if (oldNode == oldNode->_parent()->_Left)
+			oldNode->_parent()->_Left = _data._Head;
+		else
+			oldNode->_parent()->_Right = _data._Head;
+	}
+
+	void _update_size(_NodePtr node) const noexcept {				// recompute from children, no-op without order statistics
+		if constexpr (_OrderStatistics)
+			node->_SubtreeSize = 1 + node->_Left->_SubtreeSize + node->_Right->_SubtreeSize;
+	}
+
+	template<class KeyType>
+	size_t _rank(const KeyType& key) const {
+		static_assert(_OrderStatistics, "rank() requires order_statistic_tree_policy.");
+
+		size_t smaller = 0;
+		for (_NodePtr node = _data._Head->_parent(); !node->_is_nil(); /*Empty*/)
+			if (_less(Traits::extract_key(node->_Value), key))
+			{
+				smaller += node->_Left->_SubtreeSize + 1;
+				node = node->_Right;
+			}
+			else
+				node = node->_Left;
+
+		return smaller;
+	}
+
+	_NodePtr _nth(size_t index) const {								// node at index, or head
+		static_assert(_OrderStatistics, "nth() requires order_statistic_tree_policy.");
+
+		_NodePtr node = _data._Head->_parent();
+		if (index >= _data._Size)
+			return _data._Head;
+
+		for (;;)
+		{
+			const size_t leftSize = node->_Left->_SubtreeSize;
+
+			if (index < leftSize)
+				node = node->_Left;
+			else if (index == leftSize)
+				return node;
+			else
+			{
+				index	-= leftSize + 1;
+				node	= node->_Right;
+			}
+		}
+	}
+
+	// Join based set operations (Blelloch, Ferizovic, Sun - Just Join for Parallel Ordered Sets)
+	// _Subtree is a detached red-black tree with a black root, its nil links still point to _data._Head.
+	// The split node is reused as the join key, so only copies of elements from other are allocated.
+	// Independent halves may run on separate threads, they touch disjoint nodes and only read _data._Head.
+	// Each step takes its subtree in place. If anything throws, the step joins the pieces it holds back into
+	// that subtree before rethrowing, so the caller can always reattach a valid tree.
+
+	struct _Subtree
+	{
+		_NodePtr _Root;
+		size_t _BlackHeight;		// black nodes on any path from _Root to nil
+	};
+
+	bool _is_red(_NodePtr node) const noexcept {					// nil (head) is black
+		return node->_color() == _Node::Colors::Red;
+	}
+
+	void _set_left(_NodePtr parent, _NodePtr child) const noexcept {
+		parent->_Left = child;
+		if (!child->_is_nil())
+			child->_set_parent(parent);
+	}
+
+	void _set_right(_NodePtr parent, _NodePtr child) const noexcept {
+		parent->_Right = child;
+		if (!child->_is_nil())
+			child->_set_parent(parent);
+	}
+
+	_Subtree _detach(_NodePtr node, size_t blackHeight) const noexcept {	// child subtree as a standalone tree
+		if (!node->_is_nil())
+		{
+			node->_set_parent(_data._Head);
+			if (_is_red(node))
+			{
+				node->_set_color(_Node::Colors::Black);
+				++blackHeight;
+			}
+		}
+
+		return {node, blackHeight};
+	}
+
+	size_t _black_height(_NodePtr node) const noexcept {
+		size_t blackHeight = 0;
+		for (/*Empty*/; !node->_is_nil(); node = node->_Left)
+			if (!_is_red(node))
+				++blackHeight;
+
+		return blackHeight;
+	}
+
+	static size_t _fork_depth(size_t threads) noexcept {				// recursion levels that fork, for about threads workers
+		size_t depth = 0;
+		while (threads > 1)
+		{
+			threads /= 2;
+			++depth;
+		}
+
+		return depth;
+	}
+
+	template<class LeftTask, class RightTask>
+	static void _fork(const size_t forkDepth, LeftTask&& leftTask, RightTask&& rightTask) {	// left task on a new thread while forkDepth > 0
+#if defined __GNUG__
+		if (forkDepth > 0)
+		{
+			std::exception_ptr leftError;							// thread bodies are noexcept, carry the exception to this thread
+			thread worker([&leftTask, &leftError]() {
+				try
+				{
+					leftTask();
+				}
+				catch (...)
+				{
+					leftError = std::current_exception();
+				}
+			});
+
+			try
+			{
+				rightTask();
+			}
+			catch (...)
+			{
+				worker.join();										// the left half must be done before the caller rejoins it
+				CUSTOM_RERAISE;
+			}
+
+			worker.join();
+			if (leftError)
+				std::rethrow_exception(leftError);
+
+			return;
+		}
+#endif
+		(void)forkDepth;
+		leftTask();
+		rightTask();
+	}
+
+	_Subtree _release_tree() noexcept {								// detach the whole tree, the container looks empty until _finish_set_operation
+		_Subtree tree = _detach(_data._Head->_parent(), _black_height(_data._Head->_parent()));
+
+		_data._Head->_set_parent(_data._Head);
+		_data._Head->_Left		= _data._Head;
+		_data._Head->_Right		= _data._Head;
+		_data._Size				= 0;
+		return tree;
+	}
+
+	template<class Operation>
+	void _set_operation_guarded(_Subtree& tree, Operation&& operation) {	// on exception publish whatever tree is left
+		try
+		{
+			operation();
+		}
+		catch (...)
+		{
+			_finish_set_operation(tree, _count_nodes(tree._Root));
+			CUSTOM_RERAISE;
+		}
+	}
+
+	static size_t _count_nodes(_NodePtr subroot) noexcept {
+		if (subroot->_is_nil())
+			return 0;
+
+		return 1 + _count_nodes(subroot->_Left) + _count_nodes(subroot->_Right);
+	}
+
+	_Subtree _rejoin(const _Subtree& left, _NodePtr found, const _Subtree& right) const noexcept {	// join with found as key when there is one
+		return (found == nullptr) ? _join2(left, right) : _join(left, found, right);
+	}
+
+	void _finish_set_operation(const _Subtree& tree, const size_t newSize) noexcept {
+		_data._Head->_set_parent(tree._Root);
+		_data._Size				= newSize;
+
+		if (tree._Root->_is_nil())
+		{
+			_data._Head->_Left	= _data._Head;
+			_data._Head->_Right	= _data._Head;
+		}
+		else
+		{
+			tree._Root->_set_parent(_data._Head);
+			_data._Head->_Left	= _data.leftmost(tree._Root);
+			_data._Head->_Right	= _data.rightmost(tree._Root);
+		}
+	}
+
+	_NodePtr _rotate_left_subtree(_NodePtr subroot) const noexcept {	// returns the promoted node, the caller links it
+		_NodePtr promotedNode = subroot->_Right;
+		_set_right(subroot, promotedNode->_Left);
+		_set_left(promotedNode, subroot);
+		_update_size(subroot);
+		_update_size(promotedNode);
+		return promotedNode;
+	}
+
+	_NodePtr _rotate_right_subtree(_NodePtr subroot) const noexcept {
+		_NodePtr promotedNode = subroot->_Left;
+		_set_left(subroot, promotedNode->_Right);
+		_set_right(promotedNode, subroot);
+		_update_size(subroot);
+		_update_size(promotedNode);
+		return promotedNode;
+	}
+
+	_NodePtr _join_right(_NodePtr left, const size_t leftHeight, _NodePtr key, _NodePtr right, const size_t rightHeight) const noexcept {
+		if (!_is_red(left) && leftHeight == rightHeight)			// black node of right's height on left's right spine
+		{
+			key->_set_color(_Node::Colors::Red);
+			_set_left(key, left);
+			_set_right(key, right);
+			_update_size(key);
+			return key;
+		}
+
+		_set_right(left, _join_right(left->_Right, leftHeight - (_is_red(left) ? 0 : 1), key, right, rightHeight));
+		_update_size(left);
+
+		if (!_is_red(left) && _is_red(left->_Right) && _is_red(left->_Right->_Right))
+		{
+			left->_Right->_Right->_set_color(_Node::Colors::Black);
+			return _rotate_left_subtree(left);
+		}
+
+		return left;
+	}
+
+	_NodePtr _join_left(_NodePtr left, const size_t leftHeight, _NodePtr key, _NodePtr right, const size_t rightHeight) const noexcept {
+		if (!_is_red(right) && leftHeight == rightHeight)
+		{
+			key->_set_color(_Node::Colors::Red);
+			_set_left(key, left);
+			_set_right(key, right);
+			_update_size(key);
+			return key;
+		}
+
+		_set_left(right, _join_left(left, leftHeight, key, right->_Left, rightHeight - (_is_red(right) ? 0 : 1)));
+		_update_size(right);
+
+		if (!_is_red(right) && _is_red(right->_Left) && _is_red(right->_Left->_Left))
+		{
+			right->_Left->_Left->_set_color(_Node::Colors::Black);
+			return _rotate_right_subtree(right);
+		}
+
+		return right;
+	}
+
+	_Subtree _join(const _Subtree& left, _NodePtr key, const _Subtree& right) const noexcept {	// all keys of left < key < all keys of right
+		_NodePtr root		= key;
+		size_t blackHeight	= left._BlackHeight;
+
+		if (left._BlackHeight > right._BlackHeight)
+			root = _join_right(left._Root, left._BlackHeight, key, right._Root, right._BlackHeight);
+		else if (left._BlackHeight < right._BlackHeight)
+		{
+			root		= _join_left(left._Root, left._BlackHeight, key, right._Root, right._BlackHeight);
+			blackHeight	= right._BlackHeight;
+		}
+		else
+		{
+			_set_left(key, left._Root);
+			_set_right(key, right._Root);
+			_update_size(key);
+			key->_set_color(_Node::Colors::Red);
+		}
+
+		root->_set_parent(_data._Head);
+		if (_is_red(root))
+		{
+			root->_set_color(_Node::Colors::Black);
+			++blackHeight;
+		}
+
+		return {root, blackHeight};
+	}
+
+	_Subtree _split_last(const _Subtree& tree, _NodePtr& last) const noexcept {	// detach the largest node
+		_NodePtr root				= tree._Root;
+		const size_t childHeight	= tree._BlackHeight - 1;
+
+		if (root->_Right->_is_nil())
+		{
+			last = root;
+			return _detach(root->_Left, childHeight);
+		}
+
+		_Subtree left	= _detach(root->_Left, childHeight);
+		_Subtree rest	= _split_last(_detach(root->_Right, childHeight), last);
+		return _join(left, root, rest);
+	}
+
+	_Subtree _join2(const _Subtree& left, const _Subtree& right) const noexcept {	// join without a middle key
+		if (left._Root->_is_nil())
+			return right;
+
+		if (right._Root->_is_nil())
+			return left;
+
+		_NodePtr last	= nullptr;
+		_Subtree rest	= _split_last(left, last);
+		return _join(rest, last, right);
+	}
+
+	void _split(_Subtree& tree, const key_type& key, _Subtree& left, _NodePtr& found, _Subtree& right) const {	// left < key < right, found holds key or nullptr
+		_NodePtr root = tree._Root;
+
+		if (root->_is_nil())
+		{
+			left	= tree;
+			right	= tree;
+			found	= nullptr;
+			return;
+		}
+
+		const bool goLeft			= _less(key, Traits::extract_key(root->_Value));		// compare before detaching anything
+		const bool goRight			= !goLeft && _less(Traits::extract_key(root->_Value), key);
+		const size_t childHeight	= tree._BlackHeight - 1;
+		_Subtree leftChild			= _detach(root->_Left, childHeight);
+		_Subtree rightChild			= _detach(root->_Right, childHeight);
+
+		if (goLeft)
+		{
+			_Subtree innerRight;
+			try
+			{
+				_split(leftChild, key, left, found, innerRight);
+			}
+			catch (...)
+			{
+				tree = _join(leftChild, root, rightChild);
+				CUSTOM_RERAISE;
+			}
+
+			right = _join(innerRight, root, rightChild);
+		}
+		else if (goRight)
+		{
+			_Subtree innerLeft;
+			try
+			{
+				_split(rightChild, key, innerLeft, found, right);
+			}
+			catch (...)
+			{
+				tree = _join(leftChild, root, rightChild);
+				CUSTOM_RERAISE;
+			}
+
+			left = _join(leftChild, root, innerLeft);
+		}
 		else
-			oldNode->_Parent->_Right = _data._Head;
+		{
+			left	= leftChild;
+			right	= rightChild;
+			found	= root;
+		}
+	}
+
+	void _union(_Subtree& mine, _NodePtr theirs, const size_t theirsHeight, size_t& matches, const size_t forkDepth) {
+		if (theirs->_is_nil())
+			return;
+
+		if (mine._Root->_is_nil())
+		{
+			mine = _detach(_copy_all(theirs), theirsHeight);
+			return;
+		}
+
+		const size_t childHeight	= theirsHeight - (_is_red(theirs) ? 0 : 1);
+		const size_t childFork		= (forkDepth > 0) ? forkDepth - 1 : 0;
+		_Subtree left, right;
+		_NodePtr found				= nullptr;
+		size_t leftMatches			= 0;
+		size_t rightMatches			= 0;
+
+		_split(mine, Traits::extract_key(theirs->_Value), left, found, right);
+		try
+		{
+			_fork(forkDepth,
+				[&]() { _union(left, theirs->_Left, childHeight, leftMatches, childFork); },
+				[&]() { _union(right, theirs->_Right, childHeight, rightMatches, childFork); });
+
+			if (found == nullptr)
+				found = _create_common_node(theirs->_Value);
+			else
+				++matches;
+		}
+		catch (...)
+		{
+			mine = _rejoin(left, found, right);
+			CUSTOM_RERAISE;
+		}
 
-		_free_common_node_default(oldNode);
+		matches += leftMatches + rightMatches;
+		mine = _join(left, found, right);
+	}
+
+	void _intersect(_Subtree& mine, _NodePtr theirs, const size_t theirsHeight, size_t& matches, const size_t forkDepth) {
+		if (mine._Root->_is_nil())
+			return;
+
+		if (theirs->_is_nil())
+		{
+			_destroy_all(mine._Root);
+			mine = {_data._Head, 0};
+			return;
+		}
+
+		const size_t childHeight	= theirsHeight - (_is_red(theirs) ? 0 : 1);
+		const size_t childFork		= (forkDepth > 0) ? forkDepth - 1 : 0;
+		_Subtree left, right;
+		_NodePtr found				= nullptr;
+		size_t leftMatches			= 0;
+		size_t rightMatches			= 0;
+
+		_split(mine, Traits::extract_key(theirs->_Value), left, found, right);
+		try
+		{
+			_fork(forkDepth,
+				[&]() { _intersect(left, theirs->_Left, childHeight, leftMatches, childFork); },
+				[&]() { _intersect(right, theirs->_Right, childHeight, rightMatches, childFork); });
+		}
+		catch (...)
+		{
+			mine = _rejoin(left, found, right);
+			CUSTOM_RERAISE;
+		}
+
+		matches += leftMatches + rightMatches + ((found == nullptr) ? 0 : 1);
+		mine = _rejoin(left, found, right);
+	}
+
+	void _difference(_Subtree& mine, _NodePtr theirs, const size_t theirsHeight, size_t& matches, const size_t forkDepth) {
+		if (mine._Root->_is_nil() || theirs->_is_nil())
+			return;
+
+		const size_t childHeight	= theirsHeight - (_is_red(theirs) ? 0 : 1);
+		const size_t childFork		= (forkDepth > 0) ? forkDepth - 1 : 0;
+		_Subtree left, right;
+		_NodePtr found				= nullptr;
+		size_t leftMatches			= 0;
+		size_t rightMatches			= 0;
+
+		_split(mine, Traits::extract_key(theirs->_Value), left, found, right);
+		try
+		{
+			_fork(forkDepth,
+				[&]() { _difference(left, theirs->_Left, childHeight, leftMatches, childFork); },
+				[&]() { _difference(right, theirs->_Right, childHeight, rightMatches, childFork); });
+		}
+		catch (...)
+		{
+			mine = _rejoin(left, found, right);					// found is still in this tree, it was not erased yet
+			CUSTOM_RERAISE;
+		}
+
+		matches += leftMatches + rightMatches;
+		if (found != nullptr)
+		{
+			_free_common_node_default(found);
+			++matches;
+		}
+
+		mine = _join2(left, right);
+	}
+
+	template<class Iter>
+	bool _is_sorted_range(Iter first, const Iter last) const {
+		if (first == last)
+			return true;
+
+		for (Iter prev = first; ++first != last; prev = first)
+			if (_less(Traits::extract_key(*first), Traits::extract_key(*prev)))
+				return false;
+
+		return true;
+	}
+
+	template<class Iter>
+	size_t _count_sorted_unique(Iter first, const Iter last) const {
+		if (first == last)
+			return 0;
+
+		size_t count = 1;
+		for (Iter prev = first; ++first != last; prev = first)
+		{
+			CUSTOM_ASSERT(!_less(Traits::extract_key(*first), Traits::extract_key(*prev)), "Range is not sorted.");
+			if (_less(Traits::extract_key(*prev), Traits::extract_key(*first)))
+				++count;
+		}
+
+		return count;
+	}
+
+	template<class Iter>
+	_NodePtr _build_sorted(Iter& first, const Iter& last, const size_t count, const size_t depth, const size_t redDepth) {	// In-order build, halves differ by at most one
+		if (count == 0)
+			return _data._Head;
+
+		const size_t leftCount	= (count - 1) / 2;
+		_NodePtr left			= _build_sorted(first, last, leftCount, depth + 1, redDepth);
+		_NodePtr newNode		= nullptr;
+
+		try
+		{
+			newNode = _create_common_node(*first);
+		}
+		catch (...)
+		{
+			_destroy_all(left);
+			CUSTOM_RERAISE;
+		}
+
+		newNode->_set_color((depth == redDepth) ? _Node::Colors::Red : _Node::Colors::Black);
+		_set_left(newNode, left);
+
+		try																// a throwing comparator or right half frees what was built here
+		{
+			for (Iter current = first; ++first != last && !_less(Traits::extract_key(*current), Traits::extract_key(*first)); /*Empty*/)
+				{ /*Empty*/ }	// skip equivalent keys
+
+			_set_right(newNode, _build_sorted(first, last, count - 1 - leftCount, depth + 1, redDepth));
+		}
+		catch (...)
+		{
+			_destroy_all(newNode);
+			CUSTOM_RERAISE;
+		}
+
+		_update_size(newNode);
+
+		return newNode;
 	}
 
 	void _copy(const _Search_Tree& other) {
-		_data._Head->_Parent 			= _copy_all(other._data._Head->_Parent);	// copy from root
-		_data._Head->_Left 				= _data.leftmost(_data._Head->_Parent);
-		_data._Head->_Right 			= _data.rightmost(_data._Head->_Parent);
-		_data._Head->_Parent->_Parent 	= _data._Head;
+		_data._Head->_set_parent(_copy_all(other._data._Head->_parent()));	// copy from root
+		_data._Head->_Left 				= _data.leftmost(_data._Head->_parent());
+		_data._Head->_Right 			= _data.rightmost(_data._Head->_parent());
+		_data._Head->_parent()->_set_parent(_data._Head);
 		_data._Size 					= other._data._Size;
 	}
 
@@ -896,16 +1882,16 @@ private:
 
 
 // _Search_Tree binary operators
-template<class Traits>
-bool operator==(const _Search_Tree<Traits>& left, const _Search_Tree<Traits>& right) {	// Contains the same elems, same order, but not the same tree
+template<class Traits, class Policy>
+bool operator==(const _Search_Tree<Traits, Policy>& left, const _Search_Tree<Traits, Policy>& right) {	// Contains the same elems, same order, but not the same tree
 	if (left.size() != right.size())
 		return false;
 
 	return custom::equal(left.begin(), left.end(), right.begin());
 }
 
-template<class Traits>
-bool operator!=(const _Search_Tree<Traits>& left, const _Search_Tree<Traits>& right) {
+template<class Traits, class Policy>
+bool operator!=(const _Search_Tree<Traits, Policy>& left, const _Search_Tree<Traits, Policy>& right) {
 	return !(left == right);
 }
 
@@ -119,6 +119,26 @@ public:
 		return !(*this == other);
 	}
 
+	constexpr difference_type operator-(const _Basic_String_View_Iterator& other) const noexcept {
+		return static_cast<difference_type>(_Ptr - other._Ptr);
+	}
+
+	constexpr bool operator<(const _Basic_String_View_Iterator& other) const noexcept {
+		return _Ptr < other._Ptr;
+	}
+
+	constexpr bool operator>(const _Basic_String_View_Iterator& other) const noexcept {
+		return other < *this;
+	}
+
+	constexpr bool operator<=(const _Basic_String_View_Iterator& other) const noexcept {
+		return !(other < *this);
+	}
+
+	constexpr bool operator>=(const _Basic_String_View_Iterator& other) const noexcept {
+		return !(*this < other);
+	}
+
 public:
 
 	friend constexpr void _verify_range(const _Basic_String_View_Iterator& first,
@@ -444,16 +464,18 @@ private:
 
 
 // basic_string_view binary operators
+// right side is non-deduced, so anything convertible to basic_string_view compares
+// (the reversed order is covered by C++20 rewritten candidates)
 template<class Type, class Traits>
 constexpr bool operator==(const basic_string_view<Type, Traits>& left,
-	const basic_string_view<Type, Traits>& right) {
+	const type_identity_t<basic_string_view<Type, Traits>>& right) {
 
 	return left.compare(right) == 0;
 }
 
-template<class Type, class Alloc, class Traits>
+template<class Type, class Traits>
 constexpr bool operator!=(const basic_string_view<Type, Traits>& left,
-	const basic_string_view<Type, Traits>& right) {
+	const type_identity_t<basic_string_view<Type, Traits>>& right) {
 
 	return !(left == right);
 }
@@ -574,6 +596,26 @@ public:
 		return !(*this == other);
 	}
 
+	constexpr difference_type operator-(const _Basic_String_Const_Iterator& other) const noexcept {
+		return static_cast<difference_type>(_Ptr - other._Ptr);
+	}
+
+	constexpr bool operator<(const _Basic_String_Const_Iterator& other) const noexcept {
+		return _Ptr < other._Ptr;
+	}
+
+	constexpr bool operator>(const _Basic_String_Const_Iterator& other) const noexcept {
+		return other < *this;
+	}
+
+	constexpr bool operator<=(const _Basic_String_Const_Iterator& other) const noexcept {
+		return !(other < *this);
+	}
+
+	constexpr bool operator>=(const _Basic_String_Const_Iterator& other) const noexcept {
+		return !(*this < other);
+	}
+
 public:
 
 	constexpr size_t get_index() const noexcept {					// Get the position for the element in array from iterator
@@ -660,6 +702,8 @@ public:
 		return temp;
 	}
 
+	using _Base::operator-;								// iterator difference
+
 	constexpr pointer operator->() const noexcept {
 		return const_cast<pointer>(_Base::operator->());
 	}
@@ -828,6 +872,38 @@ public:
 		reserve(size());
 	}
 
+	constexpr void resize(const size_t newSize) {				// Change size, new characters are value_type()
+		resize(newSize, value_type());
+	}
+
+	constexpr void resize(const size_t newSize, value_type chr) {	// Change size, new characters are chr
+		if (newSize > size())
+		{
+			_extend_to(newSize);
+			(void)traits_type::assign(_data._Last, newSize - size(), chr);
+		}
+
+		_data._Last		= _data._First + newSize;
+		_data._Last[0]	= traits_type::NULLCHR;
+	}
+
+	constexpr void resize_for_overwrite(const size_t newSize) {	// Change size, new characters are left uninitialized
+		_extend_to(newSize);
+		_data._Last		= _data._First + newSize;
+		_data._Last[0]	= traits_type::NULLCHR;
+	}
+
+	template<class Operation>
+	constexpr void resize_and_overwrite(const size_t count, Operation op) {	// op(data(), count) writes up to count characters and returns the new size
+		_extend_to(count);
+
+		const size_t newSize = static_cast<size_t>(custom::move(op)(_data._First, count));
+		CUSTOM_ASSERT(newSize <= count, "resize_and_overwrite operation returned a size past count.");
+
+		_data._Last		= _data._First + newSize;
+		_data._Last[0]	= traits_type::NULLCHR;
+	}
+
 	constexpr void push_back(value_type chr) {
 		_extend_if_full();
 		*(_data._Last++)	= chr;
@@ -1215,6 +1291,11 @@ private:
 			reserve(capacity() + capacity() / 2 + 1);
 	}
 
+	constexpr void _extend_to(const size_t newSize) {							// Reserve at least newSize, growing by 50% so repeated calls stay amortized
+		if (newSize > capacity())
+			reserve((custom::max)(newSize, capacity() + capacity() / 2 + 1));
+	}
+
 	constexpr void _copy(const basic_string& other) {								// Generic copy function for string
 		_alloc_empty(other.capacity());
 		(void)traits_type::copy(_data._First, other._data._First, other.size());
@@ -1292,6 +1373,10 @@ private:
 	}
 };	// END basic_string
 
+template<class Type, class Alloc, class Traits>
+struct is_trivially_relocatable<basic_string<Type, Alloc, Traits>>		// no SSO, only owns a heap buffer
+	: is_trivially_relocatable<Alloc> {};
+
 
 // basic_string binary operators
 template<class Type, class Alloc, class Traits>
@@ -1308,6 +1393,20 @@ constexpr bool operator!=(	const basic_string<Type, Alloc, Traits>& left,
 	return !(left == right);
 }
 
+template<class Type, class Alloc, class Traits>
+constexpr bool operator==(	const basic_string<Type, Alloc, Traits>& left,
+							const Type* right) {
+
+	return left.compare(right) == 0;
+}
+
+template<class Type, class Alloc, class Traits>
+constexpr bool operator!=(	const basic_string<Type, Alloc, Traits>& left,
+							const Type* right) {
+
+	return !(left == right);
+}
+
 template<class Type, class Alloc, class Traits>
 constexpr basic_string<Type, Alloc, Traits> operator+(	const basic_string<Type, Alloc, Traits>& left,
 														const basic_string<Type, Alloc, Traits>& right) {
@@ -0,0 +1,165 @@
+#pragma once
+#include "x_memory.h"
+#include "c_utility.h"
+
+#include <cstring>		// std::memcpy, std::memmove
+
+
+CUSTOM_BEGIN
+
+CUSTOM_DETAIL_BEGIN
+
+// Element operations shared by vector and small_vector, over data with _First, _Last and _Final.
+// They never allocate: growing stays with each container, since vector remaps large arrays
+// and small_vector moves between inline storage and the heap.
+
+template<class Alloc>
+struct _Vector_Storage_Traits			// which element operations may run on raw bytes
+{
+	using value_type = typename allocator_traits<Alloc>::value_type;
+
+	static constexpr bool _Default_Construct	= !_Has_Construct_Member_Function<Alloc, value_type>::value;
+	static constexpr bool _Default_Destroy		= !_Has_Destroy_Member_Function<Alloc, value_type>::value;
+
+	static constexpr bool _Copy_Bytes			= is_trivially_copyable_v<value_type> && _Default_Construct;
+	static constexpr bool _Relocate_Bytes		= is_trivially_relocatable_v<value_type> && _Default_Construct && _Default_Destroy;
+	static constexpr bool _Skip_Destroy			= is_trivially_destructible_v<value_type> && _Default_Destroy;
+};	// END _Vector_Storage_Traits
+
+template<class Type>
+void _copy_bytes(Type* const dest, const Type* const source, const size_t length) noexcept {
+	if (length != 0)													// source may be null when empty
+		std::memcpy(static_cast<void*>(dest), static_cast<const void*>(source), length * sizeof(Type));
+}
+
+template<class Type>
+void _move_bytes(Type* const dest, const Type* const source, const size_t length) noexcept {
+	if (length != 0)													// ranges may overlap
+		std::memmove(static_cast<void*>(dest), static_cast<const void*>(source), length * sizeof(Type));
+}
+
+template<class Alloc, class Type>
+constexpr void _construct_range(Alloc& alloc, Type* const address, const size_t length) {
+	for (size_t i = 0; i < length; ++i)
+		allocator_traits<Alloc>::construct(alloc, address + i);
+}
+
+template<class Alloc, class Type>
+constexpr void _construct_range(Alloc& alloc, Type* const address, const size_t length, const Type& value) {
+	for (size_t i = 0; i < length; ++i)
+		allocator_traits<Alloc>::construct(alloc, address + i, value);
+}
+
+template<class Alloc, class Type>
+constexpr void _destroy_range(Alloc& alloc, Type* const address, const size_t length) {
+	if constexpr (!_Vector_Storage_Traits<Alloc>::_Skip_Destroy)
+		for (size_t i = 0; i < length; ++i)
+			allocator_traits<Alloc>::destroy(alloc, address + i);
+}
+
+template<class Alloc, class Type>
+constexpr void _relocate_range(Alloc& alloc, Type* const dest, Type* const source, const size_t length) {	// Move raw dest <- source, leaving source raw (no overlap)
+	if (_Vector_Storage_Traits<Alloc>::_Relocate_Bytes && !custom::is_constant_evaluated())
+		_copy_bytes(dest, source, length);
+	else
+		for (size_t i = 0; i < length; ++i)
+		{
+			allocator_traits<Alloc>::construct(alloc, dest + i, custom::move(source[i]));
+			allocator_traits<Alloc>::destroy(alloc, source + i);
+		}
+}
+
+template<class Alloc, class Data>
+constexpr void _open_gap_in_place(Alloc& alloc, Data& data, const size_t index, const size_t count) {	// Relocate [index, size) count slots up, leaving the gap raw. Needs the spare capacity
+	const size_t oldSize = static_cast<size_t>(data._Last - data._First);
+
+	if (_Vector_Storage_Traits<Alloc>::_Relocate_Bytes && !custom::is_constant_evaluated())
+		_move_bytes(data._First + index + count, data._First + index, oldSize - index);
+	else
+		for (size_t i = oldSize; i > index; --i)						// back to front, every target is raw by the time it is reached
+		{
+			allocator_traits<Alloc>::construct(alloc, data._First + i - 1 + count, custom::move(data._First[i - 1]));
+			allocator_traits<Alloc>::destroy(alloc, data._First + i - 1);
+		}
+
+	data._Last += count;
+}
+
+template<class Alloc, class Data>
+constexpr void _close_gap(Alloc& alloc, Data& data, const size_t index, const size_t count) {	// Relocate [index + count, size) down over the raw gap
+	const size_t newSize = static_cast<size_t>(data._Last - data._First) - count;
+
+	if (_Vector_Storage_Traits<Alloc>::_Relocate_Bytes && !custom::is_constant_evaluated())
+		_move_bytes(data._First + index, data._First + index + count, newSize - index);
+	else
+		for (size_t i = index; i < newSize; ++i)
+		{
+			allocator_traits<Alloc>::construct(alloc, data._First + i, custom::move(data._First[i + count]));
+			allocator_traits<Alloc>::destroy(alloc, data._First + i + count);
+		}
+
+	data._Last -= count;
+}
+
+template<class Alloc, class Data, class Iter, bool Move>
+constexpr void _fill_gap(Alloc& alloc, Data& data, const size_t index, const size_t count, Iter first, bool_constant<Move>) {	// Construct count values from first in the raw gap, close it on throw
+	size_t built = 0;
+	try
+	{
+		for (/*Empty*/; built < count; ++built, ++first)
+			if constexpr (Move)
+				allocator_traits<Alloc>::construct(alloc, data._First + index + built, custom::move(*first));
+			else
+				allocator_traits<Alloc>::construct(alloc, data._First + index + built, *first);
+	}
+	catch (...)
+	{
+		_destroy_range(alloc, data._First + index, built);
+		_close_gap(alloc, data, index, count);
+		CUSTOM_RERAISE;
+	}
+}
+
+template<class Alloc, class Data>
+constexpr void _fill_gap_n(Alloc& alloc, Data& data, const size_t index, const size_t count, const typename Data::value_type& value) {	// Construct count copies of value in the raw gap
+	size_t built = 0;
+	try
+	{
+		for (/*Empty*/; built < count; ++built)
+			allocator_traits<Alloc>::construct(alloc, data._First + index + built, value);
+	}
+	catch (...)
+	{
+		_destroy_range(alloc, data._First + index, built);
+		_close_gap(alloc, data, index, count);
+		CUSTOM_RERAISE;
+	}
+}
+
+template<class Alloc, class Data>
+constexpr void _erase_gap(Alloc& alloc, Data& data, const size_t index, const size_t count) {	// Destroy [index, index + count) and close the gap
+	if (count != 0)
+	{
+		_destroy_range(alloc, data._First + index, count);
+		_close_gap(alloc, data, index, count);
+	}
+}
+
+template<class Alloc, class Data, class Iter>
+constexpr Iter _assign_live(Alloc& alloc, Data& data, Iter first, Iter last) {	// Assign over the live elements, destroy the ones left over, return what still needs appending
+	auto current = data._First;
+	for (/*Empty*/; first != last && current != data._Last; ++first, ++current)
+		*current = *first;
+
+	if (current != data._Last)											// range was shorter
+	{
+		_destroy_range(alloc, current, static_cast<size_t>(data._Last - current));
+		data._Last = current;
+	}
+
+	return first;
+}
+
+CUSTOM_DETAIL_END
+
+CUSTOM_END
\ No newline at end of file
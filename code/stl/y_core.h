@@ -19,6 +19,22 @@
 
 #define CUSTOM_OPTIMAL_IMPLEMENTATION 0    // some implementations are easier to understand, but have lower performance
 
+#ifndef CUSTOM_HASH_FNV1A
+#define CUSTOM_HASH_FNV1A 0    // 1 selects byte-wise FNV-1a for strings and large keys (slower, but stable across platforms)
+#endif
+
+#ifndef CUSTOM_LARGE_ALLOCATION_THRESHOLD
+#define CUSTOM_LARGE_ALLOCATION_THRESHOLD (4 * 1024 * 1024)    // vector arrays of at least this many bytes use large_allocator, 0 disables it
+#endif
+
+#ifndef CUSTOM_DEQUE_BLOCK_BYTES
+#define CUSTOM_DEQUE_BLOCK_BYTES 4096    // target deque block size, rounded down to a power of two element count (at least 16)
+#endif
+
+#ifndef CUSTOM_HASH_TABLE_STATS
+#define CUSTOM_HASH_TABLE_STATS 0    // 1 records lookup and rehash counters in hash tables, queried with stats()
+#endif
+
 #ifdef _MSC_VER
 // This is a Microsoft Specific. This is a __declspec extended attribute.
 // This form of __declspec can be applied to any class declaration,
@@ -39,7 +55,7 @@ CUSTOM_BEGIN
 CUSTOM_DETAIL_BEGIN // create the "detail" namespace inside "custom" namespace
 CUSTOM_DETAIL_END
 
-inline void __Assert(bool expr, const char* msg, const char* exprStr, const char* file, int line) {
+constexpr void __Assert(bool expr, const char* msg, const char* exprStr, const char* file, int line) {    // constexpr, so asserted accessors work in constant expressions
     if (!expr)
     {
         std::cerr   << "Assert failed:\t"   << msg << "\n"
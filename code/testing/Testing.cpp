@@ -171,6 +171,519 @@ void unordered_set_test() {
 	set.print_details();
 }
 
+void flat_hash_map_test() {
+	custom::flat_hash_map<int, custom::string> map;
+
+	map[10] = "abc";
+	map[11] = "gsa";
+	map[26] = "af";
+	map[101] = " a0";
+	map[54] = "69";
+	map[1] = "A bv";
+	map.emplace(3, "abc");
+	map.try_emplace(56, custom::string("shmecher"));
+	map.erase(26);
+
+	std::cout << map.at(10) << ' ' << map.contains(26) << '\n';
+
+	map.print_details();
+	std::cout << '\n';
+	for (auto& val : map)
+		std::cout << val.first << ' ' << val.second << '\n';
+}
+
+void flat_hash_set_test() {
+	custom::flat_hash_set<custom::string> set;
+	custom::flat_hash_set<custom::string> set1;
+
+	set.emplace("abc");
+	set.emplace("def");
+	set.emplace("ghi");
+	set.emplace("jkl");
+	set1 = custom::move(set);
+	set = custom::move(set1);
+
+	set.print_details();
+}
+
+void heterogeneous_lookup_test() {
+	custom::unordered_map<custom::string, int> umap;
+	custom::map<custom::string, int> map;
+
+	umap["abc"] = 1;
+	umap["def"] = 2;
+	map["abc"] = 1;
+	map["def"] = 2;
+
+	// no temporary custom::string is built for these lookups
+	custom::string_view view("def");
+	std::cout << umap.find(view)->second << ' ' << umap.contains("abc") << ' ' << umap.contains("xyz") << '\n';
+	std::cout << map.find(view)->second << ' ' << map.contains("abc") << ' ' << map.contains("xyz") << '\n';
+
+	umap.erase(view);
+	map.erase("abc");
+	std::cout << umap.size() << ' ' << map.size() << '\n';
+}
+
+void hash_table_stats_test() {
+#if CUSTOM_HASH_TABLE_STATS
+	struct BadHash { size_t operator()(int key) const { return static_cast<size_t>(key % 4); } };
+
+	custom::unordered_map<int, int> good;
+	custom::unordered_map<int, int, BadHash> bad;
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		good.emplace(i, i);
+		bad.emplace(i, i);
+	}
+
+	for (int i = 0; i < 2000; ++i)		// half hits, half misses
+	{
+		good.contains(i);
+		bad.contains(i);
+	}
+
+	auto print = [](const char* name, const custom::hash_table_stats& stats) {
+		std::cout << name << ": buckets= " << stats.bucket_count << " empty= " << stats.empty_buckets
+					<< " max chain= " << stats.max_chain << " rehashes= " << stats.rehash_count << " (" << stats.rehash_ms << " ms)"
+					<< " avg hit= " << stats.average_successful_comparisons()
+					<< " avg miss= " << stats.average_unsuccessful_comparisons() << '\n';
+	};
+
+	print("good hash", good.stats());
+	print("bad hash", bad.stats());
+#else
+	std::cout << "Compile with CUSTOM_HASH_TABLE_STATS=1\n";
+#endif
+}
+
+void hash_table_buckets_test() {
+	static size_t hashCalls = 0;
+	struct CountingHash { size_t operator()(const custom::string& key) const { ++hashCalls; return custom::hash<custom::string>()(key); } };
+
+	custom::unordered_map<custom::string, int, CountingHash> map;
+	for (int i = 0; i < 100; ++i)
+		map.emplace(std::to_string(i).c_str(), i);
+
+	hashCalls = 0;
+	map.rehash(1000);								// rounded up to a power of two, nodes are relinked with their cached hash
+
+	size_t nodes = 0;
+	for (size_t i = 0; i < map.bucket_count(); ++i)
+		nodes += map.bucket_size(i);
+
+	std::cout << "buckets= " << map.bucket_count() << ", power of two= " << custom::has_single_bit(map.bucket_count())
+				<< ", hash calls= " << hashCalls << ", nodes= " << nodes << '\n';
+
+	const size_t index = map.bucket("42");
+	std::cout << "\"42\" in bucket " << index << " (size " << map.bucket_size(index) << "), value= " << map.at("42") << '\n';
+}
+
+void incremental_rehash_test() {
+	custom::unordered_map<int, int> map;
+	map.set_incremental_rehash(true);
+
+	auto print = [&map](const char* name, const int count) {
+		size_t found = 0;
+		for (int i = 0; i < count; ++i)
+			found += map.contains(i) && map.at(i) == i * 10;
+
+		size_t nodes = 0;
+		for (size_t i = 0; i < map.bucket_count(); ++i)
+			nodes += map.bucket_size(i);				// buckets not migrated yet are counted from the old array
+
+		std::cout << name << ": buckets= " << map.bucket_count() << ", size= " << map.size()
+					<< ", found= " << found << ", nodes= " << nodes << '\n';
+	};
+
+	int next = 0;
+	for (/*Empty*/; map.bucket_count() < 1024; ++next)
+		map.emplace(next, next * 10);					// the last insert started a migration, most old buckets are still unmoved
+
+	map.erase(3);
+	map[3] = 30;
+	print("migrating", next);
+
+	for (int i = 0; i < 200; ++i, ++next)
+		map.emplace(next, next * 10);					// every insert moves a few old buckets
+	print("migrated", next);
+}
+
+void hash_bytes_test() {
+	constexpr char text[]		= "The quick brown fox jumps over the lazy dog, then naps under the old oak tree.";
+	constexpr size_t compiled	= custom::detail::_wyhash_bytes(text, sizeof(text) - 1);	// no seed from the process, same value at compile time
+
+	custom::string copy(text);
+	std::cout << "compile time == run time: " << (compiled == custom::detail::_wyhash_bytes(copy.data(), copy.size())) << '\n';
+	std::cout << "hash<string> == hash<string_view>: "
+				<< (custom::hash<custom::string>()(copy) == custom::hash<custom::string_view>()(custom::string_view(text))) << '\n';
+
+	for (size_t length : {3, 12, 40, 78})				// short, overlapping 4 byte reads, 16 byte steps, 48 byte steps
+	{
+		custom::string key(custom::string_view(text, length));
+		custom::string same(custom::string_view(text, length));
+		const size_t hashVal = custom::hash<custom::string>()(key);
+
+		key[length - 1] ^= 1;
+		std::cout << "length " << length << ": equal keys match= " << (hashVal == custom::hash<custom::string>()(same))
+					<< ", last byte changed differs= " << (hashVal != custom::hash<custom::string>()(key)) << '\n';
+	}
+}
+
+void node_handle_test() {
+	custom::map<int, custom::string> map = {{1, "one"}, {2, "two"}, {3, "three"}};
+	custom::map<int, custom::string> other = {{3, "drei"}, {4, "vier"}};
+	custom::unordered_map<int, custom::string> umap;
+	custom::unordered_map<int, custom::string> otherUmap;
+
+	auto node = map.extract(2);						// the node changes owner, the string is not copied
+	node.key() = 20;
+	map.insert(custom::move(node));
+	map.merge(other);								// 3 already exists, so "drei" stays in other
+
+	for (const auto& val : map)
+		std::cout << val.first << ' ' << val.second << '\n';
+
+	umap[1]			= "one";
+	otherUmap[1]	= "uno";
+	otherUmap[2]	= "dos";
+	umap.insert(otherUmap.extract(2));
+	umap.merge(otherUmap);
+
+	std::cout << "other size= " << other.size() << ", umap size= " << umap.size() << ", otherUmap size= " << otherUmap.size() << '\n';
+	std::cout << "Empty= " << map.extract(100).empty() << '\n';
+}
+
+void frozen_map_test() {
+	enum class Method { Get, Put, Post, Delete };
+
+	constexpr auto methods = custom::make_frozen_map<custom::string_view, Method>({	// built by the compiler, no allocation
+		{"GET", Method::Get}, {"PUT", Method::Put}, {"POST", Method::Post}, {"DELETE", Method::Delete}});
+	constexpr auto keywords = custom::make_frozen_set<custom::string_view>({"if", "else", "while", "for", "return"});
+
+	static_assert(methods.at("POST") == Method::Post);
+	static_assert(!methods.contains("PATCH"));
+	static_assert(keywords.contains("while") && !keywords.contains("do"));
+
+	for (const auto& val : methods)
+		std::cout << val.first.data() << ' ' << static_cast<int>(val.second) << '\n';
+
+	std::cout << "size= " << methods.size() << ", contains(\"return\")= " << keywords.contains("return") << '\n';
+}
+
+void btree_map_test() {
+	custom::btree_map<int, custom::string> map;
+	custom::btree_set<int> set = {9, 3, 7, 1};
+
+	for (int i = 0; i < 100; ++i)								// enough values to split the root a few times
+		map[i].append(1, static_cast<char>('a' + i % 26));
+
+	for (int i = 0; i < 100; i += 3)
+		map.erase(i);
+
+	for (auto it = map.lower_bound(40); it != map.upper_bound(50); ++it)
+		std::cout << it->first << ' ' << it->second << '\n';
+
+	for (const auto& val : set)
+		std::cout << val << ' ';
+
+	std::cout << "\nsize= " << map.size() << ", node capacity= " << map.node_capacity() << '\n';
+
+	struct ThrowOnCopy
+	{
+		ThrowOnCopy() = default;
+		ThrowOnCopy(ThrowOnCopy&&) noexcept = default;
+		ThrowOnCopy(const ThrowOnCopy&) { throw std::runtime_error("copy"); }
+	};
+
+	custom::btree_map<int, ThrowOnCopy> empty;
+	const ThrowOnCopy value;
+
+	try
+	{
+		empty.try_emplace(1, value);						// throws while constructing the first value
+	}
+	catch (const std::runtime_error&)
+	{
+		std::cout << "first insert threw, size= " << empty.size() << ", empty range= " << (empty.begin() == empty.end()) << '\n';
+	}
+
+	empty.try_emplace(2, ThrowOnCopy());
+	std::cout << "after retry size= " << empty.size() << '\n';
+}
+
+void map_bounds_test() {
+	custom::map<int, custom::string> series;
+
+	for (int time = 0; time < 100; time += 10)				// sorted input, each insert lands next to the hint
+		series.emplace_hint(series.end(), time, "sample");
+
+	std::cout << "[25, 60]: ";
+	for (auto it = series.lower_bound(25); it != series.upper_bound(60); ++it)
+		std::cout << it->first << ' ';
+
+	auto range = series.equal_range(40);
+	std::cout << "\nequal_range(40) size= " << custom::distance(range.first, range.second) << '\n';
+}
+
+void map_set_operations_test() {
+	custom::vector<int> sorted = {1, 2, 2, 3, 5, 8, 13};
+	custom::set<int> fib(sorted.begin(), sorted.end());		// sorted range, built in O(n)
+	custom::set<int> odd = {1, 3, 5, 7, 9, 11, 13};
+
+	custom::set<int> both = fib;
+	both.intersect_with(odd);
+	std::cout << "intersect: ";
+	for (int val : both)
+		std::cout << val << ' ';
+
+	custom::set<int> onlyFib = fib;
+	onlyFib.difference_with(odd);
+	std::cout << "\ndifference: ";
+	for (int val : onlyFib)
+		std::cout << val << ' ';
+
+	fib.union_with(odd);
+	std::cout << "\nunion: ";
+	for (int val : fib)
+		std::cout << val << ' ';
+	std::cout << '\n';
+}
+
+void map_order_statistics_test() {
+	custom::map<int, custom::string,
+				custom::less<int>,
+				custom::allocator<custom::pair<int, custom::string>>,
+				custom::order_statistic_tree_policy> leaderboard;
+
+	leaderboard.emplace(1200, "ana");
+	leaderboard.emplace(950, "bob");
+	leaderboard.emplace(1730, "dan");
+	leaderboard.emplace(1410, "eve");
+
+	std::cout << "players below 1300: " << leaderboard.rank(1300) << '\n';
+	std::cout << "median: " << leaderboard.nth(leaderboard.size() / 2)->second << '\n';
+
+	leaderboard.erase(950);
+	std::cout << "lowest after erase: " << leaderboard.nth(0)->second << '\n';
+}
+
+struct _Classic_Tree_Policy			// color and nil flags in their own fields
+{
+	static constexpr bool order_statistics	= false;
+	static constexpr bool compact_nodes		= false;
+};
+
+void map_compact_node_test() {
+	using Value = custom::map<int, int>::value_type;
+
+	custom::map<int, int> compact;
+	custom::map<int, int, custom::less<int>, custom::allocator<custom::pair<int, int>>, _Classic_Tree_Policy> classic;
+
+	std::cout << "node bytes: compact= " << sizeof(custom::detail::_Compact_Tree_Node<Value>)
+				<< ", classic= " << sizeof(custom::detail::_Tree_Node<Value>) << '\n';
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		const int key = (i * 7919) % 1000;				// shuffled, so inserts rotate and recolor all over the tree
+		compact.emplace(key, i);
+		classic.emplace(key, i);
+	}
+
+	for (int key = 0; key < 1000; key += 3)
+	{
+		compact.erase(key);
+		classic.erase(key);
+	}
+
+	const bool same = compact.size() == classic.size() && custom::equal(compact.begin(), compact.end(), classic.begin());
+	std::cout << "size= " << compact.size() << ", same as classic= " << same << '\n';
+
+	custom::map<int, int> small;
+	for (int key : {5, 1, 8, 3, 9, 2})
+		small.emplace(key, key);
+
+	small.erase(8);
+	small.print_details();								// colors read back from the parent pointer bits
+}
+
+void flat_map_test() {
+	custom::flat_map<int, custom::string> ports;
+
+	ports.emplace(443, "https");
+	ports.emplace(22, "ssh");
+	ports[80] = "http";
+
+	custom::vector<custom::pair<int, custom::string>> more;
+	more.emplace_back(53, "dns");
+	more.emplace_back(25, "smtp");
+	more.emplace_back(22, "duplicate ssh");		// existing key wins
+	ports.insert(more.begin(), more.end());
+
+	for (const auto& val : ports)
+		std::cout << val.first << ' ' << val.second << '\n';
+
+	std::cout << "first port from 50: " << ports.lower_bound(50)->first << '\n';
+	std::cout << "at(22): " << ports.at(22) << '\n';
+
+	custom::flat_set<int> primes(custom::sorted_unique, {2, 3, 5, 7, 11});
+	primes.insert({13, 2, 17});
+	std::cout << "primes: " << primes.size() << ", contains 11: " << primes.contains(11) << '\n';
+}
+
+void vector_range_test() {
+	custom::vector<int> v = {1, 2, 7, 8};
+	custom::vector<int> middle = {3, 4, 5, 6};
+
+	v.insert(v.begin() + 2, middle.begin(), middle.end());		// one shift of the tail
+	v.insert(v.end(), 2, 9);
+	v.erase(v.begin(), v.begin() + 1);
+
+	for (const auto& val : v)
+		std::cout << val << ' ';
+	std::cout << '\n';
+
+	custom::vector<custom::pair<int, custom::string>> pairs;		// emplace doesn't need a default constructor
+	pairs.emplace(pairs.end(), 2, "two");
+	pairs.emplace(pairs.begin(), 1, "one");
+	std::cout << pairs[0].second << ' ' << pairs[1].second << '\n';
+
+	v.assign({10, 20});
+	std::cout << v.size() << ' ' << v.capacity() << '\n';
+}
+
+void vector_relocation_test() {
+	std::cout << "trivially relocatable: string= " << custom::is_trivially_relocatable_v<custom::string>
+				<< ", vector<int>= " << custom::is_trivially_relocatable_v<custom::vector<int>>
+				<< ", unique_ptr<int>= " << custom::is_trivially_relocatable_v<custom::unique_ptr<int>>
+				<< ", Test= " << custom::is_trivially_relocatable_v<Test> << '\n';
+
+	custom::vector<custom::string> strings = {"alpha", "beta", "gamma"};
+	const char* buffer = strings[2].c_str();
+
+	strings.reserve(64);							// one memcpy, no string is moved or destroyed
+	strings.insert(strings.begin(), "first");		// the tail is memmoved up
+	strings.erase(strings.begin() + 1);				// and back down over the gap
+
+	std::cout << "gamma buffer kept= " << (buffer == strings[2].c_str()) << ", values= ";
+	for (const auto& val : strings)
+		std::cout << val << ' ';
+	std::cout << '\n';
+
+	custom::vector<Test> tests;						// user defined moves, relocated one element at a time
+	tests.reserve(2);
+	tests.emplace_back(1);
+	tests.emplace_back(2);
+	tests.reserve(4);
+}
+
+void resize_for_overwrite_test() {
+	custom::vector<int> squares = {-1};
+	squares.resize_for_overwrite(8);				// the first value stays, the rest is not zeroed
+	for (int i = 1; i < 8; ++i)
+		squares[i] = i * i;
+
+	for (const auto& val : squares)
+		std::cout << val << ' ';
+	std::cout << '\n';
+
+	custom::string text("id=");
+	text.resize_and_overwrite(16, [](char* buffer, const size_t count) {		// buffer already starts with "id="
+		size_t size = 3;
+		for (int digit = 7; digit > 0 && size < count; --digit)
+			buffer[size++] = static_cast<char>('0' + digit);
+
+		return size;
+	});
+	std::cout << text << " (size " << text.size() << ")\n";
+
+	custom::small_vector<char, 16> packet;
+	packet.resize_and_overwrite(16, [](char* buffer, const size_t) {			// like a read() that returns fewer bytes than asked
+		buffer[0] = 'o';
+		buffer[1] = 'k';
+		return 2;
+	});
+	std::cout << "packet: " << packet[0] << packet[1] << ", size: " << packet.size() << ", inline: " << packet.is_inline() << '\n';
+}
+
+void vector_large_growth_test() {
+	constexpr size_t count	= 2 * CUSTOM_LARGE_ALLOCATION_THRESHOLD / sizeof(size_t);		// twice the threshold, so later growth steps are remapped
+	constexpr size_t small	= 1000;
+
+	custom::vector<size_t> values;
+	size_t regrowths = 0;
+	for (size_t i = 0; i < count; ++i)
+	{
+		if (values.size() == values.capacity())
+			++regrowths;
+
+		values.push_back(i * 3);
+	}
+
+	bool intact = true;
+	for (size_t i = 0; i < count; ++i)
+		intact = intact && values[i] == i * 3;
+
+	std::cout << "size= " << values.size() << ", regrowths= " << regrowths << ", intact= " << intact << '\n';
+
+	values.resize(small);
+	values.shrink_to_fit();										// back from mapped pages to the default allocator
+	custom::vector<size_t> copy = values;
+	std::cout << "after shrink: capacity= " << values.capacity() << ", copy back= " << copy.back() << '\n';
+
+	custom::large_allocator<int> alloc;							// the allocator on its own
+	int* block = alloc.allocate(small);
+	for (size_t i = 0; i < small; ++i)
+		block[i] = static_cast<int>(i);
+
+#if defined __linux__
+	block = alloc.reallocate(block, small, 100 * small);		// bytes kept, the tail is new zero pages
+	std::cout << "remapped: " << block[small - 1] << ' ' << block[100 * small - 1] << '\n';
+	alloc.deallocate(block, 100 * small);
+#else
+	alloc.deallocate(block, small);
+#endif
+}
+
+void small_vector_test() {
+	custom::small_vector<int, 4> v = {5, 3, 1};
+	std::cout << "inline: " << v.is_inline() << ", capacity: " << v.capacity() << '\n';
+
+	v.push_back(4);
+	v.push_back(2);					// spills to the heap
+	std::cout << "inline: " << v.is_inline() << ", capacity: " << v.capacity() << '\n';
+
+	custom::sort(v.begin(), v.end());
+	for (const auto& val : v)
+		std::cout << val << ' ';
+	std::cout << '\n';
+
+	v.erase(v.begin() + 1, v.end());
+	v.shrink_to_fit();				// back inline
+	custom::small_vector<int, 4> moved = custom::move(v);
+	std::cout << "inline: " << moved.is_inline() << ", size: " << moved.size() << '\n';
+}
+
+void stable_vector_test() {
+	custom::stable_vector<int> v = {5, 3, 1};
+	const int* first = &v.front();
+
+	for (int i = 0; i < 1000; ++i)
+		v.push_back(i);				// appends segments, nothing moves
+
+	std::cout << "stable: " << (first == &v.front()) << ", segments: " << v.segment_count() << ", capacity: " << v.capacity() << '\n';
+
+	custom::sort(v.begin(), v.begin() + 3);
+	for (auto it = v.begin(); it != v.begin() + 3; ++it)
+		std::cout << *it << ' ';
+	std::cout << '\n';
+
+	v.resize(3);
+	v.shrink_to_fit();				// frees the unused segments
+	std::cout << "size: " << v.size() << ", segments: " << v.segment_count() << '\n';
+}
+
 void map_test() {
 	custom::map<int, int> map;
 
@@ -229,6 +742,58 @@ void deque_test() {
 	dq.print_details();
 }
 
+void deque_block_test() {
+	struct Big { char bytes[1024]; };
+
+	std::cout << "block size: char= " << custom::deque_block_size<char>::value
+				<< ", int= " << custom::deque_block_size<int>::value
+				<< ", 1KB struct= " << custom::deque_block_size<Big>::value << '\n';		// powers of two, so indexing is a shift and a mask
+
+	custom::deque<int> dq;
+	for (int i = 0; i < 3000; ++i)
+	{
+		dq.push_back(i);
+		dq.push_front(-i - 1);					// the first block is only partly used
+	}
+
+	for (int i = 0; i < 1500; ++i)
+		dq.pop_front();
+
+	bool indexed = true;
+	for (size_t i = 0; i < dq.size(); ++i)
+		indexed = indexed && dq[i] == static_cast<int>(i) - 1500;
+
+	auto it = dq.begin() + 2000;				// crosses several blocks at once
+	it -= 999;
+	std::cout << "size= " << dq.size() << ", indexed= " << indexed << ", *it= " << *it
+				<< ", it[500]= " << it[500] << ", back= " << *(it + (dq.size() - 1002)) << '\n';
+}
+
+void segmented_algorithm_test() {
+	constexpr size_t block = custom::deque_block_size<int>::value;
+
+	custom::deque<int> dq;
+	for (size_t i = 0; i < 3 * block; ++i)
+		dq.push_back(static_cast<int>(i));
+	for (int i = 1; i <= 100; ++i)
+		dq.push_front(-i);						// begin() is in the middle of a block
+
+	custom::vector<int> flat(dq.size());
+	custom::copy(dq.begin(), dq.end(), flat.begin());						// deque source, one memmove per block
+	std::cout << "copied= " << custom::equal(flat.begin(), flat.end(), dq.begin())
+				<< ", sum= " << custom::accumulate(dq.begin(), dq.end(), 0LL) << '\n';
+
+	custom::fill(dq.begin() + 50, dq.begin() + 50 + 2 * block, 7);			// spans three blocks
+	std::cout << "filled= " << custom::count(dq.begin(), dq.end(), 7) << '\n';
+
+	dq[block + 100] = -42;														// first element of a block
+	auto found = custom::find(dq.begin(), dq.end(), -42);
+	std::cout << "found= " << (found == dq.begin() + (block + 100)) << ", missing= " << (custom::find(dq.begin(), dq.end(), 12345) == dq.end()) << '\n';
+
+	custom::copy(flat.begin(), flat.end(), dq.begin());						// vector source into the deque blocks
+	std::cout << "restored= " << custom::equal(dq.begin(), dq.end(), flat.begin()) << ", front= " << dq.front() << ", back= " << dq.back() << '\n';
+}
+
 void queue_test() {
 	custom::queue<Test> q;
 
@@ -45,8 +45,31 @@ void list_test();
 void forward_list_test();
 void unordered_map_test();
 void unordered_set_test();
+void flat_hash_map_test();
+void flat_hash_set_test();
+void heterogeneous_lookup_test();
+void hash_table_stats_test();
+void hash_table_buckets_test();
+void incremental_rehash_test();
+void hash_bytes_test();
+void node_handle_test();
+void frozen_map_test();
+void btree_map_test();
+void map_bounds_test();
+void map_set_operations_test();
+void map_order_statistics_test();
+void map_compact_node_test();
+void flat_map_test();
+void vector_range_test();
+void vector_relocation_test();
+void resize_for_overwrite_test();
+void vector_large_growth_test();
+void small_vector_test();
+void stable_vector_test();
 void map_test();
 void deque_test();
+void deque_block_test();
+void segmented_algorithm_test();
 void queue_test();
 void priority_queue_test();
 void stack_test();
@@ -0,0 +1,1321 @@
+#include "TestingBenchmark.h"
+
+#if defined __GLIBC__
+#include <malloc.h>     // malloc_trim
+#endif
+
+#if defined __linux__
+#include <fstream>      // /proc/self/status, /proc/self/clear_refs
+#endif
+
+
+TEST_BENCHMARK_BEGIN
+
+_Stopwatch::_Stopwatch()
+    : _Start(custom::chrono::steady_clock::now()) { /*Empty*/ }
+
+void _Stopwatch::restart() {
+    _Start = custom::chrono::steady_clock::now();
+}
+
+double _Stopwatch::elapsed_ms() const {
+    auto elapsed = custom::chrono::steady_clock::now() - _Start;
+    return static_cast<double>(custom::chrono::duration_cast<custom::chrono::nanoseconds>(elapsed).count()) / 1e6;
+}
+
+custom::vector<size_t> _random_keys(size_t count, size_t seed) {
+    custom::vector<size_t> keys;
+    keys.reserve(count);
+
+    size_t state = seed * 0x9E3779B97F4A7C15ULL + 1;
+    for (size_t i = 0; i < count; ++i)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        keys.push_back(state);
+    }
+
+    return keys;
+}
+
+void _print_result(const char* name, double ms, size_t ops) {
+    std::cout << "\t" << name << ": " << ms << " ms (" << static_cast<double>(ops) / (ms * 1000.0) << " Mops/s)\n";
+}
+
+
+template<class Map>
+static void _hash_map_throughput(const char* name, const custom::vector<size_t>& keys, const custom::vector<size_t>& missing, size_t rounds) {
+    Map map;
+    size_t checksum = 0;
+    _Stopwatch watch;
+
+    for (size_t i = 0; i < keys.size(); ++i)
+        map.emplace(keys[i], i);
+
+    _print_result((custom::string(name) + " insert").c_str(), watch.elapsed_ms(), keys.size());
+
+    watch.restart();
+    for (size_t round = 0; round < rounds; ++round)
+        for (const size_t key : keys)
+            checksum += map.find(key)->second;
+
+    _print_result((custom::string(name) + " find hit").c_str(), watch.elapsed_ms(), keys.size() * rounds);
+
+    watch.restart();
+    for (size_t round = 0; round < rounds; ++round)
+        for (const size_t key : missing)
+            checksum += map.find(key) == map.end();
+
+    _print_result((custom::string(name) + " find miss").c_str(), watch.elapsed_ms(), missing.size() * rounds);
+
+    watch.restart();
+    for (const size_t key : keys)
+        map.erase(key);
+
+    _print_result((custom::string(name) + " erase").c_str(), watch.elapsed_ms(), keys.size());
+    std::cout << "\t(checksum " << checksum << ")\n";
+}
+
+void flat_hash_map_benchmark() {
+    constexpr size_t totalLookups = 4000000;
+
+    for (const size_t count : {10000, 1000000})     // cache resident and memory bound
+    {
+        custom::vector<size_t> keys     = _random_keys(count, 1);
+        custom::vector<size_t> missing  = _random_keys(count, 2);
+        const size_t rounds             = totalLookups / count;
+
+        std::cout << "flat_hash_map vs unordered_map (" << count << " size_t keys)\n";
+        _hash_map_throughput<custom::unordered_map<size_t, size_t>>("unordered_map", keys, missing, rounds);
+        _hash_map_throughput<custom::flat_hash_map<size_t, size_t>>("flat_hash_map", keys, missing, rounds);
+    }
+}
+
+
+template<class Map, class EmplaceFunc>
+static void _emplace_allocations(const char* name, const custom::vector<size_t>& keys, EmplaceFunc emplaceFunc) {
+    Map map;
+    _AllocationCount = 0;
+    _Stopwatch watch;
+
+    for (size_t i = 0; i < keys.size(); ++i)
+        emplaceFunc(map, keys[i], i);
+
+    const double ms = watch.elapsed_ms();
+    _print_result(name, ms, keys.size());
+    std::cout << "\t\tallocations: " << _AllocationCount << ", size: " << map.size() << "\n";
+}
+
+void hash_table_emplace_allocation_benchmark() {
+    using _Map = custom::unordered_map<size_t, size_t,
+                                        custom::hash<size_t>,
+                                        custom::equal_to<size_t>,
+                                        _Counting_Allocator<custom::pair<size_t, size_t>>>;
+
+    constexpr size_t count      = 1000000;
+    constexpr size_t distinct   = count / 5;    // 80% of the emplace calls hit an existing key
+
+    custom::vector<size_t> keys = _random_keys(count, 3);
+    for (size_t& key : keys)
+        key %= distinct;
+
+    std::cout << "unordered_map emplace, 80% duplicate keys (" << count << " calls)\n";
+
+    _emplace_allocations<_Map>("emplace(key, value)", keys,
+        [](_Map& map, size_t key, size_t value) {
+            map.emplace(key, value);    // key is extracted, node allocated only on miss
+        });
+
+    _emplace_allocations<_Map>("emplace(piecewise_construct, ...)", keys,
+        [](_Map& map, size_t key, size_t value) {
+            map.emplace(custom::piecewise_construct,    // key unknown until the node is built
+                        custom::forward_as_tuple(key),
+                        custom::forward_as_tuple(value));
+        });
+}
+
+
+static void _insert_latencies(const char* name, const custom::vector<size_t>& keys, bool incremental) {
+    custom::unordered_map<size_t, size_t> map;
+    map.set_incremental_rehash(incremental);
+
+    std::vector<double> latencies(keys.size());     // std::sort for the percentiles
+    _Stopwatch total;
+    _Stopwatch watch;
+
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        watch.restart();
+        map.emplace(keys[i], i);
+        latencies[i] = watch.elapsed_ms() * 1000.0;
+    }
+
+    const double totalMs = total.elapsed_ms();
+    std::sort(latencies.begin(), latencies.end());
+
+    auto percentile = [&latencies](double p) {
+        return latencies[static_cast<size_t>(p * static_cast<double>(latencies.size() - 1))];
+    };
+
+    _print_result(name, totalMs, keys.size());
+    std::cout   << "\t\tp50: "    << percentile(0.5)   << " us"
+                << ", p99: "        << percentile(0.99)  << " us"
+                << ", p999: "       << percentile(0.999) << " us"
+                << ", max: "        << latencies.back()  << " us\n";
+}
+
+void hash_table_insert_latency_benchmark() {
+    constexpr size_t count = 10000000;
+
+    custom::vector<size_t> keys = _random_keys(count, 4);
+
+    std::cout << "unordered_map insert latency (" << count << " size_t keys)\n";
+    _insert_latencies("stop-the-world rehash", keys, false);
+    _insert_latencies("incremental rehash", keys, true);
+}
+
+
+template<class HashFunc>
+static double _hash_bytes_gbps(const custom::vector<unsigned char>& buffer, size_t keyLength, size_t& checksum, HashFunc hashFunc) {
+    constexpr size_t totalBytes = 1ULL << 30;
+
+    const size_t keyCount   = buffer.size() / keyLength;
+    const size_t hashCount  = totalBytes / keyLength;
+    _Stopwatch watch;
+
+    for (size_t i = 0; i < hashCount; ++i)
+        checksum += hashFunc(buffer.data() + (i % keyCount) * keyLength, keyLength);
+
+    return static_cast<double>(hashCount * keyLength) / (watch.elapsed_ms() * 1e6);
+}
+
+void hash_bytes_throughput_benchmark() {
+    custom::vector<size_t> words = _random_keys(4096, 6);     // 32 KiB, cache resident
+    custom::vector<unsigned char> buffer(words.size() * sizeof(size_t));
+    std::memcpy(buffer.data(), words.data(), buffer.size());
+
+    size_t checksum = 0;
+    std::cout << "byte hash throughput (GB/s)\n";
+
+    for (const size_t keyLength : {4, 8, 16, 32, 40, 64, 100, 200, 1024})
+    {
+        const double fnv = _hash_bytes_gbps(buffer, keyLength, checksum,
+            [](const unsigned char* first, size_t count) {
+                return custom::detail::_fnv1a_append_bytes(custom::detail::_FNVOffsetBasis, first, count);
+            });
+
+        const double wy = _hash_bytes_gbps(buffer, keyLength, checksum,
+            [](const unsigned char* first, size_t count) {
+                return custom::detail::_wyhash_bytes(first, count);
+            });
+
+        std::cout << "\t" << keyLength << " bytes: FNV-1a " << fnv << ", wyhash " << wy << '\n';
+    }
+
+    std::cout << "\t(checksum " << checksum << ")\n";
+}
+
+template<class Map>
+static void _repartition(const char* name, const custom::vector<size_t>& keys) {
+    Map source;
+    Map evens;
+    Map odds;
+
+    for (size_t i = 0; i < keys.size(); ++i)
+        source.emplace(keys[i], "partitioned payload");
+
+    Map copySource(source);
+    _AllocationCount = 0;
+    _Stopwatch watch;
+
+    for (const auto& val : copySource)      // copy every entry into its partition
+        (val.first % 2 == 0 ? evens : odds).emplace(val.first, val.second);
+    copySource.clear();
+
+    _print_result((custom::string(name) + " copy").c_str(), watch.elapsed_ms(), keys.size());
+    std::cout << "\t\tallocations: " << _AllocationCount << '\n';
+
+    Map nodeEvens;
+    Map nodeOdds;
+    _AllocationCount = 0;
+    watch.restart();
+
+    for (auto it = source.begin(); it != source.end(); /*Empty*/)     // relink every node into its partition
+    {
+        auto current = it++;
+        (current->first % 2 == 0 ? nodeEvens : nodeOdds).insert(source.extract(current));
+    }
+
+    _print_result((custom::string(name) + " extract/insert").c_str(), watch.elapsed_ms(), keys.size());
+    std::cout << "\t\tallocations: " << _AllocationCount << " (bucket arrays only for hash tables)\n";
+}
+
+void node_handle_repartition_benchmark() {
+    using _Alloc = _Counting_Allocator<custom::pair<size_t, custom::string>>;
+
+    constexpr size_t count      = 1000000;
+    custom::vector<size_t> keys = _random_keys(count, 7);
+
+    std::cout << "repartition " << count << " entries into two maps\n";
+
+    _repartition<custom::map<size_t, custom::string, custom::less<size_t>, _Alloc>>("map", keys);
+    _repartition<custom::unordered_map<size_t, custom::string, custom::hash<size_t>, custom::equal_to<size_t>, _Alloc>>("unordered_map", keys);
+}
+
+static constexpr auto _HeaderFields = custom::make_frozen_map<custom::string_view, size_t>({
+    {"Accept", 0}, {"Accept-Encoding", 1}, {"Accept-Language", 2}, {"Authorization", 3},
+    {"Cache-Control", 4}, {"Connection", 5}, {"Content-Encoding", 6}, {"Content-Length", 7},
+    {"Content-Type", 8}, {"Cookie", 9}, {"Date", 10}, {"ETag", 11},
+    {"Expires", 12}, {"Host", 13}, {"If-Match", 14}, {"If-Modified-Since", 15},
+    {"If-None-Match", 16}, {"Last-Modified", 17}, {"Location", 18}, {"Origin", 19},
+    {"Pragma", 20}, {"Range", 21}, {"Referer", 22}, {"Server", 23},
+    {"Set-Cookie", 24}, {"Transfer-Encoding", 25}, {"Upgrade", 26}, {"User-Agent", 27},
+    {"Vary", 28}, {"Via", 29}, {"WWW-Authenticate", 30}, {"X-Forwarded-For", 31}});
+
+void frozen_map_lookup_benchmark() {
+    using _Alloc = _Counting_Allocator<custom::pair<custom::string_view, size_t>>;
+
+    constexpr size_t rounds = 200000;
+    custom::vector<custom::string_view> queries;
+
+    for (const auto& val : _HeaderFields)
+        queries.emplace_back(val.first);
+    queries.emplace_back("X-Missing");         // some misses
+    queries.emplace_back("Accept-Charset");
+
+    std::cout << "lookup " << queries.size() << " header names, " << rounds << " rounds\n";
+
+    _AllocationCount = 0;
+    _Stopwatch watch;
+
+    custom::unordered_map<custom::string_view, size_t, custom::hash<custom::string_view>,
+                            custom::equal_to<custom::string_view>, _Alloc> fields;
+    for (const auto& val : _HeaderFields)      // what a startup built table costs
+        fields.emplace(val.first, val.second);
+
+    std::cout << "\tunordered_map build: " << watch.elapsed_ms() << " ms, allocations: " << _AllocationCount << '\n';
+    std::cout << "\tfrozen_map build: 0 ms (compile time), allocations: 0\n";
+
+    size_t checksum = 0;
+    watch.restart();
+
+    for (size_t round = 0; round < rounds; ++round)
+        for (const auto& query : queries)
+        {
+            auto it = fields.find(query);
+            checksum += (it == fields.end()) ? 1 : it->second;
+        }
+
+    _print_result("unordered_map find", watch.elapsed_ms(), rounds * queries.size());
+    watch.restart();
+
+    for (size_t round = 0; round < rounds; ++round)
+        for (const auto& query : queries)
+        {
+            auto it = _HeaderFields.find(query);
+            checksum += (it == _HeaderFields.end()) ? 1 : it->second;
+        }
+
+    _print_result("frozen_map find", watch.elapsed_ms(), rounds * queries.size());
+    std::cout << "\t(checksum " << checksum << ")\n";
+}
+
+template<class Map>
+static void _ordered_map_run(const char* name, const custom::vector<size_t>& keys) {
+    constexpr size_t scans      = 10000;
+    constexpr size_t scanLength = 100;
+
+    _AllocatedBytes = 0;
+    Map map;
+    _Stopwatch watch;
+
+    for (size_t i = 0; i < keys.size(); ++i)
+        map.emplace(keys[i], i);
+
+    std::cout << '\t' << name << '\n';
+    _print_result("insert", watch.elapsed_ms(), keys.size());
+    std::cout << "\tbytes per element: " << static_cast<double>(_AllocatedBytes) / map.size() << '\n';
+
+    size_t checksum = 0;
+    watch.restart();
+
+    for (const size_t key : keys)
+        checksum += map.find(key)->second;
+
+    _print_result("find", watch.elapsed_ms(), keys.size());
+    watch.restart();
+
+    for (size_t scan = 0; scan < scans; ++scan)     // short in-order walks from random keys
+    {
+        auto it = map.find(keys[scan]);
+        for (size_t step = 0; step < scanLength && it != map.end(); ++step, ++it)
+            checksum += it->second;
+    }
+
+    _print_result("range scan", watch.elapsed_ms(), scans * scanLength);
+    watch.restart();
+
+    for (const auto& val : map)
+        checksum += val.second;
+
+    _print_result("full scan", watch.elapsed_ms(), map.size());
+    std::cout << "\t(checksum " << checksum << ")\n";
+}
+
+void btree_map_benchmark() {
+    using _Alloc = _Counting_Allocator<custom::pair<size_t, size_t>>;
+
+    constexpr size_t count      = 1000000;
+    custom::vector<size_t> keys = _random_keys(count, 8);
+
+    std::cout << "ordered map with " << count << " random keys\n";
+
+    _ordered_map_run<custom::map<size_t, size_t, custom::less<size_t>, _Alloc>>("map", keys);
+    _ordered_map_run<custom::btree_map<size_t, size_t, custom::less<size_t>, _Alloc>>("btree_map (256 byte nodes)", keys);
+    _ordered_map_run<custom::btree_map<size_t, size_t, custom::less<size_t>, _Alloc, 512>>("btree_map (512 byte nodes)", keys);
+}
+
+void map_sorted_load_benchmark() {
+    constexpr size_t count = 1000000;
+
+    std::cout << "load " << count << " sorted keys into map\n";
+
+    {
+        custom::map<size_t, size_t> map;
+        _Stopwatch watch;
+
+        for (size_t i = 0; i < count; ++i)
+            map.emplace(i, i);
+
+        _print_result("emplace", watch.elapsed_ms(), count);
+    }
+
+    {
+        custom::map<size_t, size_t> map;
+        _Stopwatch watch;
+
+        for (size_t i = 0; i < count; ++i)     // the new key always belongs at the end
+            map.emplace_hint(map.end(), i, i);
+
+        _print_result("emplace_hint(end())", watch.elapsed_ms(), count);
+    }
+}
+
+void map_set_operations_benchmark() {
+    constexpr size_t count = 1000000;
+    constexpr size_t small = 1000;
+
+    custom::vector<size_t> keys;
+    for (size_t i = 0; i < count; ++i)
+        keys.push_back(i * 2);
+
+    std::cout << "build map from " << count << " sorted keys\n";
+
+    {
+        _Stopwatch watch;
+        custom::set<size_t> set;
+        for (size_t key : keys)
+            set.emplace(key);
+
+        _print_result("emplace loop", watch.elapsed_ms(), count);
+    }
+
+    {
+        _Stopwatch watch;
+        custom::set<size_t> set;
+        set.assign_sorted(keys.begin(), keys.end());
+
+        _print_result("assign_sorted", watch.elapsed_ms(), count);
+    }
+
+    custom::set<size_t> large;
+    large.assign_sorted(keys.begin(), keys.end());
+
+    for (size_t operand : {small, count / 4})      // element by element below count / 8, split and join above
+    {
+        custom::set<size_t> few;
+        for (size_t i = 0; i < operand; ++i)        // half present in large
+            few.emplace(i * (count / operand) * 2 + (i % 2));
+
+        std::cout << "combine " << count << " with " << operand << " keys\n";
+
+        {
+            custom::set<size_t> set = large;
+            _Stopwatch watch;
+            for (size_t key : few)
+                set.emplace(key);
+
+            _print_result("union: emplace loop", watch.elapsed_ms(), operand);
+        }
+
+        {
+            custom::set<size_t> set = large;
+            _Stopwatch watch;
+            set.union_with(few);
+
+            _print_result("union_with", watch.elapsed_ms(), operand);
+        }
+
+        {
+            custom::set<size_t> set = large;
+            _Stopwatch watch;
+            for (size_t key : few)
+                set.erase(key);
+
+            _print_result("difference: erase loop", watch.elapsed_ms(), operand);
+        }
+
+        {
+            custom::set<size_t> set = large;
+            _Stopwatch watch;
+            set.difference_with(few);
+
+            _print_result("difference_with", watch.elapsed_ms(), operand);
+        }
+
+        {
+            custom::set<size_t> set = large;
+            _Stopwatch watch;
+            set.intersect_with(few);
+
+            _print_result("intersect_with", watch.elapsed_ms(), operand);
+        }
+    }
+
+    custom::set<size_t> shifted;
+    for (size_t key : keys)
+        shifted.emplace_hint(shifted.end(), key + 1);
+
+    std::cout << "union of two " << count << " key sets\n";
+
+    for (size_t threads : {1, 4})
+    {
+        custom::set<size_t> set = large;
+        _Stopwatch watch;
+        set.union_with(shifted, threads);
+
+        _print_result(threads == 1 ? "union_with, 1 thread" : "union_with, 4 threads", watch.elapsed_ms(), count * 2);
+    }
+}
+
+void map_order_statistics_benchmark() {
+    constexpr size_t count      = 1000000;
+    constexpr size_t queries    = 1000;
+    constexpr size_t walks      = 20;          // linear walks are too slow for the full query count
+
+    using _Ranked_Map = custom::map<size_t, size_t,
+                                    custom::less<size_t>,
+                                    custom::allocator<custom::pair<size_t, size_t>>,
+                                    custom::order_statistic_tree_policy>;
+
+    custom::vector<size_t> keys;
+    for (size_t i = 0; i < count; ++i)
+        keys.push_back((i * 2654435761u) % count);
+
+    std::cout << "emplace " << count << " shuffled keys\n";
+
+    custom::map<size_t, size_t> plain;     // both stay alive, so neither reuses the other's freed nodes
+    {
+        _Stopwatch watch;
+        for (size_t key : keys)
+            plain.emplace(key, key);
+
+        _print_result("default_tree_policy", watch.elapsed_ms(), count);
+    }
+
+    _Ranked_Map ranked;
+    {
+        _Stopwatch watch;
+        for (size_t key : keys)
+            ranked.emplace(key, key);
+
+        _print_result("order_statistic_tree_policy", watch.elapsed_ms(), count);
+    }
+
+    std::cout << "rank / nth queries on " << count << " keys\n";
+
+    size_t checksum = 0;
+    {
+        _Stopwatch watch;
+        for (size_t i = 0; i < walks; ++i)
+            checksum += static_cast<size_t>(custom::distance(ranked.begin(), ranked.lower_bound(i * (count / walks))));
+
+        _print_result("rank: distance walk", watch.elapsed_ms(), walks);
+    }
+
+    {
+        _Stopwatch watch;
+        for (size_t i = 0; i < queries; ++i)
+            checksum += ranked.rank(i * (count / queries));
+
+        _print_result("rank", watch.elapsed_ms(), queries);
+    }
+
+    {
+        _Stopwatch watch;
+        for (size_t i = 0; i < walks; ++i)
+            checksum += custom::next(ranked.begin(), static_cast<ptrdiff_t>(i * (count / walks)))->first;
+
+        _print_result("nth: iterator walk", watch.elapsed_ms(), walks);
+    }
+
+    {
+        _Stopwatch watch;
+        for (size_t i = 0; i < queries; ++i)
+            checksum += ranked.nth(i * (count / queries))->first;
+
+        _print_result("nth", watch.elapsed_ms(), queries);
+    }
+
+    std::cout << "\t(checksum " << checksum << ")\n";
+}
+
+struct _Classic_Tree_Policy         // node layout with separate nil and color fields
+{
+    static constexpr bool order_statistics  = false;
+    static constexpr bool compact_nodes     = false;
+};
+
+static void _release_free_memory() {    // otherwise the next run reuses the previous tree's nodes in shuffled order
+#if defined __GLIBC__
+    malloc_trim(0);
+#endif
+}
+
+template<class Type>
+static void _compact_node_run(const custom::vector<size_t>& keys) {
+    using _Value    = custom::pair<Type, Type>;
+    using _Alloc    = _Counting_Allocator<_Value>;
+
+    _release_free_memory();
+    _ordered_map_run<custom::map<Type, Type, custom::less<Type>, _Alloc, _Classic_Tree_Policy>>("classic node", keys);
+    _release_free_memory();
+    _ordered_map_run<custom::map<Type, Type, custom::less<Type>, _Alloc>>("compact node", keys);
+}
+
+void map_compact_node_benchmark() {
+    constexpr size_t count = 1000000;
+
+    custom::vector<size_t> keys;
+    for (size_t i = 0; i < count; ++i)
+        keys.push_back((i * 2654435761u) % count);
+
+    std::cout << "map<uint32_t, uint32_t> with " << count << " shuffled keys\n";
+    _compact_node_run<uint32_t>(keys);
+
+    std::cout << "map<uint64_t, uint64_t> with " << count << " shuffled keys\n";
+    _compact_node_run<uint64_t>(keys);
+}
+
+void flat_map_benchmark() {
+    using _Alloc        = _Counting_Allocator<custom::pair<size_t, size_t>>;
+    using _Flat_Map     = custom::flat_map<size_t, size_t, custom::less<size_t>,
+                                            custom::vector<size_t, _Counting_Allocator<size_t>>,
+                                            custom::vector<size_t, _Counting_Allocator<size_t>>>;
+
+    constexpr size_t count  = 1000000;
+    custom::vector<size_t> keys = _random_keys(count, 9);
+
+    custom::vector<custom::pair<size_t, size_t>> values;
+    for (size_t i = 0; i < count; ++i)
+        values.emplace_back(keys[i], i);
+
+    std::cout << "flat_map vs map with " << count << " random keys\n";
+
+    size_t checksum = 0;
+    custom::map<size_t, size_t, custom::less<size_t>, _Alloc> map;
+    {
+        _AllocatedBytes = 0;
+        _Stopwatch watch;
+
+        for (size_t i = 0; i < count; ++i)
+            map.emplace(keys[i], i);
+
+        std::cout << "\tmap\n";
+        _print_result("emplace one by one", watch.elapsed_ms(), count);
+        std::cout << "\tbytes per element: " << static_cast<double>(_AllocatedBytes) / map.size() << '\n';
+    }
+
+    _Flat_Map flat;
+    {
+        _AllocatedBytes = 0;
+        _Stopwatch watch;
+
+        flat.insert(values.begin(), values.end());      // one sort and one merge
+
+        std::cout << "\tflat_map\n";
+        _print_result("bulk insert", watch.elapsed_ms(), count);
+        std::cout << "\tbytes per element: " << static_cast<double>(_AllocatedBytes) / flat.size() << '\n';
+    }
+
+    {
+        custom::vector<custom::pair<size_t, size_t>> sorted;
+        for (const auto& val : flat)
+            sorted.emplace_back(val.first, val.second);
+
+        _Flat_Map fromSorted;
+        _Stopwatch watch;
+
+        fromSorted.insert(custom::sorted_unique, sorted.begin(), sorted.end());
+        _print_result("bulk insert (sorted_unique)", watch.elapsed_ms(), count);
+        checksum += fromSorted.size();
+    }
+
+    {
+        _Stopwatch watch;
+        for (const size_t key : keys)
+            checksum += map.find(key)->second;
+
+        _print_result("map find", watch.elapsed_ms(), count);
+    }
+
+    {
+        _Stopwatch watch;
+        for (const size_t key : keys)
+            checksum += flat.find(key)->second;
+
+        _print_result("flat_map find", watch.elapsed_ms(), count);
+    }
+
+    {
+        _Stopwatch watch;
+        for (const auto& val : map)
+            checksum += val.second;
+
+        _print_result("map full scan", watch.elapsed_ms(), map.size());
+    }
+
+    {
+        _Stopwatch watch;
+        for (const auto& val : flat)
+            checksum += val.second;
+
+        _print_result("flat_map full scan", watch.elapsed_ms(), flat.size());
+    }
+
+    std::cout << "\t(checksum " << checksum << ")\n";
+}
+
+template<class Type>
+class _Element_Wise_Allocator : public custom::allocator<Type>     // declares construct/destroy, so vector takes the per-element paths
+{
+public:
+    using value_type = Type;
+
+    _Element_Wise_Allocator() = default;
+
+    template<class Other>
+    _Element_Wise_Allocator(const _Element_Wise_Allocator<Other>&) noexcept { /*Empty*/ }
+
+    template<class Other, class... Args>
+    void construct(Other* const address, Args&&... args) {
+        ::new (static_cast<void*>(address)) Other(custom::forward<Args>(args)...);
+    }
+
+    template<class Other>
+    void destroy(Other* const address) noexcept {
+        address->~Other();
+    }
+};  // END _Element_Wise_Allocator
+
+struct _Relocation_Record       // 32 byte POD
+{
+    size_t Key;
+    size_t Value;
+    double Weight;
+    uint32_t Flags;
+};
+
+template<class Vector, class MakeFunc>
+static void _vector_relocation_run(const char* name, size_t count, size_t rounds, MakeFunc makeFunc, size_t& checksum) {
+    std::cout << '\t' << name << '\n';
+
+    Vector source;
+    source.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        source.push_back(makeFunc(i));
+
+    {
+        _Stopwatch watch;
+        for (size_t round = 0; round < rounds; ++round)
+        {
+            Vector grown;
+            for (size_t i = 0; i < count; ++i)
+                grown.push_back(makeFunc(i));       // every reallocation relocates the whole array
+
+            checksum += grown.size();
+        }
+
+        _print_result("push_back growth", watch.elapsed_ms(), count * rounds);
+    }
+
+    {
+        _Stopwatch watch;
+        for (size_t round = 0; round < rounds; ++round)
+        {
+            Vector grown = source;
+            for (size_t capacity = count * 2; capacity <= count * 16; capacity *= 2)
+                grown.reserve(capacity);
+
+            checksum += grown.capacity();
+        }
+
+        _print_result("copy + reserve x4", watch.elapsed_ms(), count * rounds);
+    }
+
+    {
+        double destroyMs = 0;
+        for (size_t round = 0; round < rounds; ++round)
+        {
+            Vector copy = source;
+            _Stopwatch watch;
+            copy.clear();
+            destroyMs += watch.elapsed_ms();
+            checksum += copy.capacity();
+        }
+
+        _print_result("clear", destroyMs, count * rounds);
+    }
+}
+
+template<class Type, class MakeFunc>
+static void _vector_relocation_compare(const char* name, size_t count, size_t rounds, MakeFunc makeFunc, size_t& checksum) {
+    std::cout << name << " with " << count << " elements\n";
+    _vector_relocation_run<custom::vector<Type, _Element_Wise_Allocator<Type>>>("element-wise", count, rounds, makeFunc, checksum);
+    _vector_relocation_run<custom::vector<Type>>("trivially relocatable", count, rounds, makeFunc, checksum);
+}
+
+void vector_relocation_benchmark() {
+    size_t checksum = 0;
+
+    _vector_relocation_compare<int>("vector<int>", 1000000, 20,
+                                    [](size_t i) { return static_cast<int>(i); }, checksum);
+
+    _vector_relocation_compare<_Relocation_Record>("vector<32 byte POD>", 1000000, 10,
+                                    [](size_t i) { return _Relocation_Record{i, i * 3, 0.5 * i, 7}; }, checksum);
+
+    _vector_relocation_compare<custom::string>("vector<string>", 200000, 5,
+                                    [](size_t i) { return custom::string(32).append(16 + i % 16, 'x'); }, checksum);
+
+    std::cout << "\t(checksum " << checksum << ")\n";
+}
+
+template<class Vector>
+static void _small_vector_run(const char* name, const custom::vector<size_t>& sizes, size_t& checksum) {
+    _AllocationCount = 0;
+    _Stopwatch watch;
+
+    for (const size_t count : sizes)            // one short lived container per request
+    {
+        Vector values;
+        for (size_t i = 0; i < count; ++i)
+            values.push_back(count + i);
+
+        Vector moved = custom::move(values);
+        for (const size_t val : moved)
+            checksum += val;
+    }
+
+    _print_result(name, watch.elapsed_ms(), sizes.size());
+    std::cout << "\tallocations: " << _AllocationCount << '\n';
+}
+
+void small_vector_benchmark() {
+    using _Alloc = _Counting_Allocator<size_t>;
+
+    constexpr size_t count = 1000000;
+    custom::vector<size_t> keys = _random_keys(count, 11);
+
+    custom::vector<size_t> sizes;
+    for (size_t i = 0; i < count; ++i)
+        sizes.push_back(keys[i] % 100 < 90 ? keys[i] % 8 : 8 + keys[i] % 24);     // 90% hold fewer than 8 values
+
+    std::cout << "build, move and scan " << count << " containers of 0-31 values\n";
+
+    size_t checksum = 0;
+    _small_vector_run<custom::vector<size_t, _Alloc>>("vector", sizes, checksum);
+    _small_vector_run<custom::small_vector<size_t, 8, _Alloc>>("small_vector<8>", sizes, checksum);
+    _small_vector_run<custom::small_vector<size_t, 32, _Alloc>>("small_vector<32>", sizes, checksum);
+
+    std::cout << "\t(checksum " << checksum << ")\n";
+}
+
+static size_t _fake_read(const custom::vector<char>& source, size_t& offset, char* const dest, const size_t capacity) {  // read() stand-in, returns bytes copied
+    const size_t count = (custom::min)(capacity, source.size() - offset);
+    std::memcpy(dest, source.data() + offset, count);
+    offset += count;
+    return count;
+}
+
+template<class Buffer>
+static void _buffer_fill_run(const custom::vector<char>& source, size_t rounds, size_t& checksum) {
+    constexpr size_t chunk = 64 * 1024;
+
+    Buffer buffer;
+    double resizeMs = 0, overwriteMs = 0, operationMs = 0;
+
+    for (size_t round = 0; round < rounds; ++round)         // the buffer is reused, so only the extra zeroing pass differs
+    {
+        {
+            buffer.clear();
+            size_t offset = 0;
+            _Stopwatch watch;
+
+            for (size_t read = chunk; read == chunk; /*Empty*/)
+            {
+                const size_t oldSize = buffer.size();
+                buffer.resize(oldSize + chunk);
+                read = _fake_read(source, offset, buffer.data() + oldSize, chunk);
+                buffer.resize(oldSize + read);
+            }
+
+            resizeMs += watch.elapsed_ms();
+            checksum += buffer.size();
+        }
+
+        {
+            buffer.clear();
+            size_t offset = 0;
+            _Stopwatch watch;
+
+            for (size_t read = chunk; read == chunk; /*Empty*/)
+            {
+                const size_t oldSize = buffer.size();
+                buffer.resize_for_overwrite(oldSize + chunk);
+                read = _fake_read(source, offset, buffer.data() + oldSize, chunk);
+                buffer.resize(oldSize + read);
+            }
+
+            overwriteMs += watch.elapsed_ms();
+            checksum += buffer.size();
+        }
+
+        {
+            buffer.clear();
+            size_t offset = 0;
+            _Stopwatch watch;
+
+            for (size_t read = chunk; read == chunk; /*Empty*/)
+            {
+                const size_t oldSize = buffer.size();
+                buffer.resize_and_overwrite(oldSize + chunk,
+                                            [&](char* const data, const size_t) {
+                                                read = _fake_read(source, offset, data + oldSize, chunk);
+                                                return oldSize + read;
+                                            });
+            }
+
+            operationMs += watch.elapsed_ms();
+            checksum += buffer.size();
+        }
+    }
+
+    _print_result("resize", resizeMs, source.size() * rounds);
+    _print_result("resize_for_overwrite", overwriteMs, source.size() * rounds);
+    _print_result("resize_and_overwrite", operationMs, source.size() * rounds);
+}
+
+void buffer_fill_benchmark() {
+    constexpr size_t bytes  = 64 * 1024 * 1024;
+    constexpr size_t rounds = 10;
+
+    custom::vector<char> source;
+    source.resize_for_overwrite(bytes);
+    for (size_t i = 0; i < bytes; ++i)
+        source[i] = static_cast<char>('a' + i % 26);
+
+    size_t checksum = 0;
+    std::cout << "fill a reused buffer with " << bytes / (1024 * 1024) << " MB in 64 KB reads (Mops = MB)\n";
+
+    std::cout << "\tvector<char>\n";
+    _buffer_fill_run<custom::vector<char>>(source, rounds, checksum);
+
+    std::cout << "\tstring\n";
+    _buffer_fill_run<custom::string>(source, rounds, checksum);
+
+    std::cout << "\t(checksum " << checksum << ")\n";
+}
+
+template<class Container>
+static void _stable_vector_run(const char* name, const custom::vector<size_t>& indexes, size_t& checksum) {
+    const size_t count = indexes.size();
+    std::cout << '\t' << name << '\n';
+
+    Container values;
+    {
+        _Stopwatch watch;
+        for (size_t i = 0; i < count; ++i)
+            values.push_back(i);
+
+        _print_result("push_back", watch.elapsed_ms(), count);
+    }
+
+    {
+        _Stopwatch watch;
+        for (const size_t index : indexes)
+            checksum += values[index];
+
+        _print_result("random index", watch.elapsed_ms(), count);
+    }
+
+    {
+        _Stopwatch watch;
+        checksum += custom::accumulate(values.begin(), values.end(), size_t{0});
+        checksum += static_cast<size_t>(custom::count(values.begin(), values.end(), count / 2));
+
+        _print_result("accumulate + count", watch.elapsed_ms(), 2 * count);
+    }
+}
+
+void stable_vector_benchmark() {
+    constexpr size_t count = 10000000;
+
+    custom::vector<size_t> indexes = _random_keys(count, 23);
+    for (size_t& index : indexes)
+        index %= count;
+
+    std::cout << "push_back, random index and scan " << count << " values\n";
+
+    size_t checksum = 0;
+    _stable_vector_run<custom::vector<size_t>>("vector", indexes, checksum);
+    _stable_vector_run<custom::deque<size_t>>("deque", indexes, checksum);
+    _stable_vector_run<custom::stable_vector<size_t>>("stable_vector", indexes, checksum);
+
+    std::cout << "\t(checksum " << checksum << ")\n";
+}
+
+template<class Type>
+static void _deque_block_run(const char* name, const custom::vector<size_t>& keys, size_t& checksum) {
+    const size_t count = keys.size();
+    std::cout << '\t' << name << " (block " << custom::deque_block_size<Type>::value << " elements)\n";
+
+    {
+        custom::queue<Type, custom::deque<Type>> queue;
+        _Stopwatch watch;
+
+        for (size_t i = 0; i < count; ++i)                  // sliding window of at most 1024 values
+        {
+            queue.push(static_cast<Type>(keys[i]));
+            if (queue.size() > 1024)
+            {
+                checksum += static_cast<size_t>(queue.front());
+                queue.pop();
+            }
+        }
+
+        _print_result("queue push/pop", watch.elapsed_ms(), count);
+    }
+
+    {
+        custom::deque<Type> values;
+        for (size_t i = 0; i < count; ++i)
+            values.push_back(static_cast<Type>(keys[i]));
+
+        _Stopwatch watch;
+        for (const Type& val : values)
+            checksum += static_cast<size_t>(val);
+
+        _print_result("deque iterate", watch.elapsed_ms(), count);
+    }
+
+    {
+        custom::priority_queue<Type, custom::deque<Type>> queue;
+        const size_t heapCount = count / 10;
+        _Stopwatch watch;
+
+        for (size_t i = 0; i < heapCount; ++i)
+            queue.push(static_cast<Type>(keys[i]));
+
+        while (!queue.empty())
+        {
+            checksum += static_cast<size_t>(queue.front());
+            queue.pop();
+        }
+
+        _print_result("priority_queue push/pop", watch.elapsed_ms(), 2 * heapCount);
+    }
+}
+
+void deque_block_benchmark() {
+    constexpr size_t count = 10000000;
+    custom::vector<size_t> keys = _random_keys(count, 24);
+
+    std::cout << "queue and priority_queue over deque, " << count << " values\n";
+
+    size_t checksum = 0;
+    _deque_block_run<char>("char", keys, checksum);
+    _deque_block_run<size_t>("size_t", keys, checksum);
+
+    std::cout << "\t(checksum " << checksum << ")\n";
+}
+
+template<class Container>
+static void _segmented_algorithm_run(const char* name, const custom::vector<size_t>& keys, size_t rounds, size_t& checksum) {
+    Container values;
+    for (const size_t key : keys)
+        values.push_back(static_cast<int>(key % 1000));
+
+    custom::vector<int> dest(keys.size());
+    double readMs = 0, findMs = 0, writeMs = 0;
+
+    for (size_t round = 0; round < rounds; ++round)
+    {
+        {
+            _Stopwatch watch;
+            checksum += static_cast<size_t>(custom::accumulate(values.begin(), values.end(), 0LL));
+            checksum += static_cast<size_t>(custom::count(values.begin(), values.end(), static_cast<int>(round)));
+            custom::for_each(values.begin(), values.end(), [&checksum](const int val) { checksum += static_cast<size_t>(val & 1); });
+            readMs += watch.elapsed_ms();
+        }
+
+        {
+            _Stopwatch watch;
+            checksum += (custom::find(values.begin(), values.end(), -1) == values.end()) ? 1 : 0;    // absent, full scan
+            findMs += watch.elapsed_ms();
+        }
+
+        {
+            _Stopwatch watch;
+            custom::copy(values.begin(), values.end(), dest.begin());
+            custom::fill(values.begin(), values.end(), static_cast<int>(round));
+            writeMs += watch.elapsed_ms();
+            checksum += static_cast<size_t>(dest[round]);
+        }
+    }
+
+    std::cout << '\t' << name << '\n';
+    _print_result("accumulate + count + for_each", readMs, 3 * rounds * keys.size());
+    _print_result("find", findMs, rounds * keys.size());
+    _print_result("copy + fill", writeMs, 2 * rounds * keys.size());
+}
+
+void segmented_algorithm_benchmark() {
+    constexpr size_t count  = 10000000;
+    constexpr size_t rounds = 10;
+    custom::vector<size_t> keys = _random_keys(count, 25);
+
+    std::cout << "algorithms over " << count << " ints, " << rounds << " rounds\n";
+
+    size_t checksum = 0;
+    _segmented_algorithm_run<custom::vector<int>>("vector", keys, rounds, checksum);
+    _segmented_algorithm_run<custom::deque<int>>("deque", keys, rounds, checksum);
+    _segmented_algorithm_run<custom::stable_vector<int>>("stable_vector", keys, rounds, checksum);
+
+    std::cout << "\t(checksum " << checksum << ")\n";
+}
+
+#if defined __linux__
+static size_t _proc_status_kb(const char* field) {     // VmRSS, VmHWM, ... from /proc/self/status
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+        if (line.rfind(field, 0) == 0)
+            return std::stoul(line.substr(line.find(':') + 1));
+
+    return 0;
+}
+
+static void _reset_peak_rss() {                         // VmHWM restarts from the current VmRSS
+    std::ofstream("/proc/self/clear_refs") << "5";
+}
+
+template<class Vector>
+static void _large_growth_run(const char* name, size_t count, size_t& checksum) {
+    _reset_peak_rss();
+    const size_t startKb = _proc_status_kb("VmRSS");
+    _Stopwatch watch;
+
+    Vector values;
+    for (size_t i = 0; i < count; ++i)
+        values.push_back(i);
+
+    const double ms         = watch.elapsed_ms();
+    const size_t dataKb     = values.size() * sizeof(size_t) / 1024;
+    const size_t peakKb     = _proc_status_kb("VmHWM") - startKb;
+    checksum += values[count / 2];
+
+    _print_result(name, ms, count);
+    std::cout << "\tpeak RSS growth: " << peakKb / 1024 << " MB for " << dataKb / 1024 << " MB of data ("
+                << static_cast<double>(peakKb) / dataKb << "x)\n";
+}
+
+void vector_large_growth_benchmark() {
+    constexpr size_t count = 64 * 1024 * 1024;
+
+    std::cout << "push_back " << count << " size_t values\n";
+
+    size_t checksum = 0;
+    _large_growth_run<custom::vector<size_t, _Counting_Allocator<size_t>>>("operator new, copy on growth", count, checksum);
+    _large_growth_run<custom::vector<size_t>>("large_allocator, mremap on growth", count, checksum);
+
+    std::cout << "\t(checksum " << checksum << ")\n";
+}
+#endif  // __linux__
+
+#if defined __GNUG__
+class _Locked_Map      // the single shared_mutex baseline
+{
+private:
+    mutable custom::shared_mutex _Mutex;
+    custom::unordered_map<size_t, size_t> _Elems;
+
+public:
+    bool emplace(size_t key, size_t val) {
+        custom::lock_guard<custom::shared_mutex> lock(_Mutex);
+        return _Elems.try_emplace(key, val).second;
+    }
+
+    template<class Visitor>
+    bool visit(size_t key, Visitor visitor) const {
+        custom::shared_lock<custom::shared_mutex> lock(_Mutex);
+
+        auto it = _Elems.find(key);
+        if (it == _Elems.end())
+            return false;
+
+        visitor(*it);
+        return true;
+    }
+};  // END _Locked_Map
+
+template<class Map>
+static void _concurrent_throughput(const char* name, const custom::vector<size_t>& keys, size_t threadCount, size_t opsPerThread) {
+    Map map;
+    for (size_t i = 0; i < keys.size() / 2; ++i)    // half present, writes insert the other half
+        map.emplace(keys[i], i);
+
+    custom::vector<custom::thread> threads;
+    custom::vector<size_t> checksums(threadCount, 0);
+    _Stopwatch watch;
+
+    for (size_t t = 0; t < threadCount; ++t)
+        threads.emplace_back([&map, &keys, &checksums, t, opsPerThread]() {
+            const Map& readMap  = map;
+            size_t index        = t * 7919;
+            size_t checksum     = 0;
+
+            for (size_t op = 0; op < opsPerThread; ++op)
+            {
+                const size_t key = keys[index++ % keys.size()];
+
+                if (op % 10 == 0)   // 10% writes
+                    map.emplace(key, op);
+                else
+                    readMap.visit(key, [&checksum](const auto& val) { checksum += val.second; });
+            }
+
+            checksums[t] = checksum;
+        });
+
+    for (auto& thread : threads)
+        thread.join();
+
+    _print_result((custom::string(name) + " x" + std::to_string(threadCount).c_str()).c_str(), watch.elapsed_ms(), threadCount * opsPerThread);
+}
+
+void concurrent_unordered_map_benchmark() {
+    constexpr size_t count          = 1000000;
+    constexpr size_t opsPerThread   = 2000000;
+    const size_t maxThreads         = (custom::max)(custom::thread::hardware_concurrency(), 1u);
+
+    custom::vector<size_t> keys = _random_keys(count, 5);
+
+    std::cout << "concurrent_unordered_map vs shared_mutex + unordered_map (90% reads, "
+                << maxThreads << " hardware threads)\n";
+
+    for (size_t threadCount = 1; threadCount <= maxThreads; threadCount *= 2)
+    {
+        _concurrent_throughput<_Locked_Map>("single lock", keys, threadCount, opsPerThread);
+        _concurrent_throughput<custom::concurrent_unordered_map<size_t, size_t>>("sharded", keys, threadCount, opsPerThread);
+    }
+}
+
+class _Locked_Ordered_Map      // custom::map behind a shared_mutex, the read-mostly baseline
+{
+private:
+    mutable custom::shared_mutex _Mutex;
+    custom::map<size_t, size_t> _Elems;
+
+public:
+    bool insert_or_assign(size_t key, size_t val) {
+        custom::lock_guard<custom::shared_mutex> lock(_Mutex);
+
+        auto result = _Elems.try_emplace(key, val);
+        if (!result.second)
+            result.first->second = val;
+
+        return result.second;
+    }
+
+    template<class Visitor>
+    bool visit(size_t key, Visitor visitor) const {
+        custom::shared_lock<custom::shared_mutex> lock(_Mutex);
+
+        auto it = _Elems.find(key);
+        if (it == _Elems.end())
+            return false;
+
+        visitor(*it);
+        return true;
+    }
+};  // END _Locked_Ordered_Map
+
+template<class Map>
+static void _read_mostly_throughput(const char* name, const custom::vector<size_t>& keys, size_t threadCount, size_t opsPerThread) {
+    constexpr size_t writeEvery = 100000;          // rare updates, like a routing table reload
+
+    _release_free_memory();
+    Map map;
+    for (size_t i = 0; i < keys.size(); ++i)
+        map.insert_or_assign(keys[i], i);
+
+    custom::vector<custom::thread> threads;
+    custom::vector<size_t> checksums(threadCount, 0);
+    _Stopwatch watch;
+
+    for (size_t t = 0; t < threadCount; ++t)
+        threads.emplace_back([&map, &keys, &checksums, t, opsPerThread]() {
+            const Map& readMap  = map;
+            size_t index        = t * 7919;
+            size_t checksum     = 0;
+
+            for (size_t op = 1; op <= opsPerThread; ++op)
+            {
+                index = (index + 7919) % keys.size();       // not insertion order, which would favour the baseline's node layout
+                const size_t key = keys[index];
+
+                if (t == 0 && op % writeEvery == 0)
+                    map.insert_or_assign(key, op);
+                else
+                    readMap.visit(key, [&checksum](const auto& val) { checksum += val.second; });
+            }
+
+            checksums[t] = checksum;
+        });
+
+    for (auto& thread : threads)
+        thread.join();
+
+    _print_result((custom::string(name) + " x" + std::to_string(threadCount).c_str()).c_str(), watch.elapsed_ms(), threadCount * opsPerThread);
+}
+
+void snapshot_map_benchmark() {
+    constexpr size_t count          = 100000;
+    constexpr size_t opsPerThread   = 2000000;
+    const size_t maxThreads         = (custom::max)(custom::thread::hardware_concurrency(), 1u);
+
+    custom::vector<size_t> keys = _random_keys(count, 10);
+
+    std::cout << "snapshot_map vs shared_mutex + map (reads, one update per 100000 ops, "
+                << maxThreads << " hardware threads)\n";
+
+    for (size_t threadCount = 1; threadCount <= maxThreads; threadCount *= 2)
+    {
+        _read_mostly_throughput<_Locked_Ordered_Map>("shared_mutex", keys, threadCount, opsPerThread);
+        _read_mostly_throughput<custom::snapshot_map<size_t, size_t>>("snapshot", keys, threadCount, opsPerThread);
+    }
+}
+#endif  // __GNUG__
+
+TEST_BENCHMARK_END
\ No newline at end of file
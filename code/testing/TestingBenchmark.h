@@ -0,0 +1,100 @@
+#pragma once
+
+#include "__CTMCommonInclude.h"
+#include "__STDCommonInclude.h"
+
+#if defined __GNUG__
+#include "__CTMThreadInclude.h"
+#endif
+
+#define TEST_BENCHMARK_BEGIN namespace test_benchmark {
+#define TEST_BENCHMARK_END }
+
+
+TEST_BENCHMARK_BEGIN
+
+class _Stopwatch    // measures elapsed time since construction or last restart
+{
+private:
+    custom::chrono::steady_clock::time_point _Start;
+
+public:
+    _Stopwatch();
+
+    void restart();
+    double elapsed_ms() const;
+};  // END _Stopwatch
+
+
+// deterministic pseudo-random keys (xorshift64), identical for every container under test
+custom::vector<size_t> _random_keys(size_t count, size_t seed);
+
+// prints "name: ms (Mops/s)" for a measured run
+void _print_result(const char* name, double ms, size_t ops);
+
+inline size_t _AllocationCount = 0;    // incremented by every _Counting_Allocator::allocate call
+inline size_t _AllocatedBytes  = 0;    // bytes currently held through _Counting_Allocator
+
+template<class Type>
+class _Counting_Allocator      // allocator that counts allocate calls in _AllocationCount
+{
+public:
+    using value_type = Type;
+
+    _Counting_Allocator() = default;
+
+    template<class Other>
+    _Counting_Allocator(const _Counting_Allocator<Other>&) noexcept { /*Empty*/ }
+
+    Type* allocate(const size_t capacity) {
+        ++_AllocationCount;
+        _AllocatedBytes += capacity * sizeof(Type);
+        return static_cast<Type*>(::operator new(capacity * sizeof(Type)));
+    }
+
+    void deallocate(Type* const address, const size_t capacity) noexcept {
+        _AllocatedBytes -= capacity * sizeof(Type);
+        ::operator delete(address);
+    }
+
+    template<class Other>
+    bool operator==(const _Counting_Allocator<Other>&) const noexcept {
+        return true;
+    }
+
+    template<class Other>
+    bool operator!=(const _Counting_Allocator<Other>&) const noexcept {
+        return false;
+    }
+};  // END _Counting_Allocator
+
+
+void flat_hash_map_benchmark();
+void hash_table_emplace_allocation_benchmark();
+void hash_table_insert_latency_benchmark();
+void hash_bytes_throughput_benchmark();
+void node_handle_repartition_benchmark();
+void frozen_map_lookup_benchmark();
+void btree_map_benchmark();
+void map_sorted_load_benchmark();
+void map_set_operations_benchmark();
+void map_order_statistics_benchmark();
+void map_compact_node_benchmark();
+void flat_map_benchmark();
+void vector_relocation_benchmark();
+void small_vector_benchmark();
+void buffer_fill_benchmark();
+void stable_vector_benchmark();
+void deque_block_benchmark();
+void segmented_algorithm_benchmark();
+
+#if defined __linux__
+void vector_large_growth_benchmark();
+#endif
+
+#if defined __GNUG__    // thread benchmarks available only on __GNUG__
+void concurrent_unordered_map_benchmark();
+void snapshot_map_benchmark();
+#endif
+
+TEST_BENCHMARK_END
\ No newline at end of file
@@ -302,6 +302,97 @@ void shared_timed_mutex_test() {
     std::cout << "\nShared Data= " << sharedData << '\n';
 }
 
+void concurrent_unordered_map_test() {
+    custom::concurrent_unordered_map<int, int> map;
+    custom::vector<custom::thread> threads;
+
+    for (int t = 0; t < 4; ++t)
+        threads.emplace_back([&map, t]() {
+            for (int i = 0; i < 1000; ++i)
+            {
+                map.emplace(1000 + t * 1000 + i, i);                                        // own keys, spread over the shards
+                map.insert_or_visit(i % 100, 1, [](auto& val) { ++val.second; });           // shared counters, updated under their shard lock
+            }
+        });
+
+    for (auto& thr : threads)
+        thr.join();
+
+    int counters = 0;
+    map.visit_all([&counters](const auto& val) {
+        if (val.first < 1000)
+            counters += val.second;
+    });
+
+    std::cout << "size= " << map.size() << ", shards= " << map.shard_count() << ", counters= " << counters << '\n';
+
+    const size_t erased = map.erase_if([](const auto& val) { return val.first % 2 != 0; });
+    std::cout << "erased= " << erased << ", size= " << map.size() << ", contains 1001= " << map.contains(1001) << '\n';
+}
+
+void snapshot_map_test() {
+    custom::snapshot_map<int, custom::string> map;
+    map.emplace(1, "one");
+    map.emplace(2, "two");
+    map.emplace(3, "three");
+
+    auto before = map.snapshot();
+    map.insert_or_assign(2, "zwei");
+    map.erase(1);
+    map.emplace(4, "four");
+    auto after = map.snapshot();
+
+    std::cout << "before: ";
+    for (const auto& val : before)
+        std::cout << val.first << '=' << val.second << ' ';
+
+    std::cout << "\nafter: ";
+    for (const auto& val : after)
+        std::cout << val.first << '=' << val.second << ' ';
+
+    std::cout << "\nbefore.at(2)= " << before.at(2) << ", after.at(2)= " << after.at(2) << ", map contains 1= " << map.contains(1) << '\n';
+
+    // readers walk whole snapshots while a writer keeps changing the map
+    std::atomic<bool> done      = false;
+    std::atomic<int> broken     = 0;
+    custom::vector<custom::thread> readers;
+
+    for (int t = 0; t < 3; ++t)
+        readers.emplace_back([&]() {
+            while (!done.load())
+            {
+                const auto view = map.snapshot();
+                size_t count    = 0;
+                int last        = -1;
+
+                for (const auto& val : view)
+                {
+                    if (val.first <= last)
+                        ++broken;
+
+                    last = val.first;
+                    ++count;
+                }
+
+                if (count != view.size())
+                    ++broken;
+            }
+        });
+
+    for (int i = 10; i < 2010; ++i)
+    {
+        map.emplace(i, "value");
+        if (i % 2 == 0)
+            map.erase(i - 1);
+    }
+
+    done = true;
+    for (auto& thr : readers)
+        thr.join();
+
+    std::cout << "size= " << map.size() << ", broken snapshots= " << broken << '\n';
+}
+
 TEST_BOOST_END
 
 #endif		// __GNUG__
\ No newline at end of file
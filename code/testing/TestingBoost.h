@@ -35,6 +35,8 @@ void recursive_timed_mutex_test();
 void condition_variable_any_test();
 void shared_mutex_test();
 void shared_timed_mutex_test();
+void concurrent_unordered_map_test();
+void snapshot_map_test();
 
 TEST_BOOST_END
 
@@ -4,6 +4,8 @@
 #include "c_string_view.h"
 #include "c_array.h"
 #include "c_vector.h"
+#include "c_small_vector.h"
+#include "c_stable_vector.h"
 #include "c_deque.h"
 #include "c_list.h"
 #include "c_forward_list.h"
@@ -11,8 +13,16 @@
 #include "c_stack.h"
 #include "c_unordered_map.h"
 #include "c_unordered_set.h"
+#include "c_flat_hash_map.h"
+#include "c_flat_hash_set.h"
+#include "c_frozen_map.h"
+#include "c_frozen_set.h"
 #include "c_map.h"
 #include "c_set.h"
+#include "c_btree_map.h"
+#include "c_btree_set.h"
+#include "c_flat_map.h"
+#include "c_flat_set.h"
 #include "c_functional.h"
 #include "c_memory.h"
 #include "c_limits.h"
@@ -5,4 +5,6 @@
 #include "c_condition_variable.h"
 #include "c_counting_semaphore.h"
 #include "c_barrier.h"
-#include "c_shared_mutex.h"
\ No newline at end of file
+#include "c_shared_mutex.h"
+#include "c_concurrent_unordered_map.h"
+#include "c_snapshot_map.h"
\ No newline at end of file